@@ -0,0 +1,476 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+
+#include "SDL.h"
+#include "SDL_image.h"
+#include "SDL_mixer.h"
+#include "SDL_ttf.h"
+
+#include "assetpack.h"
+
+#include "visuals.h"
+#include "audio.h"
+
+extern Visuals* visuals;
+extern Audio* audio;
+
+//-------------------------------------------------------------------------------------------------
+AssetPack::AssetPack(void)
+{
+    Data = NULL;
+    DataSize = 0;
+    Mapped = false;
+    MapHandle = NULL;
+    Table = NULL;
+    Entries = 0;
+
+    WriteFile = NULL;
+    WriteEntries = 0;
+    WriteOffset = 0;
+    Writing = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+AssetPack::~AssetPack(void)
+{
+    if (Writing == true)  EndWrite();
+
+    Close();
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 AssetPack::NewestFileTime(const char *directory)
+{
+Uint32 newest = 0;
+char path[256];
+
+#if defined(__unix__) || defined(__APPLE__)
+    DIR *folder = opendir(directory);
+    if (folder == NULL)  return(0);
+
+    struct dirent *file;
+    while ( (file = readdir(folder)) != NULL )
+    {
+        if (file->d_name[0] == '.')  continue;
+
+        SDL_snprintf(path, sizeof path, "%s/%s", directory, file->d_name);
+
+        struct stat status;
+        if (stat(path, &status) == 0 && S_ISREG(status.st_mode) && (Uint32)status.st_mtime > newest)  newest = (Uint32)status.st_mtime;
+    }
+    closedir(folder);
+#elif defined(_WIN32)
+    WIN32_FIND_DATAA file;
+
+    SDL_snprintf(path, sizeof path, "%s/*", directory);
+    HANDLE search = FindFirstFileA(path, &file);
+    if (search == INVALID_HANDLE_VALUE)  return(0);
+
+    do
+    {
+        if ( (file.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 )  continue;
+
+        /* 100ns ticks since 1601 to seconds since 1970 */
+        Uint64 ticks = ( (Uint64)file.ftLastWriteTime.dwHighDateTime << 32 ) | file.ftLastWriteTime.dwLowDateTime;
+        Uint32 seconds = (Uint32)( (ticks / 10000000) - 11644473600ULL );
+        if (seconds > newest)  newest = seconds;
+    } while (FindNextFileA(search, &file) != 0);
+    FindClose(search);
+#else
+    (void)path;
+    (void)directory;
+#endif
+
+    return(newest);
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 AssetPack::NewestSourceTime(void)
+{
+const char *directories[] = { "data/visuals", "data/story", "data/effects", "data/fonts" };
+Uint32 newest = 0;
+
+    /* Everything the pack is made from, a kiosk shipping only the pack has none of them */
+    for (int directory = 0; directory < 4; directory++)
+    {
+        Uint32 time = NewestFileTime(directories[directory]);
+        if (time > newest)  newest = time;
+    }
+
+    return(newest);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::Open(const char *filename)
+{
+AssetPackHeader *header;
+
+    Close();
+
+    /* Mapped read only, so textures and sounds upload straight from the file's pages */
+#if defined(__unix__) || defined(__APPLE__)
+    int file = open(filename, O_RDONLY);
+    if (file < 0)  return(false);
+
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        void *pages = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (pages != MAP_FAILED)
+        {
+            Data = (Uint8*)pages;
+            DataSize = (size_t)status.st_size;
+            Mapped = true;
+        }
+    }
+    close(file);
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)  return(false);
+
+    LARGE_INTEGER size;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL && GetFileSizeEx(file, &size) != 0)
+    {
+        void *pages = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (pages != NULL)
+        {
+            Data = (Uint8*)pages;
+            DataSize = (size_t)size.QuadPart;
+            Mapped = true;
+            MapHandle = mapping;
+        }
+    }
+    if (Mapped == false && mapping != NULL)  CloseHandle(mapping);
+    CloseHandle(file);
+#endif
+
+    /* Without memory mapping the whole pack is read in */
+    if (Data == NULL)
+    {
+        FILE *stream = fopen(filename, "rb");
+        if (stream == NULL)  return(false);
+
+        fseek(stream, 0, SEEK_END);
+        long size = ftell(stream);
+        fseek(stream, 0, SEEK_SET);
+
+        if (size > 0)
+        {
+            Data = (Uint8*)malloc( (size_t)size );
+            if ( Data != NULL && fread(Data, 1, (size_t)size, stream) == (size_t)size )  DataSize = (size_t)size;
+        }
+        fclose(stream);
+
+        if (DataSize == 0)
+        {
+            Close();
+            return(false);
+        }
+    }
+
+    header = (AssetPackHeader*)Data;
+    if ( DataSize < sizeof(AssetPackHeader) || header->Magic != AssetPackMagic || header->Version != AssetPackVersion
+      || header->Entries > AssetPackMaxEntries || header->TableOffset > DataSize
+      || (DataSize - header->TableOffset) < (size_t)header->Entries * sizeof(AssetPackEntry) )
+    {
+        printf("*****ERROR: Asset pack \"%s\" is not a version %i pack, loading loose files*****\n", filename, AssetPackVersion);
+        Close();
+        return(false);
+    }
+
+    /* An edited loose file wins over its stale packed copy */
+    if (NewestSourceTime() > header->SourceTime)
+    {
+        printf("Asset pack \"%s\" is older than the files in data, loading loose files (\"make pack\" rebuilds it).\n", filename);
+        Close();
+        return(false);
+    }
+
+    Table = (AssetPackEntry*)(Data + header->TableOffset);
+    Entries = header->Entries;
+
+    for (Uint32 entry = 0; entry < Entries; entry++)
+    {
+        if (Table[entry].Offset > DataSize || (DataSize - Table[entry].Offset) < Table[entry].Size)
+        {
+            printf("*****ERROR: Asset pack \"%s\" is truncated, loading loose files*****\n", filename);
+            Close();
+            return(false);
+        }
+    }
+
+    printf("Asset pack \"%s\" %s: %u assets in %u KB.\n", filename, (Mapped == true ? "mapped" : "read"), Entries, (Uint32)(DataSize / 1024));
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void AssetPack::Close(void)
+{
+    if (Data == NULL)  return;
+
+    if (Mapped == true)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        munmap(Data, DataSize);
+#elif defined(_WIN32)
+        UnmapViewOfFile(Data);
+        CloseHandle( (HANDLE)MapHandle );
+#endif
+    }
+    else  free(Data);
+
+    Data = NULL;
+    DataSize = 0;
+    Mapped = false;
+    MapHandle = NULL;
+    Table = NULL;
+    Entries = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+const AssetPack::AssetPackEntry* AssetPack::Find(const char *name, Uint32 type)
+{
+    /* While a pack is written everything comes from the loose files */
+    if (Table == NULL || Writing == true)  return(NULL);
+
+    for (Uint32 entry = 0; entry < Entries; entry++)
+    {
+        if (Table[entry].Type == type && strncmp(Table[entry].Name, name, AssetPackNameLength) == 0)  return(&Table[entry]);
+    }
+
+    return(NULL);
+}
+
+//-------------------------------------------------------------------------------------------------
+const Uint8* AssetPack::EntryData(const AssetPackEntry *entry)
+{
+    return(Data + entry->Offset);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::BeginWrite(const char *filename)
+{
+AssetPackHeader header;
+
+    Close();
+
+    WriteFile = fopen(filename, "wb");
+    if (WriteFile == NULL)
+    {
+        printf("*****ERROR: Could not create asset pack \"%s\"*****\n", filename);
+        return(false);
+    }
+
+    /* Filled in by EndWrite() once the table's place is known */
+    memset(&header, 0, sizeof header);
+    fwrite(&header, sizeof header, 1, WriteFile);
+
+    WriteOffset = sizeof header;
+    WriteEntries = 0;
+    Writing = true;
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::WriteEntry(const char *name, Uint32 type, const void *data, Uint32 size, Uint32 width, Uint32 height, Uint32 format)
+{
+Uint8 padding[16];
+
+    if (Writing == false)  return(false);
+
+    for (Uint32 entry = 0; entry < WriteEntries; entry++)
+    {
+        if (WriteTable[entry].Type == type && strncmp(WriteTable[entry].Name, name, AssetPackNameLength) == 0)  return(true);
+    }
+
+    if (WriteEntries == AssetPackMaxEntries)
+    {
+        printf("*****ERROR: Asset pack full, raise AssetPackMaxEntries*****\n");
+        return(false);
+    }
+
+    memset(padding, 0, sizeof padding);
+    if ( (WriteOffset % 16) != 0 )
+    {
+        fwrite(padding, 16 - (WriteOffset % 16), 1, WriteFile);
+        WriteOffset += 16 - (WriteOffset % 16);
+    }
+
+    AssetPackEntry *entry = &WriteTable[WriteEntries];
+    memset(entry, 0, sizeof(AssetPackEntry));
+    SDL_strlcpy(entry->Name, name, sizeof entry->Name);
+    entry->Type = type;
+    entry->Offset = WriteOffset;
+    entry->Size = size;
+    entry->Width = width;
+    entry->Height = height;
+    entry->Format = format;
+
+    if (size > 0 && fwrite(data, size, 1, WriteFile) != 1)  return(false);
+
+    WriteOffset += size;
+    WriteEntries++;
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::AddImage(const char *name, SDL_Surface *surface)
+{
+SDL_Surface *converted;
+Uint8 *pixels;
+bool written;
+
+    if (Writing == false || surface == NULL)  return(false);
+
+    converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (converted == NULL)  return(false);
+
+    pixels = (Uint8*)malloc( (size_t)converted->w * converted->h * 4 );
+    if (pixels == NULL)
+    {
+        SDL_FreeSurface(converted);
+        return(false);
+    }
+
+    SDL_LockSurface(converted);
+    for (int y = 0; y < converted->h; y++)
+        memcpy(pixels + (size_t)y * converted->w * 4, (Uint8*)converted->pixels + (size_t)y * converted->pitch, (size_t)converted->w * 4);
+    SDL_UnlockSurface(converted);
+
+    written = WriteEntry(name, AssetPackImage, pixels, (Uint32)(converted->w * converted->h * 4), converted->w, converted->h, SDL_PIXELFORMAT_RGBA32);
+
+    free(pixels);
+    SDL_FreeSurface(converted);
+    return(written);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::AddSound(const char *name, Mix_Chunk *chunk)
+{
+int frequency;
+Uint16 format;
+int channels;
+
+    if (Writing == false || chunk == NULL)  return(false);
+
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0)  return(false);
+
+    return( WriteEntry(name, AssetPackSound, chunk->abuf, chunk->alen, (Uint32)frequency, (Uint32)channels, format) );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::EndWrite(void)
+{
+AssetPackHeader header;
+Uint8 padding[16];
+bool written;
+
+    if (Writing == false)  return(false);
+
+    memset(padding, 0, sizeof padding);
+    if ( (WriteOffset % 16) != 0 )
+    {
+        fwrite(padding, 16 - (WriteOffset % 16), 1, WriteFile);
+        WriteOffset += 16 - (WriteOffset % 16);
+    }
+
+    header.Magic = AssetPackMagic;
+    header.Version = AssetPackVersion;
+    header.Entries = WriteEntries;
+    header.TableOffset = WriteOffset;
+    header.SourceTime = NewestSourceTime();
+
+    fwrite(WriteTable, sizeof(AssetPackEntry), WriteEntries, WriteFile);
+    fseek(WriteFile, 0, SEEK_SET);
+    fwrite(&header, sizeof header, 1, WriteFile);
+
+    written = (ferror(WriteFile) == 0);
+    fclose(WriteFile);
+    WriteFile = NULL;
+    Writing = false;
+
+    if (written == false)  printf("*****ERROR: Writing the asset pack failed*****\n");
+    else  printf("Asset pack written: %u assets in %u KB.\n", WriteEntries, (Uint32)( (WriteOffset + WriteEntries * sizeof(AssetPackEntry)) / 1024 ));
+
+    return(written);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool AssetPack::Pack(const char *filename)
+{
+char name[AssetPackNameLength];
+int sounds = 0;
+
+    if (visuals == NULL)
+    {
+        printf("*****ERROR: Asset packing needs a window and fonts*****\n");
+        return(false);
+    }
+
+    if (BeginWrite(filename) == false)  return(false);
+
+    /* Each sprite is written as the surface its loader turns into a texture, so button and staff text come pre-rendered */
+    visuals->LoadSpritesAndInitialize();
+    visuals->FinishLoadingSprites();
+    for (int index = 0; index < NumberOfSprites; index++)
+    {
+        if (visuals->CoreFailure == false && visuals->SpriteLoadsOnDemand(index) == true && visuals->Sprites[index].Texture == NULL)
+            visuals->LoadSprite(index);
+    }
+
+    if (visuals->CoreFailure == true)
+    {
+        EndWrite();
+        remove(filename);
+        printf("*****ERROR: Asset pack not written, sprites failed to load*****\n");
+        return(false);
+    }
+
+    /* Effects are decoded to the mixer's format, music stays Ogg Vorbis and keeps streaming from the loose files */
+    if ( SDL_InitSubSystem(SDL_INIT_AUDIO) == 0 )
+    {
+        audio->SetupAudio();
+        audio->FinishLoadingAudio();
+
+        for (int index = 0; index < SoundTotal; index++)
+        {
+            SDL_snprintf(name, sizeof name, "sound/%i", index);
+            if ( AddSound(name, audio->SoundFX[index]) == true )  sounds++;
+        }
+    }
+    if (sounds < SoundTotal)  printf("Only %i of %i sound effects packed, the rest load from loose files.\n", sounds, SoundTotal);
+
+    return( EndWrite() );
+}
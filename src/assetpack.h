@@ -0,0 +1,94 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ASSETPACK
+#define ASSETPACK
+
+/* Optional single file of pre-decoded assets, "tc4-tribute3 --pack [file]" writes it from the loose files in data */
+/* File = AssetPackHeader, entry data (each 16 byte aligned), then the table of AssetPackEntries, all in host byte order */
+/* A pack older than any loose file it was made from is ignored, "make pack" rebuilds it */
+class AssetPack
+{
+public:
+
+    #define AssetPackFilename       "data/Assets.pak"
+    #define AssetPackMagic          0x4B503443  /* "C4PK" */
+    #define AssetPackVersion        2
+    #define AssetPackMaxEntries     512
+    #define AssetPackNameLength     24
+
+    #define AssetPackImage          1  /* Tightly packed SDL_PIXELFORMAT_RGBA32 rows */
+    #define AssetPackSound          2  /* Raw samples in the mixer's output format */
+
+    struct AssetPackHeader
+    {
+        Uint32 Magic;
+        Uint32 Version;
+        Uint32 Entries;
+        Uint32 TableOffset;
+        Uint32 SourceTime;  /* Modification time of the newest loose file when packed */
+    };
+
+    struct AssetPackEntry
+    {
+        char Name[AssetPackNameLength];
+        Uint32 Type;
+        Uint32 Offset;
+        Uint32 Size;
+        Uint32 Width;   /* Sounds: frequency */
+        Uint32 Height;  /* Sounds: channels */
+        Uint32 Format;  /* Sounds: SDL audio format */
+    };
+
+    Uint8 *Data;
+    size_t DataSize;
+    bool Mapped;
+    void *MapHandle;
+    AssetPackEntry *Table;
+    Uint32 Entries;
+
+    FILE *WriteFile;
+    AssetPackEntry WriteTable[AssetPackMaxEntries];
+    Uint32 WriteEntries;
+    Uint32 WriteOffset;
+    bool Writing;
+
+	AssetPack(void);
+	virtual ~AssetPack(void);
+
+    Uint32 NewestFileTime(const char *directory);
+    Uint32 NewestSourceTime(void);
+
+    bool Open(const char *filename);
+    void Close(void);
+
+    const AssetPackEntry *Find(const char *name, Uint32 type);
+    const Uint8 *EntryData(const AssetPackEntry *entry);
+
+    bool BeginWrite(const char *filename);
+    bool WriteEntry(const char *name, Uint32 type, const void *data, Uint32 size, Uint32 width, Uint32 height, Uint32 format);
+    bool AddImage(const char *name, SDL_Surface *surface);
+    bool AddSound(const char *name, Mix_Chunk *chunk);
+    bool EndWrite(void);
+
+    bool Pack(const char *filename);
+};
+
+#endif
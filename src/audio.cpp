@@ -30,9 +30,11 @@
 
 #include "screens.h"
 #include "visuals.h"
+#include "assetpack.h"
 
 extern Screens* screens;
 extern Visuals* visuals;
+extern AssetPack* assetPack;
 
 //-------------------------------------------------------------------------------------------------
 Audio::Audio(void)
@@ -50,6 +52,8 @@ Audio::Audio(void)
     for (int musicIndex = 0; musicIndex < MusicTotal; musicIndex++)  MusicTrack[musicIndex] = NULL;
 
     AudioWorking = false;
+    AudioLoading = false;
+    AudioLoadThreads = 0;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -57,6 +61,8 @@ Audio::~Audio(void)
 {
     if (AudioWorking == false)  return;
 
+    FinishLoadingAudio();
+
     Mix_HaltChannel(-1);
     for (int soundIndex = 0; soundIndex < SoundTotal; soundIndex++)
     {
@@ -116,292 +122,381 @@ void Audio::SetupAudio(void)
         Mix_Volume(channel, SoundVolume);
     }
 
-    for (int index = 0; index < MusicTotal; index++)
+    int current = 0;
+    for (int index = 1; index < 20; index++)
+    {
+        PlayingMusicArray[current] = index;
+        current++;
+    }
+    for (int index = 31; index < (40); index++)
+    {
+        PlayingMusicArray[current] = index;
+        current++;
+    }
+    PlayingMusicArrayMax = current;
+    Mix_VolumeMusic(MusicVolume);
+
+    /* The logo screens play the title music and the menu sounds, the rest loads on worker threads while they show */
+    for (int index = 0; index < AudioPreloadedMusic; index++)  LoadMusicTrack(index);
+    for (int index = 0; index < AudioPreloadedSounds; index++)  LoadSoundEffect(index);
+
+    AudioWorking = true;
+
+    AudioLoadingTicks = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&AudioLoadNext, 0);
+
+    AudioLoadThreads = SDL_GetCPUCount();
+    if (AudioLoadThreads < 1)  AudioLoadThreads = 1;
+    if (AudioLoadThreads > MaxAudioLoadThreads)  AudioLoadThreads = MaxAudioLoadThreads;
+
+    for (int thread = 0; thread < AudioLoadThreads; thread++)
     {
-        switch(index)
+        AudioLoadThread[thread] = SDL_CreateThread(AudioLoadWorker, "AudioLoad", this);
+        if (AudioLoadThread[thread] == NULL)
         {
-            case 0:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Title.ogg");
-                break;
+            AudioLoadThreads = thread;
+            break;
+        }
+    }
+
+    AudioLoading = true;
+    if (AudioLoadThreads == 0)  FinishLoadingAudio();
+}
 
-            case 1:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-1.ogg");
-                break;
+//-------------------------------------------------------------------------------------------------
+void Audio::LoadMusicTrack(int index)
+{
+    switch(index)
+    {
+        case 0:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Title.ogg");
+            break;
 
-            case 2:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-2.ogg");
-                break;
+        case 1:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-1.ogg");
+            break;
 
-            case 3:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-3.ogg");
-                break;
+        case 2:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-2.ogg");
+            break;
 
-            case 4:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-4.ogg");
-                break;
+        case 3:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-3.ogg");
+            break;
 
-            case 5:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-5.ogg");
-                break;
+        case 4:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-4.ogg");
+            break;
 
-            case 6:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-6.ogg");
-                break;
+        case 5:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-5.ogg");
+            break;
 
-            case 7:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-7.ogg");
-                break;
+        case 6:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-6.ogg");
+            break;
 
-            case 8:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-8.ogg");
-                break;
+        case 7:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-7.ogg");
+            break;
 
-            case 9:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-9.ogg");
-                break;
+        case 8:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-8.ogg");
+            break;
 
-            case 10:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-10.ogg");
-                break;
+        case 9:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-9.ogg");
+            break;
 
-            case 11:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-11.ogg");
-                break;
+        case 10:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-10.ogg");
+            break;
 
-            case 12:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-12.ogg");
-                break;
+        case 11:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-11.ogg");
+            break;
 
-            case 13:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-13.ogg");
-                break;
+        case 12:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-12.ogg");
+            break;
 
-            case 14:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-14.ogg");
-                break;
+        case 13:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-13.ogg");
+            break;
 
-            case 15:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-15.ogg");
-                break;
+        case 14:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-14.ogg");
+            break;
 
-            case 16:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-16.ogg");
-                break;
+        case 15:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-15.ogg");
+            break;
 
-            case 17:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-17.ogg");
-                break;
+        case 16:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-16.ogg");
+            break;
 
-            case 18:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-18.ogg");
-                break;
+        case 17:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-17.ogg");
+            break;
 
-            case 19:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
-                break;
+        case 18:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-18.ogg");
+            break;
 
-            case 20:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
-                break;
+        case 19:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
+            break;
 
-            case 21:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
-                break;
+        case 20:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
+            break;
 
-            case 22:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
-                break;
+        case 21:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
+            break;
 
-            case 23:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
-                break;
+        case 22:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
+            break;
 
-            case 24:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Level7.ogg");
-                break;
+        case 23:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-19.ogg");
+            break;
 
-            case 25:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Ending.ogg");
-                break;
+        case 24:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Level7.ogg");
+            break;
 
-            case 26:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story0-2.ogg");
-                break;
+        case 25:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Ending.ogg");
+            break;
 
-            case 27:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story3-5.ogg");
-                break;
+        case 26:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story0-2.ogg");
+            break;
 
-            case 28:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story6-8.ogg");
-                break;
+        case 27:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story3-5.ogg");
+            break;
 
-            case 29:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story9.ogg");
-                break;
+        case 28:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story6-8.ogg");
+            break;
 
-            case 30:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-StoryEnd.ogg");
-                break;
+        case 29:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Story9.ogg");
+            break;
 
-            case 31:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-20.ogg");
-                break;
+        case 30:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-StoryEnd.ogg");
+            break;
 
-            case 32:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-21.ogg");
-                break;
+        case 31:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-20.ogg");
+            break;
 
-            case 33:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-22.ogg");
-                break;
+        case 32:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-21.ogg");
+            break;
 
-            case 34:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-23.ogg");
-                break;
+        case 33:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-22.ogg");
+            break;
 
-            case 35:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-24.ogg");
-                break;
+        case 34:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-23.ogg");
+            break;
 
-            case 36:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-25.ogg");
-                break;
+        case 35:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-24.ogg");
+            break;
 
-            case 37:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-26.ogg");
-                break;
+        case 36:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-25.ogg");
+            break;
 
-            case 38:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-27.ogg");
-                break;
+        case 37:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-26.ogg");
+            break;
 
-            case 39:
-                MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-28.ogg");
-                break;
+        case 38:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-27.ogg");
+            break;
 
-            default:
-                break;
-        }
+        case 39:
+            MusicTrack[index] = Mix_LoadMUS("data/music/BGM-Track-28.ogg");
+            break;
 
-        int current = 0;
-        for (int index = 1; index < 20; index++)
-        {
-            PlayingMusicArray[current] = index;
-            current++;
-        }
-        for (int index = 31; index < (40); index++)
-        {
-            PlayingMusicArray[current] = index;
-            current++;
-        }
-        PlayingMusicArrayMax = current;
+        default:
+            break;
+    }
+
+    if(!MusicTrack[index] && MusicTotal != 0)
+    {
+        printf("ERROR: Couldn't load music %s\n", Mix_GetError());
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Audio::LoadSoundEffect(int index)
+{
+const AssetPack::AssetPackEntry *entry = NULL;
+char name[AssetPackNameLength];
+int frequency;
+Uint16 format;
+int channels;
+
+    /* Packed samples already match the mixer, so they play from the mapped file without decoding or a copy */
+    if (assetPack != NULL)
+    {
+        SDL_snprintf(name, sizeof name, "sound/%i", index);
+        entry = assetPack->Find(name, AssetPackSound);
+    }
 
-        if(!MusicTrack[index] && MusicTotal != 0)
+    if ( entry != NULL && Mix_QuerySpec(&frequency, &format, &channels) != 0
+      && entry->Width == (Uint32)frequency && entry->Height == (Uint32)channels && entry->Format == format )
+    {
+        SoundFX[index] = Mix_QuickLoad_RAW( (Uint8*)assetPack->EntryData(entry), entry->Size );
+        if (SoundFX[index] != NULL)
         {
-            printf("ERROR: Couldn't load music %s\n", Mix_GetError());
+            Mix_VolumeChunk(SoundFX[index], MIX_MAX_VOLUME);
+            return;
         }
-        else  Mix_VolumeMusic(MusicVolume);
     }
-    printf("Loaded all music into memory.\n");
 
-    for (int index = 0; index < SoundTotal; index++)
+    switch(index)
     {
-        switch(index)
-        {
-            case 0:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Menu-Move.ogg");
-                break;
+        case 0:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Menu-Move.ogg");
+            break;
 
-            case 1:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Menu-Click.ogg");
-                break;
+        case 1:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Menu-Click.ogg");
+            break;
 
-            case 2:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Move-Piece.ogg");
-                break;
+        case 2:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Move-Piece.ogg");
+            break;
 
-            case 3:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Collision.ogg");
-                break;
+        case 3:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Collision.ogg");
+            break;
 
-            case 4:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Drop.ogg");
-                break;
+        case 4:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Drop.ogg");
+            break;
 
-            case 5:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Rotate.ogg");
-                break;
+        case 5:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Piece-Rotate.ogg");
+            break;
 
-            case 6:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Line-Cleared.ogg");
-                break;
+        case 6:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Line-Cleared.ogg");
+            break;
 
-            case 7:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Tetri-Cleared.ogg");
-                break;
+        case 7:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Tetri-Cleared.ogg");
+            break;
 
-            case 8:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Level-Up.ogg");
-                break;
+        case 8:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Level-Up.ogg");
+            break;
 
-            case 9:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Must-Think-In-Russian.ogg");
-                break;
+        case 9:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Must-Think-In-Russian.ogg");
+            break;
 
-            case 10:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Incoming-Line.ogg");
-                break;
+        case 10:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Incoming-Line.ogg");
+            break;
 
-            case 11:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Game-Over.ogg");
-                break;
+        case 11:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Game-Over.ogg");
+            break;
 
-            case 12:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Crack.ogg");
-                break;
+        case 12:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Crack.ogg");
+            break;
 
-            case 13:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Shall-We-Play-A-Game.ogg");
-                break;
+        case 13:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Shall-We-Play-A-Game.ogg");
+            break;
 
-            case 14:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Sword.ogg");
-                break;
+        case 14:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Sword.ogg");
+            break;
 
-            case 15:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Danger.ogg");
-                break;
+        case 15:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Danger.ogg");
+            break;
 
-            case 16:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Thrust.ogg");
-                break;
+        case 16:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Thrust.ogg");
+            break;
 
-            case 17:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Explosion.ogg");
-                break;
+        case 17:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Explosion.ogg");
+            break;
 
-            case 18:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Title.ogg");
-                break;
+        case 18:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-Title.ogg");
+            break;
 
-            case 19:
-                SoundFX[index] = Mix_LoadWAV("data/effects/SFX-DJFadingTwilight.ogg");
-                break;
+        case 19:
+            SoundFX[index] = Mix_LoadWAV("data/effects/SFX-DJFadingTwilight.ogg");
+            break;
 
-            default:
-                break;
-        }
+        default:
+            break;
+    }
 
-        if(!SoundFX[index])
-        {
-            printf("ERROR: Couldn't load sound effect %s\n", Mix_GetError());
-        }
-        else  Mix_VolumeChunk(SoundFX[index], MIX_MAX_VOLUME);
+    if(!SoundFX[index])
+    {
+        printf("ERROR: Couldn't load sound effect %s\n", Mix_GetError());
     }
-    printf("Loaded all sounds into memory.\n");
+    else  Mix_VolumeChunk(SoundFX[index], MIX_MAX_VOLUME);
+}
 
-    AudioWorking = true;
+//-------------------------------------------------------------------------------------------------
+void Audio::LoadAudioJob(int job)
+{
+    /* Sound effects first, they are short and every game needs them */
+    if (job < SoundTotal)
+    {
+        if (job >= AudioPreloadedSounds)  LoadSoundEffect(job);
+    }
+    else if ( (job - SoundTotal) >= AudioPreloadedMusic )  LoadMusicTrack(job - SoundTotal);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Audio::AudioLoadWorker(void *data)
+{
+Audio *audio = (Audio*)data;
+int job;
+
+    while ( (job = SDL_AtomicAdd(&audio->AudioLoadNext, 1)) < (SoundTotal + MusicTotal) )  audio->LoadAudioJob(job);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Audio::FinishLoadingAudio(void)
+{
+int job;
+
+    if (AudioLoading == false)  return;
+
+    /* Anything no worker has started yet is loaded right here instead of waiting */
+    while ( (job = SDL_AtomicAdd(&AudioLoadNext, 1)) < (SoundTotal + MusicTotal) )  LoadAudioJob(job);
+
+    for (int thread = 0; thread < AudioLoadThreads; thread++)  SDL_WaitThread(AudioLoadThread[thread], NULL);
+    AudioLoadThreads = 0;
+
+    AudioLoading = false;
+
+    printf( "Loaded all music and sounds into memory in %.0f ms.\n"
+           , (double)(SDL_GetPerformanceCounter() - AudioLoadingTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency() );
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -409,6 +504,8 @@ void Audio::PlayMusic(Uint8 musicIndex, int loop)
 {
     if (AudioWorking == false)  return;
 
+    if (AudioLoading == true && musicIndex >= AudioPreloadedMusic)  FinishLoadingAudio();
+
     if (MusicTrack[musicIndex] == NULL)  return;
 
     if (musicIndex >= MusicTotal)  return;
@@ -434,6 +531,8 @@ void Audio::PlayDigitalSoundFX(Uint8 soundIndex, int loops)
 {
     if (AudioWorking == false)  return;
 
+    if (AudioLoading == true && soundIndex >= AudioPreloadedSounds)  FinishLoadingAudio();
+
     if (SoundFX[soundIndex] == NULL)  return;
 
     if (soundIndex >= SoundTotal)  return;
@@ -443,7 +542,7 @@ void Audio::PlayDigitalSoundFX(Uint8 soundIndex, int loops)
     for (int index = 1; index < 32; index++)
         Mix_Volume( index, SoundVolume );
 
-    for (int indexTwo = 0; indexTwo < SoundTotal; indexTwo++)
+    for (int indexTwo = 0; indexTwo < (AudioLoading == true ? AudioPreloadedSounds : SoundTotal); indexTwo++)
         Mix_VolumeChunk(SoundFX[indexTwo], SoundVolume);
 
     if(Mix_PlayChannel(-1, SoundFX[soundIndex], loops)==-1)
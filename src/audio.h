@@ -48,7 +48,22 @@ public:
     Mix_Chunk *SoundFX[SoundTotal];
     int SoundVolume;
 
+    /* Everything past the logo screens' title music and menu sounds loads on worker threads */
+    #define AudioPreloadedMusic     1
+    #define AudioPreloadedSounds    2
+    #define MaxAudioLoadThreads     4
+    SDL_Thread *AudioLoadThread[MaxAudioLoadThreads];
+    int AudioLoadThreads;
+    SDL_atomic_t AudioLoadNext;
+    bool AudioLoading;
+    Uint64 AudioLoadingTicks;
+
     void SetupAudio(void);
+    void LoadMusicTrack(int index);
+    void LoadSoundEffect(int index);
+    void LoadAudioJob(int job);
+    static int AudioLoadWorker(void *data);
+    void FinishLoadingAudio(void);
     void PlayMusic(Uint8 musicIndex, int loop);
     void PlayDigitalSoundFX(Uint8 soundIndex, int loop);
 };
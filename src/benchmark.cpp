@@ -0,0 +1,608 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "transposition.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
+#include "logic.h"
+#include "environment.h"
+
+#include "benchmark.h"
+#include "screens.h"
+
+extern Logic* logic;
+extern Screens* screens;
+
+//-------------------------------------------------------------------------------------------------
+Benchmark::Benchmark(void)
+{
+    FixtureSeed = 0x16B17;
+}
+
+//-------------------------------------------------------------------------------------------------
+Benchmark::~Benchmark(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Benchmark::FixtureRandom(void)
+{
+    FixtureSeed ^= FixtureSeed << 13;
+    FixtureSeed ^= FixtureSeed >> 17;
+    FixtureSeed ^= FixtureSeed << 5;
+
+    return(FixtureSeed);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Benchmark::SetupAIFixture(int fixture)
+{
+int garbageHeight;
+
+    FixtureSeed = 0x16B17 + (fixture * 7919);
+
+    logic->Player = 1;
+    logic->ClearPlayfieldsWithCollisionDetection();
+
+    garbageHeight = (FixtureRandom() % 13);
+    for (int y = (23-garbageHeight); y < 24; y++)
+    {
+        for (int x = 2; x < 12; x++)
+        {
+            if ( (FixtureRandom() % 10) < 7 )  logic->PlayerData[1].Playfield[x][y] = ( 11 + (FixtureRandom() % 7) );
+        }
+
+        logic->PlayerData[1].Playfield[ 2 + (FixtureRandom() % 10) ][y] = 0;
+    }
+
+    logic->PlayerData[1].Piece = ( 1 + (FixtureRandom() % 7) );
+    logic->PlayerData[1].PieceRotation = 1;
+    logic->PlayerData[1].PiecePlayfieldX = 5;
+    logic->PlayerData[1].PiecePlayfieldY = ( logic->PieceDropStartHeight[ logic->PlayerData[1].Piece ] + 2 + (FixtureRandom() % 4) );
+    logic->PlayerData[1].PlayfieldStartX = 2;
+    logic->PlayerData[1].PlayfieldEndX = 12;
+    logic->PlayerData[1].PlayerStatus = PieceFalling;
+    logic->PlayerData[1].NextPiece = ( 1 + (FixtureRandom() % 7) );
+
+    logic->RehashPlayfield(1);
+}
+
+//-------------------------------------------------------------------------------------------------
+double Benchmark::SecondsSince(Uint64 startTicks)
+{
+    return( (double)(SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency() );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Benchmark::RunAIBenchmark(void)
+{
+Logic::PlayData *playData;
+static float reference[BenchmarkFixtures][5][15][5];
+int mismatches = 0;
+int bestKernel;
+Uint64 startTicks;
+double referenceSeconds;
+
+    printf("A.I. move scoring benchmark: %i boards, every column and rotation of one piece per board\n", BenchmarkFixtures);
+
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+    logic->InitializePieceData();
+    playData = &logic->PlayerData[1];
+    bestKernel = logic->AIBitboard[1]->Kernel;
+
+    for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+    {
+        SetupAIFixture(fixture);
+        logic->ScoreComputerPlayerMovesReference();
+
+        for (int x = 0; x < 15; x++)
+            for (int rot = 0; rot < 5; rot++)
+            {
+                reference[fixture][0][x][rot] = playData->MovePieceCollision[x][rot];
+                reference[fixture][1][x][rot] = playData->MovePieceHeight[x][rot] + playData->MoveCompletedLines[x][rot];
+                reference[fixture][2][x][rot] = playData->MoveTrappedHoles[x][rot];
+                reference[fixture][3][x][rot] = playData->MovePlayfieldBoxEdges[x][rot];
+                reference[fixture][4][x][rot] = playData->MoveOneBlockCavernHoles[x][rot];
+            }
+    }
+
+    int referencePasses = 20;
+    referenceSeconds = 0.0;
+    for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+    {
+        SetupAIFixture(fixture);
+
+        startTicks = SDL_GetPerformanceCounter();
+        for (int pass = 0; pass < referencePasses; pass++)  logic->ScoreComputerPlayerMovesReference();
+        referenceSeconds += SecondsSince(startTicks);
+    }
+
+    double referenceMicroseconds = ( referenceSeconds * 1000000.0 / (referencePasses * BenchmarkFixtures) );
+    printf("  Cell-by-cell reference: %8.3f us per piece\n", referenceMicroseconds);
+
+    for (int kernel = BitboardKernelScalar; kernel <= BitboardKernelIncremental; kernel++)
+    {
+        if ( (kernel == BitboardKernelSSE2 || kernel == BitboardKernelAVX2)
+        && (kernel > bestKernel || bestKernel == BitboardKernelIncremental) )  continue;
+
+        logic->AIBitboard[1]->Kernel = kernel;
+
+        for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+        {
+            SetupAIFixture(fixture);
+            logic->ScoreComputerPlayerMoves();
+
+            for (int x = 0; x < 11; x++)
+                for (int rot = 1; rot <= logic->MaxRotationArray[playData->Piece]; rot++)
+                {
+                    if ( (float)playData->MovePieceCollision[x][rot] != reference[fixture][0][x][rot] )  mismatches++;
+                    else if (playData->MovePieceCollision[x][rot] == true)  continue;
+                    else if ( playData->MovePieceHeight[x][rot] + playData->MoveCompletedLines[x][rot] != reference[fixture][1][x][rot]
+                    || playData->MoveTrappedHoles[x][rot] != reference[fixture][2][x][rot]
+                    || playData->MovePlayfieldBoxEdges[x][rot] != reference[fixture][3][x][rot]
+                    || playData->MoveOneBlockCavernHoles[x][rot] != reference[fixture][4][x][rot] )  mismatches++;
+                }
+        }
+
+        int passes = 400;
+        double bitboardSeconds = 0.0;
+        for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+        {
+            SetupAIFixture(fixture);
+
+            /* The scoring is timed, not the scored moves cache */
+            startTicks = SDL_GetPerformanceCounter();
+            for (int pass = 0; pass < passes; pass++)
+            {
+                logic->AIBitboard[1]->ScoredValid = false;
+                logic->ScoreComputerPlayerMoves();
+            }
+            bitboardSeconds += SecondsSince(startTicks);
+        }
+
+        double bitboardMicroseconds = ( bitboardSeconds * 1000000.0 / (passes * BenchmarkFixtures) );
+
+        printf("  Bitboard %-6s kernel: %8.3f us per piece (%.1fx)\n", logic->AIBitboard[1]->KernelName(kernel)
+               , bitboardMicroseconds, referenceMicroseconds / bitboardMicroseconds);
+
+        if (kernel != BitboardKernelIncremental)  continue;
+
+        /* Same again, but rebuilding the cached board features every time as on a fresh playfield */
+        bitboardSeconds = 0.0;
+        for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+        {
+            SetupAIFixture(fixture);
+
+            startTicks = SDL_GetPerformanceCounter();
+            for (int pass = 0; pass < passes; pass++)
+            {
+                logic->AIBitboard[1]->BoxesChanged();
+                logic->ScoreComputerPlayerMoves();
+            }
+            bitboardSeconds += SecondsSince(startTicks);
+        }
+
+        bitboardMicroseconds = ( bitboardSeconds * 1000000.0 / (passes * BenchmarkFixtures) );
+        printf("  Bitboard %-6s kernel: %8.3f us per piece with a new board every piece (%.1fx)\n", logic->AIBitboard[1]->KernelName(kernel)
+               , bitboardMicroseconds, referenceMicroseconds / bitboardMicroseconds);
+    }
+
+    logic->AIBitboard[1]->Kernel = bestKernel;
+
+    /* A C.P.U. player asking again about an unchanged playfield only pays for the comparison */
+    int passes = 400;
+    double cachedSeconds = 0.0;
+    for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+    {
+        SetupAIFixture(fixture);
+
+        startTicks = SDL_GetPerformanceCounter();
+        for (int pass = 0; pass < passes; pass++)  logic->ScoreComputerPlayerMoves();
+        cachedSeconds += SecondsSince(startTicks);
+    }
+
+    double cachedMicroseconds = ( cachedSeconds * 1000000.0 / (passes * BenchmarkFixtures) );
+    printf("  Unchanged board, scored moves cached: %8.3f us per piece (%.1fx)\n", cachedMicroseconds, referenceMicroseconds / cachedMicroseconds);
+
+    if (mismatches > 0)  printf("*****ERROR: %i bitboard scores differ from the reference*****\n", mismatches);
+    else  printf("  All bitboard scores match the reference.\n");
+
+    int neuralMismatches = RunNeuralBenchmark();
+    int rolloutMismatches = RunRolloutBenchmark();
+
+    return(mismatches == 0 && neuralMismatches == 0 && rolloutMismatches == 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Benchmark::RunNeuralBenchmark(void)
+{
+Search *search = logic->AISearch[1];
+Neural *network = logic->AINeural;
+Bitboard *board = logic->AIBitboard[1];
+static float scalarValue[BenchmarkFixtures][BitboardMaxMoves];
+static NeuralLanes moveLanes;
+static NeuralLanes boardLanes;
+int mismatches = 0;
+int featureMismatches = 0;
+int bestKernel = network->Kernel;
+Uint64 startTicks;
+
+    printf("A.I. evaluator benchmark: every placement of one piece per board, %s weights\n"
+           , (network->Loaded == true ? "trained" : "untrained") );
+
+    search->Network = network;
+
+    /* Placements that complete no line get their features from the board's cached columns and rows, they must match a full rescan */
+    for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+    {
+        SetupAIFixture(fixture);
+
+        Uint8 piece = logic->PlayerData[1].Piece;
+        board->LoadPlayfield(logic->PlayerData[1].Playfield);
+        board->ScoreAllMoves(piece, logic->MaxRotationArray[piece], 2, 12, logic->PlayerData[1].PiecePlayfieldY);
+        network->LoadBoard(&moveLanes, board);
+
+        for (int move = 0; move < board->MovesCount; move++)
+        {
+            if (board->MoveCollision[move] == true || board->MoveCompletedLines[move] > 0)  continue;
+
+            network->ExtractMoveFeatures(&moveLanes, board, piece, move, 0);
+            search->Scratch->LoadPlacement(board, piece, move);
+            network->ExtractFeatures(&boardLanes, search->Scratch, board->MoveLandedY[move], 0, 0);
+
+            for (int input = 0; input < NeuralInputs; input++)
+                if (moveLanes.Input[input][0] != boardLanes.Input[input][0])  featureMismatches++;
+        }
+    }
+
+    for (int evaluator = SearchGiftOfSight; evaluator <= SearchNeural; evaluator++)
+        for (int kernel = NeuralKernelScalar; kernel <= NeuralKernelAVX2; kernel++)
+        {
+            if ( (evaluator == SearchGiftOfSight && kernel != NeuralKernelScalar) || kernel > bestKernel )  continue;
+
+            search->Evaluator = evaluator;
+            network->Kernel = kernel;
+
+            int passes = 100;
+            double seconds = 0.0;
+            for (int fixture = 0; fixture < BenchmarkFixtures; fixture++)
+            {
+                SetupAIFixture(fixture);
+                logic->AIBitboard[1]->LoadPlayfield(logic->PlayerData[1].Playfield);
+
+                startTicks = SDL_GetPerformanceCounter();
+                for (int pass = 0; pass < passes; pass++)
+                    search->Start(logic->AIBitboard[1], logic->PlayerData[1].Piece, logic->PlayerData[1].Piece, 2, 12
+                                  , logic->PlayerData[1].PiecePlayfieldY);
+                seconds += SecondsSince(startTicks);
+
+                /* Both kernels multiply and add in the same order, so they must agree to the last bit */
+                for (int move = 0; move < search->Board[0]->MovesCount; move++)
+                {
+                    if (evaluator != SearchNeural)  break;
+
+                    if (kernel == NeuralKernelScalar)  scalarValue[fixture][move] = search->Value[0][move];
+                    else if (search->Value[0][move] != scalarValue[fixture][move])  mismatches++;
+                }
+            }
+
+            printf("  %-13s %-6s: %8.3f us per piece\n", (evaluator == SearchNeural ? "Neural" : "Gift Of Sight")
+                   , (evaluator == SearchNeural ? network->KernelName(kernel) : ""), seconds * 1000000.0 / (passes * BenchmarkFixtures) );
+        }
+
+    search->Evaluator = SearchGiftOfSight;
+    network->Kernel = bestKernel;
+
+    if (mismatches > 0)  printf("*****ERROR: %i neural kernel outputs differ from the scalar kernel*****\n", mismatches);
+    else if (bestKernel != NeuralKernelScalar)  printf("  All neural kernel outputs match the scalar kernel.\n");
+
+    if (featureMismatches > 0)  printf("*****ERROR: %i neural placement features differ from a full rescan*****\n", featureMismatches);
+    else  printf("  All neural placement features match a full rescan of the board.\n");
+
+    return(mismatches + featureMismatches);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Benchmark::RunRolloutBenchmark(void)
+{
+Search *search = logic->AISearch[1];
+Rollout *pool = logic->AIRollout;
+static float reference[BenchmarkFixtures/4][RolloutMaxCandidates];
+int mismatches = 0;
+int poolThreads = pool->Threads;
+bool poolStarted = pool->ThreadsStarted;
+int cpus = SDL_GetCPUCount();
+double oneThreadRate = 0.0;
+Uint64 startTicks;
+
+    printf("A.I. Monte Carlo rollout benchmark: %i boards, %i rollouts of %i pieces per board, %i logical CPUs\n"
+           , BenchmarkFixtures/4, RolloutsPerMove, RolloutPieces, cpus);
+
+    search->Evaluator = SearchGiftOfSight;
+
+    /* One thread, then twice as many each time up to every CPU, always at least two so the threaded path is checked */
+    for (int threads = 1; threads <= cpus || threads <= 2; threads*=2)
+    {
+        if (threads > RolloutMaxThreads)  break;
+
+        pool->StopThreads();
+        pool->StartThreads(threads);
+
+        double seconds = 0.0;
+        for (int fixture = 0; fixture < BenchmarkFixtures/4; fixture++)
+        {
+            SetupAIFixture(fixture);
+            logic->AIBitboard[1]->LoadPlayfield(logic->PlayerData[1].Playfield);
+            search->Start(logic->AIBitboard[1], logic->PlayerData[1].Piece, logic->PlayerData[1].NextPiece, 2, 12
+                          , logic->PlayerData[1].PiecePlayfieldY);
+            search->StartRollouts(fixture);
+
+            float total[RolloutMaxCandidates] = { 0.0f };
+
+            startTicks = SDL_GetPerformanceCounter();
+            for (Uint32 first = 0; first < RolloutsPerMove; first+=RolloutMaxBatch)
+            {
+                int count = ( (RolloutsPerMove - first) < RolloutMaxBatch ? (RolloutsPerMove - first) : RolloutMaxBatch );
+                pool->Run(search, first, count);
+
+                for (int index = 0; index < count; index++)  total[ (first + index) % search->RolloutCandidates ]+=pool->Result[index];
+            }
+            seconds += SecondsSince(startTicks);
+
+            for (int candidate = 0; candidate < search->RolloutCandidates; candidate++)
+            {
+                if (threads == 1)  reference[fixture][candidate] = total[candidate];
+                else if (total[candidate] != reference[fixture][candidate])  mismatches++;
+            }
+        }
+
+        double rate = ( (double)(RolloutsPerMove * (BenchmarkFixtures/4)) / seconds );
+        if (threads == 1)  oneThreadRate = rate;
+
+        printf("  %2i thread%s: %9.0f rollouts per second (%.2fx)\n", threads, (threads == 1 ? " " : "s"), rate, rate / oneThreadRate);
+    }
+
+    pool->StopThreads();
+    if (poolStarted == true)  pool->StartThreads(poolThreads);
+
+    if (mismatches > 0)  printf("*****ERROR: %i rollout totals change with the thread count*****\n", mismatches);
+    else  printf("  Rollout totals are the same for every thread count.\n");
+
+    return(mismatches);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Benchmark::SetupAIBatch(int skill, int gameMode)
+{
+    /* Same setup as the "A.I. TEST" screen (Shift+T on the title screens), minus the drawing */
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+
+    srand(1);
+
+    logic->GameMode = gameMode;
+    logic->CPUPlayerEnabled = skill;
+    logic->SetupForNewGame();
+
+    logic->VerifyPlayfieldHash = true;
+    logic->PlayfieldHashMismatches = 0;
+    logic->AITransposition->Clear();
+
+    /* Search budgets are counted in nodes rather than read from the clock, so every run plays the same games */
+    for (int player = 0; player < NumberOfPlayers; player++)  logic->AISearch[player]->NodeBudget = true;
+    logic->AIFrameMicrosecondsMostUsed = 0;
+    logic->AISearchMoves = 0;
+    logic->AISearchDepthTotal = 0;
+    logic->AISearchReplans = 0;
+    logic->AISearchRollouts = 0;
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        PlayerGamesLost[player] = 0;
+        PlayerLines[player] = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Benchmark::RunAIBatchFrame(void)
+{
+    logic->RunTetriGameEngine();
+
+    for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
+    {
+        logic->PlayerData[logic->Player].TimeToDropPiece = 47;
+
+        if (logic->PlayerData[logic->Player].PlayerStatus == GameOver)
+        {
+            PlayerGamesLost[logic->Player]++;
+            PlayerLines[logic->Player]+=logic->PlayerData[logic->Player].Lines;
+
+            logic->RestartComputerSkillTestPlayer();
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Benchmark::RunAIBatch(Uint32 games, Uint32 maxFrames, int skill, int ai, int gameMode)
+{
+Uint32 frames = 0;
+Uint64 startTicks;
+Uint32 startingGames;
+Uint32 totalLines;
+double seconds;
+
+    printf("A.I. batch: up to %u %sgames of four C.P.U. players at skill %i (%u us per move), at most %u frames\n", games
+           , (gameMode == CrisisMode ? "Crisis mode " : ""), skill, logic->AIMoveBudgetMicroseconds[skill & 7], maxFrames);
+
+    SetupAIBatch(skill, gameMode);
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        bool underTest = (player == 0 || gameMode != CrisisMode);
+
+        logic->PlayerData[player].AIEvaluator = ( ai == BenchmarkAINeural && underTest ? SearchNeural : SearchGiftOfSight );
+        logic->PlayerData[player].AIRollouts = ( ai == BenchmarkAIRollouts && underTest );
+    }
+    if (ai == BenchmarkAIRollouts)  logic->AIRollout->StartThreadsIfNeeded();
+
+    if (ai == BenchmarkAINeural && logic->AINeural->Loaded == false)  printf("  No neural weights loaded, Gift Of Sight plays instead\n");
+    else if (ai == BenchmarkAINeural)  printf("  Evaluator: neural network (%s)\n", logic->AINeural->KernelName(logic->AINeural->Kernel));
+    else if (ai == BenchmarkAIRollouts)  printf("  Monte Carlo rollouts on %i thread%s\n", logic->AIRollout->Threads, (logic->AIRollout->Threads == 1 ? "" : "s"));
+
+    startingGames = logic->NumberofCPUGames;
+
+    startTicks = SDL_GetPerformanceCounter();
+    while ( (logic->NumberofCPUGames - startingGames) < games && frames < maxFrames )
+    {
+        RunAIBatchFrame();
+        frames++;
+    }
+    seconds = SecondsSince(startTicks);
+
+    totalLines = ( logic->TotalOneLines+(2*logic->TotalTwoLines)+(3*logic->TotalThreeLines)+(4*logic->TotalFourLines) );
+
+    printf("  Games finished: %u  Frames: %u (%.0f frames per second)\n", logic->NumberofCPUGames - startingGames, frames, frames / seconds);
+    printf("  Lines: %u  (1=%u 2=%u 3=%u 4=%u)\n", totalLines, logic->TotalOneLines, logic->TotalTwoLines, logic->TotalThreeLines, logic->TotalFourLines);
+    printf("  Transposition table: %.1f%% hits (%llu of %llu probes), %u KB\n", logic->AITransposition->HitRate()
+           , (unsigned long long)logic->AITransposition->Hits.load(), (unsigned long long)logic->AITransposition->Probes.load()
+           , logic->AITransposition->MemoryUsed() / 1024);
+
+    printf("  Search: %u moves, average depth %.2f, at most %u of %u us A.I. budget used in a frame\n", logic->AISearchMoves
+           , (logic->AISearchMoves > 0 ? (float)logic->AISearchDepthTotal / (float)logic->AISearchMoves : 0.0f)
+           , logic->AIFrameMicrosecondsMostUsed, AIFrameBudgetMicroseconds);
+    if (logic->AISearchReplans > 0)
+    {
+        printf("  Re-planned %u moves after an attack line changed the stack under the falling piece\n", logic->AISearchReplans);
+        printf("    %.0f boards scored per re-plan, average re-plan depth %.2f\n", (float)logic->AISearchReplanNodes / (float)logic->AISearchReplans
+               , (float)logic->AISearchReplanDepthTotal / (float)logic->AISearchReplans);
+    }
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        PlayerLines[player]+=logic->PlayerData[player].Lines;
+        printf("  Player %i%s: %u games lost, %u lines\n", player+1, (gameMode == CrisisMode && player == 0 ? " (A.I. under test)" : "")
+               , PlayerGamesLost[player], PlayerLines[player]);
+    }
+
+    if (logic->AISearchRollouts > 0)
+        printf("  Monte Carlo: %u rollouts, %.0f per move\n", logic->AISearchRollouts, (float)logic->AISearchRollouts / (float)logic->AISearchMoves);
+
+    if (logic->PlayfieldHashMismatches > 0)  printf("*****ERROR: %u stale playfield hashes*****\n", logic->PlayfieldHashMismatches);
+
+    logic->VerifyPlayfieldHash = false;
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        logic->PlayerData[player].AIEvaluator = SearchGiftOfSight;
+        logic->PlayerData[player].AIRollouts = false;
+    }
+    for (int player = 0; player < NumberOfPlayers; player++)  logic->AISearch[player]->NodeBudget = false;
+
+    return(logic->PlayfieldHashMismatches == 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Benchmark::RunEnvironmentBenchmark(int games, Uint32 steps)
+{
+Environment *environment;
+Uint16 *observations;
+int *actions;
+float *rewards;
+Uint8 *dones;
+Uint32 gamesOver = 0;
+double lines = 0.0;
+double environmentSeconds = 0.0;
+Uint64 startTicks;
+Uint64 callTicks;
+
+    if (games < 1)  games = 1;
+
+    environment = (Environment*)tc4_env_create(games);
+    observations = new Uint16[games * EnvironmentObservationWords];
+    actions = new int[games];
+    rewards = new float[games];
+    dones = new Uint8[games];
+
+    printf("Environment benchmark: %i games, %u steps, random legal actions, %i threads\n", games, steps, environment->Threads);
+
+    FixtureSeed = 0x16B17;
+    tc4_env_reset(environment, 1);
+
+    startTicks = SDL_GetPerformanceCounter();
+    for (Uint32 step = 0; step < steps; step++)
+    {
+        callTicks = SDL_GetPerformanceCounter();
+        tc4_env_observe(environment, observations);
+        environmentSeconds+=SecondsSince(callTicks);
+
+        for (int game = 0; game < games; game++)
+        {
+            Uint16 *observation = &observations[game * EnvironmentObservationWords];
+            Uint64 legal = ( (Uint64)observation[23] | ((Uint64)observation[24] << 16) | ((Uint64)observation[25] << 32) );
+
+            actions[game] = 0;
+            if (legal == 0)  continue;
+
+            /* Pick the n-th legal action */
+            int pick = ( FixtureRandom() % __builtin_popcountll(legal) );
+            for (int action = 0; action < EnvironmentActions; action++)
+            {
+                if ( (legal & ((Uint64)1 << action)) == 0 )  continue;
+                if (pick-- == 0)
+                {
+                    actions[game] = action;
+                    break;
+                }
+            }
+        }
+
+        callTicks = SDL_GetPerformanceCounter();
+        tc4_env_step(environment, actions, rewards, dones);
+        environmentSeconds+=SecondsSince(callTicks);
+
+        for (int game = 0; game < games; game++)
+        {
+            lines+=rewards[game];
+            gamesOver+=dones[game];
+        }
+    }
+
+    double seconds = SecondsSince(startTicks);
+    double total = ( (double)steps * (double)games );
+
+    /* The random policy runs on one thread, so the environment's own rate is timed around its calls */
+    printf("  %.0f steps in %.2f seconds: %.0f steps per second with the random policy\n", total, seconds, total / seconds);
+    printf("  %.2f seconds in the environment: %.0f steps per second (observe + step)\n", environmentSeconds, total / environmentSeconds);
+    printf("  %.0f lines cleared, %u games over\n", lines, gamesOver);
+
+    delete [] dones;
+    delete [] rewards;
+    delete [] actions;
+    delete [] observations;
+    tc4_env_destroy(environment);
+
+    return(true);
+}
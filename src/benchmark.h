@@ -0,0 +1,59 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BENCHMARK
+#define BENCHMARK
+
+/* Headless command line tools: "tc4-tribute3 --benchmark" and "tc4-tribute3 --batch|--crisis [games] [frames] [skill] [A.I.]" */
+/* --env [games] [steps] steps the reinforcement learning Environment with random legal actions */
+/* --batch gives every player the A.I., --crisis only player 1 so attack lines from the other three test how it survives */
+class Benchmark
+{
+public:
+
+    #define BenchmarkFixtures       256
+    Uint32 FixtureSeed;
+
+    #define BenchmarkAIGiftOfSight  0
+    #define BenchmarkAINeural       1
+    #define BenchmarkAIRollouts     2
+
+    Uint32 PlayerGamesLost[NumberOfPlayers];
+    Uint32 PlayerLines[NumberOfPlayers];
+
+	Benchmark(void);
+	virtual ~Benchmark(void);
+
+    Uint32 FixtureRandom(void);
+    void SetupAIFixture(int fixture);
+    double SecondsSince(Uint64 startTicks);
+
+    bool RunAIBenchmark(void);
+    int RunNeuralBenchmark(void);
+    int RunRolloutBenchmark(void);
+
+    void SetupAIBatch(int skill, int gameMode);
+    void RunAIBatchFrame(void);
+    bool RunAIBatch(Uint32 games, Uint32 maxFrames, int skill, int ai, int gameMode);
+
+    bool RunEnvironmentBenchmark(int games, Uint32 steps);
+};
+
+#endif
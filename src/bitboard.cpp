@@ -0,0 +1,686 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define BITBOARD_X86
+    #define BITBOARD_TARGET_SSE2 __attribute__((target("sse2")))
+    #define BITBOARD_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #define BITBOARD_X86
+    #define BITBOARD_TARGET_SSE2
+    #define BITBOARD_TARGET_AVX2
+#endif
+
+#define ColumnsOneToEleven      0x0FFE
+#define ColumnsTwoToEleven      0x0FFC
+
+/*  Every kernel below computes the exact same four "Gift Of Sight" features as the original
+    cell-by-cell loops in Logic::ScoreComputerPlayerMovesReference(), one candidate move per lane:
+        trapped holes   - rows 5-23, columns 2-11, empties with a box anywhere above them
+        completed lines - rows 5-24, ten boxes in columns 1-11
+        box edges       - rows 5-24, columns 1-11, empty neighbours of every box or wall
+        cavern holes    - rows 5-23, columns 2-11, empties with non-empty left and right       */
+
+//-------------------------------------------------------------------------------------------------
+static inline Uint16 BitCount16(Uint16 value)
+{
+    value = value - ((value >> 1) & 0x5555);
+    value = (value & 0x3333) + ((value >> 2) & 0x3333);
+    value = (value + (value >> 4)) & 0x0F0F;
+    return( (value + (value >> 8)) & 0x001F );
+}
+
+//-------------------------------------------------------------------------------------------------
+static inline Uint16 CountBoxEdges(Uint16 box, Uint16 wall, Uint16 emptyAbove, Uint16 empty, Uint16 emptyBelow)
+{
+Uint16 solid = (box | wall) & ColumnsOneToEleven;
+
+    return( BitCount16(solid & emptyAbove) + BitCount16(solid & emptyBelow)
+          + BitCount16( solid & (Uint16)(empty << 1) ) + BitCount16(solid & (empty >> 1)) );
+}
+
+//-------------------------------------------------------------------------------------------------
+static inline Uint16 CountOneBlockCavernHoles(Uint16 empty)
+{
+    return( BitCount16( empty & ~(empty << 1) & ~(empty >> 1) & ColumnsTwoToEleven ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+static inline Uint16 CountCompletedLine(Uint16 box)
+{
+    return( BitCount16(box & ColumnsOneToEleven) == 10 ? 1 : 0 );
+}
+
+//-------------------------------------------------------------------------------------------------
+static void ScoreLanesScalar(Uint16 laneBox[][BitboardMaxMoves], Uint16 laneEmpty[][BitboardMaxMoves], const Uint16 *wall, int lanes
+                             , Uint16 *trapped, Uint16 *lines, Uint16 *edges, Uint16 *caverns)
+{
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        Uint16 covered = 0;
+        trapped[lane] = 0;
+        lines[lane] = 0;
+        edges[lane] = 0;
+        caverns[lane] = 0;
+
+        for (int row = 1; row < 21; row++)
+        {
+            Uint16 box = laneBox[row][lane];
+            Uint16 empty = laneEmpty[row][lane];
+
+            if (row < 20)
+            {
+                covered |= (box & ColumnsTwoToEleven);
+                trapped[lane] += BitCount16(empty & covered);
+                caverns[lane] += CountOneBlockCavernHoles(empty);
+            }
+
+            edges[lane] += CountBoxEdges(box, wall[row+4], laneEmpty[row-1][lane], empty, laneEmpty[row+1][lane]);
+            lines[lane] += CountCompletedLine(box);
+        }
+    }
+}
+
+#ifdef BITBOARD_X86
+//-------------------------------------------------------------------------------------------------
+BITBOARD_TARGET_SSE2 static inline __m128i BitCount16SSE2(__m128i value)
+{
+    value = _mm_sub_epi16( value, _mm_and_si128(_mm_srli_epi16(value, 1), _mm_set1_epi16(0x5555)) );
+    value = _mm_add_epi16( _mm_and_si128(value, _mm_set1_epi16(0x3333)), _mm_and_si128(_mm_srli_epi16(value, 2), _mm_set1_epi16(0x3333)) );
+    value = _mm_and_si128( _mm_add_epi16(value, _mm_srli_epi16(value, 4)), _mm_set1_epi16(0x0F0F) );
+    return( _mm_and_si128(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), _mm_set1_epi16(0x001F)) );
+}
+
+//-------------------------------------------------------------------------------------------------
+BITBOARD_TARGET_SSE2 static void ScoreLanesSSE2(Uint16 laneBox[][BitboardMaxMoves], Uint16 laneEmpty[][BitboardMaxMoves], const Uint16 *wall, int lanes
+                                                , Uint16 *trapped, Uint16 *lines, Uint16 *edges, Uint16 *caverns)
+{
+const __m128i oneToEleven = _mm_set1_epi16(ColumnsOneToEleven);
+const __m128i twoToEleven = _mm_set1_epi16(ColumnsTwoToEleven);
+const __m128i ten = _mm_set1_epi16(10);
+
+    for (int lane = 0; lane < lanes; lane+=8)
+    {
+        __m128i covered = _mm_setzero_si128();
+        __m128i trappedSum = _mm_setzero_si128();
+        __m128i linesSum = _mm_setzero_si128();
+        __m128i edgesSum = _mm_setzero_si128();
+        __m128i cavernsSum = _mm_setzero_si128();
+
+        __m128i emptyAbove = _mm_loadu_si128( (const __m128i*)&laneEmpty[0][lane] );
+        __m128i empty = _mm_loadu_si128( (const __m128i*)&laneEmpty[1][lane] );
+        for (int row = 1; row < 21; row++)
+        {
+            __m128i box = _mm_loadu_si128( (const __m128i*)&laneBox[row][lane] );
+            __m128i emptyBelow = _mm_loadu_si128( (const __m128i*)&laneEmpty[row+1][lane] );
+            __m128i solid = _mm_and_si128( _mm_or_si128(box, _mm_set1_epi16(wall[row+4])), oneToEleven );
+
+            if (row < 20)
+            {
+                covered = _mm_or_si128( covered, _mm_and_si128(box, twoToEleven) );
+                trappedSum = _mm_add_epi16( trappedSum, BitCount16SSE2(_mm_and_si128(empty, covered)) );
+
+                __m128i cavern = _mm_andnot_si128( _mm_slli_epi16(empty, 1), _mm_and_si128(empty, twoToEleven) );
+                cavern = _mm_andnot_si128(_mm_srli_epi16(empty, 1), cavern);
+                cavernsSum = _mm_add_epi16( cavernsSum, BitCount16SSE2(cavern) );
+            }
+
+            edgesSum = _mm_add_epi16( edgesSum, BitCount16SSE2(_mm_and_si128(solid, emptyAbove)) );
+            edgesSum = _mm_add_epi16( edgesSum, BitCount16SSE2(_mm_and_si128(solid, emptyBelow)) );
+            edgesSum = _mm_add_epi16( edgesSum, BitCount16SSE2(_mm_and_si128(solid, _mm_slli_epi16(empty, 1))) );
+            edgesSum = _mm_add_epi16( edgesSum, BitCount16SSE2(_mm_and_si128(solid, _mm_srli_epi16(empty, 1))) );
+
+            linesSum = _mm_sub_epi16( linesSum, _mm_cmpeq_epi16(BitCount16SSE2(_mm_and_si128(box, oneToEleven)), ten) );
+
+            emptyAbove = empty;
+            empty = emptyBelow;
+        }
+
+        _mm_storeu_si128( (__m128i*)&trapped[lane], trappedSum );
+        _mm_storeu_si128( (__m128i*)&lines[lane], linesSum );
+        _mm_storeu_si128( (__m128i*)&edges[lane], edgesSum );
+        _mm_storeu_si128( (__m128i*)&caverns[lane], cavernsSum );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+BITBOARD_TARGET_AVX2 static inline __m256i BitCount16AVX2(__m256i value)
+{
+const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+const __m256i nibbleCounts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+                                             , 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+
+    __m256i count = _mm256_add_epi8( _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(value, lowNibble))
+                                   , _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(_mm256_srli_epi16(value, 4), lowNibble)) );
+    return( _mm256_and_si256(_mm256_add_epi8(count, _mm256_srli_epi16(count, 8)), _mm256_set1_epi16(0x00FF)) );
+}
+
+//-------------------------------------------------------------------------------------------------
+BITBOARD_TARGET_AVX2 static void ScoreLanesAVX2(Uint16 laneBox[][BitboardMaxMoves], Uint16 laneEmpty[][BitboardMaxMoves], const Uint16 *wall, int lanes
+                                                , Uint16 *trapped, Uint16 *lines, Uint16 *edges, Uint16 *caverns)
+{
+const __m256i oneToEleven = _mm256_set1_epi16(ColumnsOneToEleven);
+const __m256i twoToEleven = _mm256_set1_epi16(ColumnsTwoToEleven);
+const __m256i ten = _mm256_set1_epi16(10);
+
+    for (int lane = 0; lane < lanes; lane+=16)
+    {
+        __m256i covered = _mm256_setzero_si256();
+        __m256i trappedSum = _mm256_setzero_si256();
+        __m256i linesSum = _mm256_setzero_si256();
+        __m256i edgesSum = _mm256_setzero_si256();
+        __m256i cavernsSum = _mm256_setzero_si256();
+
+        __m256i emptyAbove = _mm256_loadu_si256( (const __m256i*)&laneEmpty[0][lane] );
+        __m256i empty = _mm256_loadu_si256( (const __m256i*)&laneEmpty[1][lane] );
+        for (int row = 1; row < 21; row++)
+        {
+            __m256i box = _mm256_loadu_si256( (const __m256i*)&laneBox[row][lane] );
+            __m256i emptyBelow = _mm256_loadu_si256( (const __m256i*)&laneEmpty[row+1][lane] );
+            __m256i solid = _mm256_and_si256( _mm256_or_si256(box, _mm256_set1_epi16(wall[row+4])), oneToEleven );
+
+            if (row < 20)
+            {
+                covered = _mm256_or_si256( covered, _mm256_and_si256(box, twoToEleven) );
+                trappedSum = _mm256_add_epi16( trappedSum, BitCount16AVX2(_mm256_and_si256(empty, covered)) );
+
+                __m256i cavern = _mm256_andnot_si256( _mm256_slli_epi16(empty, 1), _mm256_and_si256(empty, twoToEleven) );
+                cavern = _mm256_andnot_si256(_mm256_srli_epi16(empty, 1), cavern);
+                cavernsSum = _mm256_add_epi16( cavernsSum, BitCount16AVX2(cavern) );
+            }
+
+            __m256i edgeBits = BitCount16AVX2( _mm256_and_si256(solid, emptyAbove) );
+            edgeBits = _mm256_add_epi16( edgeBits, BitCount16AVX2(_mm256_and_si256(solid, emptyBelow)) );
+            edgeBits = _mm256_add_epi16( edgeBits, BitCount16AVX2(_mm256_and_si256(solid, _mm256_slli_epi16(empty, 1))) );
+            edgeBits = _mm256_add_epi16( edgeBits, BitCount16AVX2(_mm256_and_si256(solid, _mm256_srli_epi16(empty, 1))) );
+            edgesSum = _mm256_add_epi16(edgesSum, edgeBits);
+
+            linesSum = _mm256_sub_epi16( linesSum, _mm256_cmpeq_epi16(BitCount16AVX2(_mm256_and_si256(box, oneToEleven)), ten) );
+
+            emptyAbove = empty;
+            empty = emptyBelow;
+        }
+
+        _mm256_storeu_si256( (__m256i*)&trapped[lane], trappedSum );
+        _mm256_storeu_si256( (__m256i*)&lines[lane], linesSum );
+        _mm256_storeu_si256( (__m256i*)&edges[lane], edgesSum );
+        _mm256_storeu_si256( (__m256i*)&caverns[lane], cavernsSum );
+    }
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+Bitboard::Bitboard(void)
+{
+    Kernel = BestKernel();
+
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        Box[y] = 0;
+        Wall[y] = 0;
+        Empty[y] = 0;
+    }
+
+    for (int piece = 0; piece < 8; piece++)
+        for (int rotation = 0; rotation < 5; rotation++)
+            for (int y = 0; y < 4; y++)
+                PieceRows[piece][rotation][y] = 0;
+
+    MovesCount = 0;
+
+    FeaturesValid = false;
+    ScoredValid = false;
+    ScoredPiece = 0;
+    ScoredMaxRotation = 0;
+    ScoredStartX = 0;
+    ScoredEndX = 0;
+    ScoredStartY = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bitboard::~Bitboard(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+int Bitboard::BestKernel(void)
+{
+#ifdef BITBOARD_X86
+    if (SDL_HasAVX2() == SDL_TRUE)  return(BitboardKernelAVX2);
+    if (SDL_HasSSE2() == SDL_TRUE)  return(BitboardKernelSSE2);
+#endif
+
+    /* Without SIMD, updating cached board features per placement beats rescoring every row */
+    return(BitboardKernelIncremental);
+}
+
+//-------------------------------------------------------------------------------------------------
+const char *Bitboard::KernelName(int kernel)
+{
+    if (kernel == BitboardKernelIncremental)  return("Delta");
+    else if (kernel == BitboardKernelAVX2)  return("AVX2");
+    else if (kernel == BitboardKernelSSE2)  return("SSE2");
+
+    return("Scalar");
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::LoadPieceData(Uint8 pieceData[8][5][17])
+{
+    for (int piece = 0; piece < 8; piece++)
+        for (int rotation = 0; rotation < 5; rotation++)
+        {
+            Uint8 box = 1;
+            for (int y = 0; y < 4; y++)
+            {
+                PieceRows[piece][rotation][y] = 0;
+                for (int x = 0; x < 4; x++)
+                {
+                    if (pieceData[piece][rotation][box] > 0)  PieceRows[piece][rotation][y] |= (1 << x);
+
+                    box++;
+                }
+            }
+        }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::LoadPlayfield(int playfield[15][26])
+{
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        Box[y] = 0;
+        Wall[y] = 0;
+        Empty[y] = 0;
+
+        for (int x = 0; x < 15; x++)
+        {
+            if (playfield[x][y] > 10 && playfield[x][y] < 20)  Box[y] |= (1 << x);
+            else if (playfield[x][y] == 255)  Wall[y] |= (1 << x);
+            else if (playfield[x][y] == 0)  Empty[y] |= (1 << x);
+        }
+    }
+
+    BoxesChanged();
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Bitboard::LoadPlayfieldIfChanged(int playfield[15][26])
+{
+Uint16 box[BitboardRows];
+Uint16 wall[BitboardRows];
+Uint16 empty[BitboardRows];
+bool changed = false;
+
+    /* Every row is compared, the spawn gate and floor included, so the caches can never outlive the board they were made for */
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        box[y] = 0;
+        wall[y] = 0;
+        empty[y] = 0;
+
+        for (int x = 0; x < 15; x++)
+        {
+            if (playfield[x][y] > 10 && playfield[x][y] < 20)  box[y] |= (1 << x);
+            else if (playfield[x][y] == 255)  wall[y] |= (1 << x);
+            else if (playfield[x][y] == 0)  empty[y] |= (1 << x);
+        }
+
+        if (box[y] != Box[y] || wall[y] != Wall[y] || empty[y] != Empty[y])  changed = true;
+    }
+
+    if (changed == false)  return(false);
+
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        Box[y] = box[y];
+        Wall[y] = wall[y];
+        Empty[y] = empty[y];
+    }
+
+    BoxesChanged();
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::BoxesChanged(void)
+{
+    FeaturesValid = false;
+    ScoredValid = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::CopyPlayfield(Bitboard *board)
+{
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        Box[y] = board->Box[y];
+        Wall[y] = board->Wall[y];
+        Empty[y] = board->Empty[y];
+    }
+
+    BoxesChanged();
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::LoadPlacement(Bitboard *board, Uint8 piece, int move)
+{
+    CopyPlayfield(board);
+
+    for (int row = 0; row < 4; row++)
+    {
+        int y = board->MoveLandedY[move] + row;
+        Uint16 pieceRow = ( PieceRows[piece][ board->MoveRotation[move] ][row] << board->MoveX[move] );
+
+        if (y >= BitboardRows)  break;
+
+        Box[y] |= pieceRow;
+        Empty[y] &= ~pieceRow;
+    }
+
+    /* Completed lines drop the rows above them, as in Logic::ClearCompletedLines() */
+    for (int y = 5; y < 24; y++)
+    {
+        if ( (Box[y] & ColumnsTwoToEleven) != ColumnsTwoToEleven )  continue;
+
+        for (int yTwo = y; yTwo > 5; yTwo--)
+        {
+            Box[yTwo] = Box[yTwo-1];
+            Empty[yTwo] = Empty[yTwo-1];
+        }
+
+        Box[5] = 0;
+        Empty[5] = ColumnsTwoToEleven;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::ComputeBoardFeatures(void)
+{
+    BoardTrappedHoles = 0;
+    BoardCompletedLines = 0;
+    BoardBoxEdges = 0;
+    BoardOneBlockCavernHoles = 0;
+
+    for (int y = 0; y < BitboardRows; y++)
+    {
+        RowBoxEdges[y] = 0;
+        RowOneBlockCavernHoles[y] = 0;
+        RowCompleted[y] = 0;
+    }
+
+    for (int y = 5; y < 25; y++)
+    {
+        RowBoxEdges[y] = CountBoxEdges(Box[y], Wall[y], Empty[y-1], Empty[y], Empty[y+1]);
+        RowCompleted[y] = CountCompletedLine(Box[y]);
+        if (y < 24)  RowOneBlockCavernHoles[y] = CountOneBlockCavernHoles(Empty[y]);
+
+        BoardBoxEdges += RowBoxEdges[y];
+        BoardCompletedLines += RowCompleted[y];
+        BoardOneBlockCavernHoles += RowOneBlockCavernHoles[y];
+    }
+
+    for (int x = 0; x < 15; x++)
+    {
+        ColumnTop[x] = 24;
+        ColumnTrappedHoles[x] = 0;
+        for (int y = 0; y < BitboardRows; y++)  ColumnEmptiesBelow[x][y] = 0;
+
+        if (x < 2 || x > 11)  continue;
+
+        for (int y = 23; y > 4; y--)
+        {
+            ColumnEmptiesBelow[x][y-1] = ColumnEmptiesBelow[x][y] + ( (Empty[y] >> x) & 1 );
+            if ( (Box[y] >> x) & 1 )  ColumnTop[x] = y;
+        }
+
+        if (ColumnTop[x] < 24)  ColumnTrappedHoles[x] = ColumnEmptiesBelow[x][ ColumnTop[x] ];
+        BoardTrappedHoles += ColumnTrappedHoles[x];
+    }
+
+    FeaturesValid = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::ScoreMoveIncremental(int move, Uint8 piece, int landedY)
+{
+Uint16 pieceRow[4];
+Uint16 newBox[BitboardRows];
+Uint16 newEmpty[BitboardRows];
+int firstRow, lastRow;
+
+    /* A placement only touches its own four rows (plus one above and below for edges) and columns */
+    for (int row = 0; row < 4; row++)  pieceRow[row] = ( PieceRows[piece][ MoveRotation[move] ][row] << MoveX[move] );
+
+    firstRow = landedY-1;
+    if (firstRow < 4)  firstRow = 4;
+    lastRow = landedY+4;
+    if (lastRow > 25)  lastRow = 25;
+
+    for (int y = firstRow; y <= lastRow; y++)
+    {
+        Uint16 placed = ( (y >= landedY && y < landedY+4) ? pieceRow[y-landedY] : 0 );
+
+        newBox[y] = Box[y] | placed;
+        newEmpty[y] = Empty[y] & ~placed;
+    }
+
+    int boxEdges = BoardBoxEdges;
+    int cavernHoles = BoardOneBlockCavernHoles;
+    int completedLines = BoardCompletedLines;
+    for (int y = firstRow; y <= lastRow; y++)
+    {
+        if (y < 5 || y > 24)  continue;
+
+        Uint16 emptyAbove = (y-1 >= firstRow ? newEmpty[y-1] : Empty[y-1]);
+        Uint16 emptyBelow = (y+1 <= lastRow ? newEmpty[y+1] : Empty[y+1]);
+        boxEdges += CountBoxEdges(newBox[y], Wall[y], emptyAbove, newEmpty[y], emptyBelow) - RowBoxEdges[y];
+
+        if (y < landedY || y >= landedY+4)  continue;
+
+        completedLines += CountCompletedLine(newBox[y]) - RowCompleted[y];
+        if (y < 24)  cavernHoles += CountOneBlockCavernHoles(newEmpty[y]) - RowOneBlockCavernHoles[y];
+    }
+
+    int trappedHoles = BoardTrappedHoles;
+    for (int x = MoveX[move]; x < MoveX[move]+4; x++)
+    {
+        if (x < 2 || x > 11)  continue;
+
+        int top = ColumnTop[x];
+        int pieceBoxes[4];
+        int pieceBoxCount = 0;
+
+        for (int row = 0; row < 4; row++)
+        {
+            int y = landedY+row;
+            if ( ( (pieceRow[row] >> x) & 1 ) == 0 || y < 5 || y > 23 )  continue;
+
+            pieceBoxes[pieceBoxCount] = y;
+            pieceBoxCount++;
+            if (y < top)  top = y;
+        }
+
+        if (pieceBoxCount == 0)  continue;
+
+        int newTrappedHoles = ColumnEmptiesBelow[x][top];
+        for (int index = 0; index < pieceBoxCount; index++)
+        {
+            if (pieceBoxes[index] > top)  newTrappedHoles--;
+        }
+
+        trappedHoles += newTrappedHoles - ColumnTrappedHoles[x];
+    }
+
+    MoveTrappedHoles[move] = trappedHoles;
+    MoveCompletedLines[move] = completedLines;
+    MoveBoxEdges[move] = boxEdges;
+    MoveOneBlockCavernHoles[move] = cavernHoles;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Bitboard::PieceCollision(Uint8 piece, Uint8 rotation, int x, int y)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        if ( ( (Box[y+row] | Wall[y+row]) & (PieceRows[piece][rotation][row] << x) ) != 0 )  return(true);
+    }
+
+    return(false);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Bitboard::GenerateMoves(Uint8 piece, Uint8 maxRotation, int startX, int endX, int startY)
+{
+int lanes = 0;
+
+    /* Every column and rotation, the ones that fit at startY get a lane with where they come to rest */
+    ScoredValid = false;
+    MovesCount = 0;
+    for (int pieceTestX = (startX-2); pieceTestX < (endX-1); pieceTestX+=1)
+    {
+        for (int rotationTest = 1; rotationTest <= maxRotation; rotationTest+=1)
+        {
+            int move = MovesCount;
+            MovesCount++;
+
+            MoveX[move] = pieceTestX;
+            MoveRotation[move] = rotationTest;
+            MoveHeight[move] = 0;
+            MoveLandedY[move] = 0;
+            MoveTrappedHoles[move] = 0;
+            MoveCompletedLines[move] = 0;
+            MoveBoxEdges[move] = 0;
+            MoveOneBlockCavernHoles[move] = 0;
+
+            MoveCollision[move] = PieceCollision(piece, rotationTest, pieceTestX, startY);
+            if (MoveCollision[move] == false)
+            {
+                MoveLandedY[move] = 22;
+                for (int posY = startY; posY < 23; posY+=1)
+                {
+                    if ( PieceCollision(piece, rotationTest, pieceTestX, posY) )
+                    {
+                        MoveLandedY[move] = posY-1;
+                        MoveHeight[move] = MoveLandedY[move];
+                        break;
+                    }
+                }
+
+                LaneMove[lanes] = move;
+                lanes++;
+            }
+        }
+    }
+
+    return(lanes);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Bitboard::ScoreAllMoves(Uint8 piece, Uint8 maxRotation, int startX, int endX, int startY)
+{
+int lanes;
+int landedY[BitboardMaxMoves];
+
+    /* Same board and arguments as last time, whichever kernel scored them */
+    if ( ScoredValid == true && ScoredPiece == piece && ScoredMaxRotation == maxRotation
+      && ScoredStartX == startX && ScoredEndX == endX && ScoredStartY == startY )  return;
+
+    lanes = GenerateMoves(piece, maxRotation, startX, endX, startY);
+
+    ScoredValid = true;
+    ScoredPiece = piece;
+    ScoredMaxRotation = maxRotation;
+    ScoredStartX = startX;
+    ScoredEndX = endX;
+    ScoredStartY = startY;
+
+    for (int lane = 0; lane < lanes; lane++)  landedY[lane] = MoveLandedY[ LaneMove[lane] ];
+
+    if (Kernel == BitboardKernelIncremental)
+    {
+        if (FeaturesValid == false)  ComputeBoardFeatures();
+
+        for (int lane = 0; lane < lanes; lane++)  ScoreMoveIncremental(LaneMove[lane], piece, landedY[lane]);
+
+        return;
+    }
+
+    int paddedLanes = ( (lanes + 15) & ~15 );
+
+    for (int row = 0; row < BitboardLaneRows; row++)
+    {
+        for (int lane = 0; lane < paddedLanes; lane++)
+        {
+            LaneBox[row][lane] = Box[row+4];
+            LaneEmpty[row][lane] = Empty[row+4];
+        }
+    }
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        int move = LaneMove[lane];
+
+        for (int row = 0; row < 4; row++)
+        {
+            int laneRow = landedY[lane] + row - 4;
+            Uint16 pieceRow = ( PieceRows[piece][ MoveRotation[move] ][row] << MoveX[move] );
+
+            if (laneRow < 0 || laneRow >= BitboardLaneRows)  continue;
+
+            LaneBox[laneRow][lane] |= pieceRow;
+            LaneEmpty[laneRow][lane] &= ~pieceRow;
+        }
+    }
+
+    Uint16 trapped[BitboardMaxMoves];
+    Uint16 lines[BitboardMaxMoves];
+    Uint16 edges[BitboardMaxMoves];
+    Uint16 caverns[BitboardMaxMoves];
+
+#ifdef BITBOARD_X86
+    if (Kernel == BitboardKernelAVX2)
+        ScoreLanesAVX2(LaneBox, LaneEmpty, Wall, paddedLanes, trapped, lines, edges, caverns);
+    else if (Kernel == BitboardKernelSSE2)
+        ScoreLanesSSE2(LaneBox, LaneEmpty, Wall, paddedLanes, trapped, lines, edges, caverns);
+    else
+#endif
+        ScoreLanesScalar(LaneBox, LaneEmpty, Wall, lanes, trapped, lines, edges, caverns);
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        int move = LaneMove[lane];
+
+        MoveTrappedHoles[move] = trapped[lane];
+        MoveCompletedLines[move] = lines[lane];
+        MoveBoxEdges[move] = edges[lane];
+        MoveOneBlockCavernHoles[move] = caverns[lane];
+    }
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BITBOARD
+#define BITBOARD
+
+/* Playfield as one 16-bit mask per row (bit X = column X) for the computer player A.I. */
+class Bitboard
+{
+public:
+
+    #define BitboardRows                26
+    #define BitboardLaneRows            22  /* Rows 4 to 25, the only rows the A.I. features look at */
+    #define BitboardMaxMoves            48  /* 11 columns * 4 rotations, padded to 16 lanes */
+
+    #define BitboardKernelScalar        0
+    #define BitboardKernelSSE2          1
+    #define BitboardKernelAVX2          2
+    #define BitboardKernelIncremental   3
+    int Kernel;
+
+    Uint16 Box[BitboardRows];
+    Uint16 Wall[BitboardRows];
+    Uint16 Empty[BitboardRows];
+
+    Uint16 PieceRows[8][5][4];
+
+    /* Both caches drop whenever the rows change, code that edits Box directly calls BoxesChanged() */
+    bool FeaturesValid;
+    bool ScoredValid;  /* Move arrays hold ScoreAllMoves() for these arguments */
+    Uint8 ScoredPiece;
+    Uint8 ScoredMaxRotation;
+    int ScoredStartX;
+    int ScoredEndX;
+    int ScoredStartY;
+    int BoardTrappedHoles;
+    int BoardCompletedLines;
+    int BoardBoxEdges;
+    int BoardOneBlockCavernHoles;
+    Uint8 RowBoxEdges[BitboardRows];
+    Uint8 RowOneBlockCavernHoles[BitboardRows];
+    Uint8 RowCompleted[BitboardRows];
+    int ColumnTop[15];
+    Uint8 ColumnTrappedHoles[15];
+    Uint8 ColumnEmptiesBelow[15][BitboardRows];
+
+    int MovesCount;
+    int MoveX[BitboardMaxMoves];
+    int MoveRotation[BitboardMaxMoves];
+    bool MoveCollision[BitboardMaxMoves];
+    int MoveHeight[BitboardMaxMoves];
+    int MoveLandedY[BitboardMaxMoves];
+    Uint16 MoveTrappedHoles[BitboardMaxMoves];
+    Uint16 MoveCompletedLines[BitboardMaxMoves];
+    Uint16 MoveBoxEdges[BitboardMaxMoves];
+    Uint16 MoveOneBlockCavernHoles[BitboardMaxMoves];
+
+    Uint16 LaneBox[BitboardLaneRows][BitboardMaxMoves];
+    Uint16 LaneEmpty[BitboardLaneRows][BitboardMaxMoves];
+    int LaneMove[BitboardMaxMoves];
+
+	Bitboard(void);
+	virtual ~Bitboard(void);
+
+    int BestKernel(void);
+    const char *KernelName(int kernel);
+
+    void LoadPieceData(Uint8 pieceData[8][5][17]);
+    void LoadPlayfield(int playfield[15][26]);
+    bool LoadPlayfieldIfChanged(int playfield[15][26]);
+    void BoxesChanged(void);
+    void CopyPlayfield(Bitboard *board);
+    void LoadPlacement(Bitboard *board, Uint8 piece, int move);
+
+    void ComputeBoardFeatures(void);
+    void ScoreMoveIncremental(int move, Uint8 piece, int landedY);
+
+    bool PieceCollision(Uint8 piece, Uint8 rotation, int x, int y);
+
+    int GenerateMoves(Uint8 piece, Uint8 maxRotation, int startX, int endX, int startY);
+    void ScoreAllMoves(Uint8 piece, Uint8 maxRotation, int startX, int endX, int startY);
+};
+
+#endif
@@ -0,0 +1,331 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "transposition.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
+#include "logic.h"
+#include "input.h"
+#include "screens.h"
+
+#include "differential.h"
+
+extern Input* input;
+extern Screens* screens;
+
+//-------------------------------------------------------------------------------------------------
+Differential::Differential(void)
+{
+    Reference = new Logic();
+    Reference->ReferenceEngine = true;
+
+    Optimized = new Logic();
+
+    RandomState = DifferentialSeed;
+    Inputs = NULL;
+    MaxTicks = 0;
+
+    Ticks = 0;
+    Mismatches = 0;
+    Reports = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Differential::~Differential(void)
+{
+    delete [] Inputs;
+
+    delete Optimized;
+    delete Reference;
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Differential::NextRandom(void)
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+
+    return(RandomState);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Differential::SetupEngine(Logic *engine, int gameMode, Uint32 seed)
+{
+    engine->GameMode = gameMode;
+    engine->CPUPlayerEnabled = DifferentialSkill;
+    engine->RandomState = seed;
+    engine->AITransposition->Clear();
+    engine->SetupForNewGame();
+    engine->PlayersCanJoin = false;
+
+    /* Deeper searches choose differently by design, at depth 1 the optimized A.I. must agree with the original one */
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        engine->PlayerData[player].AIEvaluator = SearchGiftOfSight;
+        engine->PlayerData[player].AIMaxDepth = 1;
+        engine->PlayerData[player].AIMoveBudget = 0;
+        engine->PlayerData[player].AIRollouts = false;
+        engine->AISearch[player]->NodeBudget = true;
+    }
+
+    engine->PlayerData[DifferentialHumanPlayer].PlayerInput = JoystickOne;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Differential::ApplyInput(Uint8 keys)
+{
+    /* Both engines read the same global Input, exactly as a joystick player would drive them */
+    if (keys & DifferentialInputLeft)  input->JoystickDirectionHorizontal[JoystickOne] = LEFT;
+    else if (keys & DifferentialInputRight)  input->JoystickDirectionHorizontal[JoystickOne] = RIGHT;
+    else  input->JoystickDirectionHorizontal[JoystickOne] = CENTER;
+
+    if (keys & DifferentialInputUp)  input->JoystickDirectionVertical[JoystickOne] = UP;
+    else if (keys & DifferentialInputDown)  input->JoystickDirectionVertical[JoystickOne] = DOWN;
+    else  input->JoystickDirectionVertical[JoystickOne] = CENTER;
+
+    input->JoystickButtonOne[JoystickOne] = ( (keys & DifferentialInputButtonOne) ? ON : OFF );
+    input->JoystickButtonTwo[JoystickOne] = ( (keys & DifferentialInputButtonTwo) ? ON : OFF );
+}
+
+//-------------------------------------------------------------------------------------------------
+void Differential::RestartLostPlayers(Logic *engine)
+{
+    for (engine->Player = 0; engine->Player < NumberOfPlayers; engine->Player++)
+    {
+        if (engine->PlayerData[engine->Player].PlayerStatus == GameOver)  engine->RestartComputerSkillTestPlayer();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Differential::Same(const char *field, int player, Sint64 reference, Sint64 optimized, Uint32 tick)
+{
+    if (reference == optimized)  return(true);
+
+    if (Reports < DifferentialMaxReports)
+    {
+        printf("*****ERROR: Tick %u, player %i %s: reference %lld, optimized %lld*****\n", tick, player + 1, field
+               , (long long)reference, (long long)optimized);
+    }
+    Reports++;
+
+    return(false);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Differential::CompareEngines(Uint32 tick)
+{
+bool same = true;
+
+    same &= Same("random state", -1, Reference->RandomState, Optimized->RandomState, tick);
+    same &= Same("Crisis mode timer", -1, Reference->CrisisModeTimer, Optimized->CrisisModeTimer, tick);
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        Logic::PlayData *reference = &Reference->PlayerData[player];
+        Logic::PlayData *optimized = &Optimized->PlayerData[player];
+
+        if ( memcmp(reference->Playfield, optimized->Playfield, sizeof(reference->Playfield)) != 0 )
+        {
+            for (int y = 0; y < 26; y++)
+                for (int x = 0; x < 15; x++)
+                {
+                    if (reference->Playfield[x][y] == optimized->Playfield[x][y])  continue;
+
+                    char field[32];
+                    snprintf(field, sizeof(field), "playfield[%i][%i]", x, y);
+                    same &= Same(field, player, reference->Playfield[x][y], optimized->Playfield[x][y], tick);
+                }
+        }
+
+        if ( memcmp(reference->AttackLines, optimized->AttackLines, sizeof(reference->AttackLines)) != 0 )
+        {
+            for (int y = 0; y < 12; y++)
+                for (int x = 0; x < 10; x++)
+                {
+                    if (reference->AttackLines[x][y] == optimized->AttackLines[x][y])  continue;
+
+                    char field[32];
+                    snprintf(field, sizeof(field), "attack line[%i][%i]", x, y);
+                    same &= Same(field, player, reference->AttackLines[x][y], optimized->AttackLines[x][y], tick);
+                }
+        }
+
+        same &= Same("status", player, reference->PlayerStatus, optimized->PlayerStatus, tick);
+        same &= Same("piece", player, reference->Piece, optimized->Piece, tick);
+        same &= Same("next piece", player, reference->NextPiece, optimized->NextPiece, tick);
+        same &= Same("piece bag index", player, reference->PieceBagIndex, optimized->PieceBagIndex, tick);
+        same &= Same("piece X", player, reference->PiecePlayfieldX, optimized->PiecePlayfieldX, tick);
+        same &= Same("piece Y", player, reference->PiecePlayfieldY, optimized->PiecePlayfieldY, tick);
+        same &= Same("piece rotation", player, reference->PieceRotation, optimized->PieceRotation, tick);
+        same &= Same("movement delay", player, reference->PieceMovementDelay, optimized->PieceMovementDelay, tick);
+        same &= Same("drop timer", player, reference->PieceDropTimer, optimized->PieceDropTimer, tick);
+        same &= Same("time to drop", player, reference->TimeToDropPiece, optimized->TimeToDropPiece, tick);
+        same &= Same("score", player, (Sint64)reference->Score, (Sint64)optimized->Score, tick);
+        same &= Same("drop bonus", player, reference->DropBonus, optimized->DropBonus, tick);
+        same &= Same("level", player, reference->Level, optimized->Level, tick);
+        same &= Same("lines", player, reference->Lines, optimized->Lines, tick);
+        same &= Same("playfield hash", player, (Sint64)reference->PlayfieldHash, (Sint64)optimized->PlayfieldHash, tick);
+
+        if (reference->PlayerInput == CPU)
+        {
+            same &= Same("best move X", player, reference->BestMoveX, optimized->BestMoveX, tick);
+            same &= Same("best rotation", player, reference->BestRotation, optimized->BestRotation, tick);
+        }
+    }
+
+    if (same == false)  Mismatches++;
+    return(same);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Differential::PlayGame(int gameMode, Uint32 seed, Uint32 ticks, const Uint8 *replay)
+{
+Uint8 keys = 0;
+
+    if (ticks > MaxTicks)
+    {
+        delete [] Inputs;
+        Inputs = new Uint8[ticks];
+        MaxTicks = ticks;
+    }
+
+    SetupEngine(Reference, gameMode, seed);
+    SetupEngine(Optimized, gameMode, seed);
+
+    if (CompareEngines(0) == false)  return(false);
+
+    for (Uint32 tick = 0; tick < ticks; tick++)
+    {
+        if (replay != NULL)  keys = replay[tick];
+        else if ( (NextRandom() % DifferentialInputHoldTicks) == 0 )  keys = (Uint8)(NextRandom() & 63);
+
+        Inputs[tick] = keys;
+        ApplyInput(keys);
+
+        Reference->RunTetriGameEngine();
+        Optimized->RunTetriGameEngine();
+
+        RestartLostPlayers(Reference);
+        RestartLostPlayers(Optimized);
+
+        Ticks++;
+
+        if (CompareEngines(tick + 1) == false)
+        {
+            if (replay == NULL)  SaveInputs(gameMode, seed, tick + 1);
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Differential::SaveInputs(int gameMode, Uint32 seed, Uint32 ticks)
+{
+FILE *file;
+Uint32 header[4] = { DifferentialMagic, (Uint32)gameMode, seed, ticks };
+
+    file = fopen(DifferentialFailureFile, "wb");
+    if (file == NULL)
+    {
+        printf("*****ERROR: Could not save the failing inputs to \"%s\"*****\n", DifferentialFailureFile);
+        return;
+    }
+
+    fwrite(header, sizeof(header), 1, file);
+    fwrite(Inputs, 1, ticks, file);
+    fclose(file);
+
+    printf("  Inputs up to the first difference saved, replay them with \"--differential 1 %u %s\"\n", ticks, DifferentialFailureFile);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Differential::Replay(const char *filename)
+{
+FILE *file;
+Uint32 header[4];
+Uint8 *replay;
+bool passed;
+
+    file = fopen(filename, "rb");
+    if (file == NULL || fread(header, sizeof(header), 1, file) != 1 || header[0] != DifferentialMagic)
+    {
+        printf("*****ERROR: \"%s\" is not a differential test input file*****\n", filename);
+        if (file != NULL)  fclose(file);
+        return(false);
+    }
+
+    replay = new Uint8[ header[3] ];
+    header[3] = (Uint32)fread(replay, 1, header[3], file);
+    fclose(file);
+
+    printf("Differential test replay: \"%s\", %s game, seed %u, %u ticks\n", filename
+           , (header[1] == CrisisMode ? "Crisis mode" : "original mode"), header[2], header[3]);
+
+    passed = PlayGame( (int)header[1], header[2], header[3], replay );
+    if (passed == true)  printf("  Both engines agree on every tick.\n");
+
+    delete [] replay;
+    return(passed);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Differential::Run(int games, Uint32 ticks, const char *replayFilename)
+{
+Uint64 startTicks;
+double seconds;
+int game;
+
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+
+    if (replayFilename != NULL)  return( Replay(replayFilename) );
+
+    if (games < 1)  games = 1;
+
+    printf("Differential test: %i games of %u ticks, cell-by-cell reference engine vs bitboard engine, random input for player %i\n"
+           , games, ticks, DifferentialHumanPlayer + 1);
+
+    startTicks = SDL_GetPerformanceCounter();
+    for (game = 0; game < games; game++)
+    {
+        /* Crisis mode every other game, for its attack and incomplete lines */
+        Uint32 seed = ( (DifferentialSeed + (Uint32)game) * 2654435761U ) | 1;
+
+        if (PlayGame( (game % 2 == 0 ? CrisisMode : OriginalMode), seed, ticks, NULL ) == false)  break;
+    }
+    seconds = ( (double)(SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency() );
+
+    printf("  %llu ticks in %.1f s (%.0f ticks per minute)\n", (unsigned long long)Ticks, seconds, (Ticks * 60.0) / seconds);
+
+    if (Mismatches > 0)  printf("*****ERROR: The engines disagree in game %i*****\n", game + 1);
+    else  printf("  Both engines agree on every tick.\n");
+
+    return(Mismatches == 0);
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef DIFFERENTIAL
+#define DIFFERENTIAL
+
+class Logic;
+
+/* Lockstep test of two game engines on the same inputs: "tc4-tribute3 --differential [games] [ticks] [replay file]" */
+/* Reference plays with Logic::ReferenceEngine, Optimized is the engine being checked, full state is compared every tick */
+class Differential
+{
+public:
+
+    #define DifferentialSkill           3
+    #define DifferentialSeed            0xD1FF
+    #define DifferentialHumanPlayer     0       /* Plays from random or replayed joystick input, the other seats are C.P.U. players */
+    #define DifferentialInputHoldTicks  6       /* Random input is held about this long, so auto shift and drops happen */
+    #define DifferentialMaxReports      8
+    #define DifferentialFailureFile     "Differential-Failure.bin"
+    #define DifferentialMagic           0x44344354  /* "TC4D" */
+
+    #define DifferentialInputLeft       1
+    #define DifferentialInputRight      2
+    #define DifferentialInputUp         4
+    #define DifferentialInputDown       8
+    #define DifferentialInputButtonOne  16
+    #define DifferentialInputButtonTwo  32
+
+    Logic *Reference;
+    Logic *Optimized;
+
+    Uint32 RandomState;
+    Uint8 *Inputs;  /* Every tick of the game being played, saved when the engines disagree */
+    Uint32 MaxTicks;
+
+    Uint64 Ticks;
+    Uint32 Mismatches;
+    Uint32 Reports;
+
+	Differential(void);
+	virtual ~Differential(void);
+
+    Uint32 NextRandom(void);
+
+    void SetupEngine(Logic *engine, int gameMode, Uint32 seed);
+    void ApplyInput(Uint8 keys);
+    void RestartLostPlayers(Logic *engine);
+
+    bool Same(const char *field, int player, Sint64 reference, Sint64 optimized, Uint32 tick);
+    bool CompareEngines(Uint32 tick);
+
+    bool PlayGame(int gameMode, Uint32 seed, Uint32 ticks, const Uint8 *replay);
+    void SaveInputs(int gameMode, Uint32 seed, Uint32 ticks);
+    bool Replay(const char *filename);
+
+    bool Run(int games, Uint32 ticks, const char *replayFilename);
+};
+
+#endif
@@ -0,0 +1,475 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "environment.h"
+#include "logic.h"
+
+#define ColumnsTwoToEleven      0x0FFC
+
+//-------------------------------------------------------------------------------------------------
+Environment::Environment(int games)
+{
+int playfield[15][26];
+
+    if (games < 1)  games = 1;
+    Games = games;
+
+    Box = new Uint16[Games][BitboardRows];
+    Piece = new Uint8[Games];
+    NextPiece = new Uint8[Games];
+    Bag = new Uint8[Games][7];
+    BagIndex = new Uint8[Games];
+    Garbage = new Uint8[Games];
+    Random = new Uint32[Games];
+    Lines = new Uint32[Games];
+    Pieces = new Uint32[Games];
+
+    /* The walls of Logic::RestartComputerSkillTestPlayer()'s empty playfield */
+    for (int y = 0; y < 26; y++)
+        for (int x = 0; x < 15; x++)
+        {
+            if (y >= 5 && y < 24 && x >= 2 && x < 12)  playfield[x][y] = 0;
+            else if (y >= 2 && y < 5 && x >= 5 && x < 9)  playfield[x][y] = 0;
+            else  playfield[x][y] = 255;
+        }
+
+    Rules = new Bitboard();
+    Rules->LoadPlayfield(playfield);
+
+    for (int piece = 0; piece < 8; piece++)
+    {
+        MaxRotation[piece] = 0;
+        StartY[piece] = 0;
+    }
+
+    Reset(0);
+
+    Lock = SDL_CreateMutex();
+    WorkReady = SDL_CreateCond();
+    WorkDone = SDL_CreateCond();
+
+    for (int worker = 0; worker < EnvironmentMaxThreads; worker++)  Worker[worker] = NULL;
+
+    Job = EnvironmentJobStep;
+    JobActions = NULL;
+    JobRewards = NULL;
+    JobDones = NULL;
+    JobBuffer = NULL;
+
+    Threads = 1;
+    if ( (Games / EnvironmentGamesPerThread) < SDL_GetCPUCount() )  StartThreads(Games / EnvironmentGamesPerThread);
+    else  StartThreads( SDL_GetCPUCount() );
+}
+
+//-------------------------------------------------------------------------------------------------
+Environment::~Environment(void)
+{
+    StopThreads();
+
+    SDL_DestroyCond(WorkDone);
+    SDL_DestroyCond(WorkReady);
+    SDL_DestroyMutex(Lock);
+
+    delete Rules;
+
+    delete [] Pieces;
+    delete [] Lines;
+    delete [] Random;
+    delete [] Garbage;
+    delete [] BagIndex;
+    delete [] Bag;
+    delete [] NextPiece;
+    delete [] Piece;
+    delete [] Box;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::StartThreads(int threads)
+{
+    if (threads < 1)  threads = 1;
+    else if (threads > EnvironmentMaxThreads)  threads = EnvironmentMaxThreads;
+
+    Threads = threads;
+    Batch = 0;
+    WorkersBusy = 0;
+    Quit = false;
+
+    SDL_AtomicSet(&WorkerIndex, 1);
+    for (int worker = 1; worker < Threads; worker++)  Worker[worker] = SDL_CreateThread(WorkerThread, "Environment", this);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::StopThreads(void)
+{
+    SDL_LockMutex(Lock);
+    Quit = true;
+    SDL_CondBroadcast(WorkReady);
+    SDL_UnlockMutex(Lock);
+
+    for (int worker = 1; worker < Threads; worker++)
+    {
+        SDL_WaitThread(Worker[worker], NULL);
+        Worker[worker] = NULL;
+    }
+
+    Threads = 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+int Environment::WorkerThread(void *data)
+{
+Environment *environment = (Environment*)data;
+int worker = SDL_AtomicAdd(&environment->WorkerIndex, 1);
+Uint32 batch = 0;
+
+    SDL_LockMutex(environment->Lock);
+
+    while (true)
+    {
+        while (environment->Quit == false && environment->Batch == batch)  SDL_CondWait(environment->WorkReady, environment->Lock);
+        if (environment->Quit == true)  break;
+
+        batch = environment->Batch;
+        SDL_UnlockMutex(environment->Lock);
+
+        environment->RunJob(worker);
+
+        SDL_LockMutex(environment->Lock);
+        environment->WorkersBusy--;
+        if (environment->WorkersBusy == 0)  SDL_CondSignal(environment->WorkDone);
+    }
+
+    SDL_UnlockMutex(environment->Lock);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::RunJob(int worker)
+{
+int first = (int)( ( (Sint64)Games * worker ) / Threads );
+int last = (int)( ( (Sint64)Games * (worker+1) ) / Threads );
+
+    if (Job == EnvironmentJobStep)  StepGames(first, last, JobActions, JobRewards, JobDones);
+    else  ObserveGames(first, last, JobBuffer);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::Run(int job)
+{
+    Job = job;
+
+    /* Every game only touches its own state and random numbers, so the thread count never changes the results */
+    if (Threads > 1)
+    {
+        SDL_LockMutex(Lock);
+        Batch++;
+        WorkersBusy = (Threads - 1);
+        SDL_CondBroadcast(WorkReady);
+        SDL_UnlockMutex(Lock);
+    }
+
+    RunJob(0);
+
+    if (Threads > 1)
+    {
+        SDL_LockMutex(Lock);
+        while (WorkersBusy > 0)  SDL_CondWait(WorkDone, Lock);
+        SDL_UnlockMutex(Lock);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8], Uint8 dropStartHeight[8])
+{
+    Rules->LoadPieceData(pieceData);
+
+    for (int piece = 0; piece < 8; piece++)
+    {
+        MaxRotation[piece] = maxRotation[piece];
+        StartY[piece] = dropStartHeight[piece];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Environment::NextRandom(int game)
+{
+Uint32 random = Random[game];
+
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+
+    Random[game] = random;
+    return(random);
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint8 Environment::DrawPiece(int game)
+{
+    if (BagIndex[game] == 7)
+    {
+        for (int index = 0; index < 7; index++)  Bag[game][index] = (index + 1);
+
+        for (int index = 6; index > 0; index--)
+        {
+            int swap = ( NextRandom(game) % (index+1) );
+            Uint8 temp = Bag[game][index];
+            Bag[game][index] = Bag[game][swap];
+            Bag[game][swap] = temp;
+        }
+
+        BagIndex[game] = 0;
+    }
+
+    BagIndex[game]++;
+
+    return(Bag[game][ BagIndex[game]-1 ]);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Environment::Collision(int game, Uint8 piece, int rotation, int x, int y)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        /* Empty piece rows may hang below the floor, anything else would be outside the playfield */
+        if (y+row >= BitboardRows)
+        {
+            if (Rules->PieceRows[piece][rotation][row] != 0)  return(true);
+            continue;
+        }
+
+        if ( ( (Box[game][y+row] | Rules->Wall[y+row]) & (Rules->PieceRows[piece][rotation][row] << x) ) != 0 )  return(true);
+    }
+
+    return(false);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Environment::Legal(int game, int action)
+{
+Uint8 piece = Piece[game];
+int x = (action / 4);
+int rotation = ( (action % 4) + 1 );
+
+    /* Same placements the C.P.U. player considers, see Search::Start() */
+    if (action < 0 || action >= EnvironmentActions || rotation > MaxRotation[piece] || x < 1)  return(false);
+
+    return( Collision(game, piece, rotation, x, StartY[piece]) == false );
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::ResetGame(int game, Uint32 seed)
+{
+    for (int y = 0; y < BitboardRows; y++)  Box[game][y] = 0;
+
+    Random[game] = (seed != 0 ? seed : 0x16B17);
+    BagIndex[game] = 7;
+    Garbage[game] = 0;
+    Lines[game] = 0;
+    Pieces[game] = 0;
+
+    Piece[game] = DrawPiece(game);
+    NextPiece[game] = DrawPiece(game);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::Reset(Uint64 seed)
+{
+    for (int game = 0; game < Games; game++)
+    {
+        /* SplitMix64, so neighbouring games get unrelated pieces */
+        Uint64 key = seed + ( (Uint64)(game + 1) * 0x9E3779B97F4A7C15ULL );
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+        key = key ^ (key >> 31);
+
+        ResetGame( game, (Uint32)key );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::AddGarbageLine(int game)
+{
+Uint16 line = 0;
+int boxTotal = 0;
+
+    for (int row = 5; row < 23; row++)  Box[game][row] = Box[game][row+1];
+
+    /* Logic::AddAnIncompleteLineToPlayfieldCrisisMode(): each box 7 in 8, a line that would be complete loses its last box */
+    for (int x = 2; x < 12; x++)
+    {
+        Uint32 box = NextRandom(game) % 8;
+        if (box > 0)  boxTotal++;
+
+        if (boxTotal < 10 && box != 0)  line |= (1 << x);
+    }
+
+    Box[game][23] = line;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::StepGames(int first, int last, const int *actions, float *rewards, Uint8 *dones)
+{
+    for (int game = first; game < last; game++)
+    {
+        Uint16 *box = Box[game];
+        Uint8 piece = Piece[game];
+        int action = actions[game];
+        bool lost = false;
+        int lines = 0;
+
+        /* An illegal action loses, as does any action when the observation had no legal ones */
+        if (Legal(game, action) == false)  lost = true;
+        else
+        {
+            int x = (action / 4);
+            int rotation = ( (action % 4) + 1 );
+            int y = StartY[piece];
+
+            while (Collision(game, piece, rotation, x, y+1) == false)  y++;
+
+            for (int row = 0; row < 4; row++)  box[y+row] |= (Rules->PieceRows[piece][rotation][row] << x);
+
+            /* Completed lines drop the rows above them, as in Logic::ClearCompletedLines() */
+            for (int row = 5; row < 24; row++)
+            {
+                if ( (box[row] & ColumnsTwoToEleven) != ColumnsTwoToEleven )  continue;
+
+                for (int rowTwo = row; rowTwo > 5; rowTwo--)  box[rowTwo] = box[rowTwo-1];
+                box[5] = 0;
+
+                lines++;
+            }
+
+            /* Queued Crisis mode lines push the stack up once the piece is down, a box in the top row loses */
+            while (Garbage[game] > 0 && lost == false)
+            {
+                if ( (box[5] & ColumnsTwoToEleven) != 0 )  lost = true;
+                else
+                {
+                    AddGarbageLine(game);
+                    Garbage[game]--;
+                }
+            }
+
+            if ( (NextRandom(game) % EnvironmentAttackOneIn) == 0 && Garbage[game] < EnvironmentMaxGarbage )  Garbage[game]++;
+
+            Piece[game] = NextPiece[game];
+            NextPiece[game] = DrawPiece(game);
+
+            Lines[game]+=lines;
+            Pieces[game]++;
+        }
+
+        rewards[game] = (float)lines;
+        dones[game] = (lost == true ? 1 : 0);
+
+        /* A finished game starts over at once, so the batch always steps together */
+        if (lost == true)  ResetGame( game, NextRandom(game) );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::Step(const int *actions, float *rewards, Uint8 *dones)
+{
+    JobActions = actions;
+    JobRewards = rewards;
+    JobDones = dones;
+
+    Run(EnvironmentJobStep);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::ObserveGames(int first, int last, Uint16 *buffer)
+{
+    for (int game = first; game < last; game++)
+    {
+        Uint16 *observation = &buffer[game * EnvironmentObservationWords];
+        Uint64 legal = 0;
+
+        for (int row = 0; row < 20; row++)  observation[row] = ( (Box[game][row+4] & ColumnsTwoToEleven) >> 2 );
+
+        observation[20] = Piece[game];
+        observation[21] = NextPiece[game];
+        observation[22] = Garbage[game];
+
+        for (int action = 0; action < EnvironmentActions; action++)
+            if (Legal(game, action) == true)  legal |= ( (Uint64)1 << action );
+
+        observation[23] = (Uint16)legal;
+        observation[24] = (Uint16)(legal >> 16);
+        observation[25] = (Uint16)(legal >> 32);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Environment::Observe(Uint16 *buffer)
+{
+    JobBuffer = buffer;
+
+    Run(EnvironmentJobObserve);
+}
+
+//-------------------------------------------------------------------------------------------------
+void *tc4_env_create(int games)
+{
+Environment *environment = new Environment(games);
+Uint8 pieceData[8][5][17];
+Uint8 maxRotation[8];
+Uint8 dropStartHeight[8];
+
+    Logic::FillPieceTables(pieceData, maxRotation, dropStartHeight);
+    environment->LoadPieceData(pieceData, maxRotation, dropStartHeight);
+    environment->Reset(0);
+
+    return(environment);
+}
+
+//-------------------------------------------------------------------------------------------------
+void tc4_env_destroy(void *environment)
+{
+    delete (Environment*)environment;
+}
+
+//-------------------------------------------------------------------------------------------------
+void tc4_env_reset(void *environment, Uint64 seed)
+{
+    ( (Environment*)environment )->Reset(seed);
+}
+
+//-------------------------------------------------------------------------------------------------
+void tc4_env_step(void *environment, const int *actions, float *rewards, Uint8 *dones)
+{
+    ( (Environment*)environment )->Step(actions, rewards, dones);
+}
+
+//-------------------------------------------------------------------------------------------------
+void tc4_env_observe(void *environment, Uint16 *buffer)
+{
+    ( (Environment*)environment )->Observe(buffer);
+}
@@ -0,0 +1,110 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ENVIRONMENT
+#define ENVIRONMENT
+
+class Bitboard;
+
+/* Batch of independent headless games for reinforcement learning, one action is one piece placement */
+class Environment
+{
+public:
+
+    #define EnvironmentActions          44  /* Action = (X * 4) + (rotation - 1), X 0 to 10 like Bitboard::MoveX */
+    #define EnvironmentObservationWords 26  /* Per game: rows 4-23 (bit 0 = column 2), piece, next piece, queued garbage, 3 words of legal actions */
+    #define EnvironmentAttackOneIn      6   /* An attack line is queued about this often per piece, as in a Crisis mode game */
+    #define EnvironmentMaxGarbage       4
+    #define EnvironmentMaxThreads       16
+    #define EnvironmentGamesPerThread   256 /* Smaller batches step on the calling thread only */
+
+    #define EnvironmentJobStep          0
+    #define EnvironmentJobObserve       1
+
+    int Games;
+
+    /* Structure of arrays, game after game, so a step walks memory in order */
+    Uint16 (*Box)[BitboardRows];
+    Uint8 *Piece;
+    Uint8 *NextPiece;
+    Uint8 (*Bag)[7];
+    Uint8 *BagIndex;
+    Uint8 *Garbage;
+    Uint32 *Random;
+    Uint32 *Lines;
+    Uint32 *Pieces;
+
+    Bitboard *Rules;  /* Piece shapes and the walls of an empty playfield */
+    Uint8 MaxRotation[8];
+    Uint8 StartY[8];
+
+    /* Games are split evenly over the threads, worker 0 is whoever calls Step() or Observe() */
+    int Threads;
+    SDL_Thread *Worker[EnvironmentMaxThreads];
+    SDL_atomic_t WorkerIndex;
+    SDL_mutex *Lock;
+    SDL_cond *WorkReady;
+    SDL_cond *WorkDone;
+    Uint32 Batch;
+    int WorkersBusy;
+    bool Quit;
+
+    int Job;
+    const int *JobActions;
+    float *JobRewards;
+    Uint8 *JobDones;
+    Uint16 *JobBuffer;
+
+	Environment(int games);
+	virtual ~Environment(void);
+
+    void StartThreads(int threads);
+    void StopThreads(void);
+    static int WorkerThread(void *data);
+    void RunJob(int worker);
+    void Run(int job);
+
+    void LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8], Uint8 dropStartHeight[8]);
+
+    Uint32 NextRandom(int game);
+    Uint8 DrawPiece(int game);
+    bool Collision(int game, Uint8 piece, int rotation, int x, int y);
+    bool Legal(int game, int action);
+
+    void ResetGame(int game, Uint32 seed);
+    void Reset(Uint64 seed);
+    void AddGarbageLine(int game);
+    void StepGames(int first, int last, const int *actions, float *rewards, Uint8 *dones);
+    void Step(const int *actions, float *rewards, Uint8 *dones);
+    void ObserveGames(int first, int last, Uint16 *buffer);
+    void Observe(Uint16 *buffer);
+};
+
+/* C interface for training code, needs no Logic or window */
+extern "C"
+{
+    void *tc4_env_create(int games);
+    void tc4_env_destroy(void *environment);
+    void tc4_env_reset(void *environment, Uint64 seed);
+    void tc4_env_step(void *environment, const int *actions, float *rewards, Uint8 *dones);
+    void tc4_env_observe(void *environment, Uint16 *buffer);
+}
+
+#endif
@@ -0,0 +1,202 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "hint.h"
+#include "search.h"
+
+//-------------------------------------------------------------------------------------------------
+Hint::Hint(void)
+{
+    Board = new Bitboard();
+    HintSearch = new Search();
+    HintSearch->Evaluator = SearchGiftOfSight;
+    HintSearch->NodeBudget = false;
+
+    for (int player = 0; player < HintMaxPlayers; player++)
+    {
+        Pending[player] = false;
+        RequestKey[player] = 0;
+        AnswerKey[player] = 0;
+        AnswerX[player] = -1;
+        AnswerRotation[player] = -1;
+        AnswerY[player] = -1;
+    }
+
+    Lock = SDL_CreateMutex();
+    WorkReady = SDL_CreateCond();
+    Quit = false;
+
+    /* Started by the first request, games without hints never have the thread */
+    Worker = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+Hint::~Hint(void)
+{
+    SDL_LockMutex(Lock);
+    Quit = true;
+    SDL_CondSignal(WorkReady);
+    SDL_UnlockMutex(Lock);
+
+    if (Worker != NULL)  SDL_WaitThread(Worker, NULL);
+
+    SDL_DestroyCond(WorkReady);
+    SDL_DestroyMutex(Lock);
+
+    delete HintSearch;
+    delete Board;
+}
+
+//-------------------------------------------------------------------------------------------------
+int Hint::WorkerThread(void *data)
+{
+Hint *hint = (Hint*)data;
+int player;
+
+    SDL_LockMutex(hint->Lock);
+
+    while (true)
+    {
+        for (player = 0; player < HintMaxPlayers; player++)
+            if (hint->Pending[player] == true)  break;
+
+        if (hint->Quit == true)  break;
+
+        if (player == HintMaxPlayers)
+        {
+            SDL_CondWait(hint->WorkReady, hint->Lock);
+            continue;
+        }
+
+        hint->Solve(player);
+    }
+
+    SDL_UnlockMutex(hint->Lock);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Hint::StartWorker(void)
+{
+    Worker = SDL_CreateThread(WorkerThread, "Hint", this);
+    if (Worker == NULL)  printf("*****ERROR: Could not start the hint thread: %s*****\n", SDL_GetError());
+}
+
+//-------------------------------------------------------------------------------------------------
+void Hint::LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8])
+{
+    SDL_LockMutex(Lock);
+
+    Board->LoadPieceData(pieceData);
+    HintSearch->LoadPieceData(pieceData, maxRotation);
+
+    SDL_UnlockMutex(Lock);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Hint::Request(int player, Uint64 key, int playfield[15][26], Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY)
+{
+    if (Worker == NULL)  StartWorker();
+
+    SDL_LockMutex(Lock);
+
+    /* Only the locked stack is copied, the falling piece is out of the playfield when hints are asked for and the drop shadow is left out */
+    for (int y = 0; y < 26; y++)
+        for (int x = 0; x < 15; x++)
+        {
+            int box = playfield[x][y];
+            RequestPlayfield[player][x][y] = ( (box > 10 && box < 20) || box == 255 ? box : 0 );
+        }
+
+    RequestKey[player] = key;
+    RequestPiece[player] = piece;
+    RequestNextPiece[player] = nextPiece;
+    RequestStartX[player] = startX;
+    RequestEndX[player] = endX;
+    RequestStartY[player] = startY;
+    Pending[player] = true;
+
+    SDL_CondSignal(WorkReady);
+    SDL_UnlockMutex(Lock);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Hint::Answer(int player, Uint64 key, int *x, int *rotation, int *y)
+{
+bool answered;
+
+    SDL_LockMutex(Lock);
+
+    answered = (AnswerKey[player] == key && AnswerX[player] != -1);
+    if (answered == true)
+    {
+        *x = AnswerX[player];
+        *rotation = AnswerRotation[player];
+        *y = AnswerY[player];
+    }
+
+    SDL_UnlockMutex(Lock);
+
+    return(answered);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Hint::Solve(int player)
+{
+Uint64 key = RequestKey[player];
+Uint8 piece = RequestPiece[player];
+Uint8 nextPiece = RequestNextPiece[player];
+int startX = RequestStartX[player];
+int endX = RequestEndX[player];
+int startY = RequestStartY[player];
+int x, rotation, y;
+Uint32 startTicks;
+
+    Board->LoadPlayfield(RequestPlayfield[player]);
+    Pending[player] = false;
+
+    /* The search runs unlocked, a newer request for this player just makes this answer unused */
+    SDL_UnlockMutex(Lock);
+
+    HintSearch->Start(Board, piece, nextPiece, startX, endX, startY);
+    startTicks = SDL_GetTicks();
+    while (HintSearch->Done == false && (SDL_GetTicks() - startTicks) < HintSearchMS)  HintSearch->Continue(1000);
+
+    x = HintSearch->BestMoveX;
+    rotation = HintSearch->BestRotation;
+    y = startY;
+    if (x != -1)
+        while (Board->PieceCollision(piece, rotation, x, y+1) == false)  y++;
+
+    SDL_LockMutex(Lock);
+
+    AnswerKey[player] = key;
+    AnswerX[player] = x;
+    AnswerRotation[player] = rotation;
+    AnswerY[player] = y;
+}
@@ -0,0 +1,71 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef HINT
+#define HINT
+
+class Bitboard;
+class Search;
+
+/* Coaching overlay: a background thread runs the C.P.U. player's search for human players' pieces */
+class Hint
+{
+public:
+
+    #define HintMaxPlayers  4
+    #define HintSearchMS    250  /* Longest one hint may search, the anytime search answers with what it has by then */
+
+    SDL_Thread *Worker;
+    SDL_mutex *Lock;
+    SDL_cond *WorkReady;
+    bool Quit;
+
+    Bitboard *Board;
+    Search *HintSearch;
+
+    /* Everything below is only touched with Lock held */
+    bool Pending[HintMaxPlayers];
+    Uint64 RequestKey[HintMaxPlayers];
+    int RequestPlayfield[HintMaxPlayers][15][26];
+    Uint8 RequestPiece[HintMaxPlayers];
+    Uint8 RequestNextPiece[HintMaxPlayers];
+    int RequestStartX[HintMaxPlayers];
+    int RequestEndX[HintMaxPlayers];
+    int RequestStartY[HintMaxPlayers];
+
+    Uint64 AnswerKey[HintMaxPlayers];
+    int AnswerX[HintMaxPlayers];
+    int AnswerRotation[HintMaxPlayers];
+    int AnswerY[HintMaxPlayers];
+
+	Hint(void);
+	virtual ~Hint(void);
+
+    static int WorkerThread(void *data);
+    void StartWorker(void);
+
+    void LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8]);
+
+    void Request(int player, Uint64 key, int playfield[15][26], Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY);
+    bool Answer(int player, Uint64 key, int *x, int *rotation, int *y);
+    void Solve(int player);
+};
+
+#endif
@@ -360,6 +360,13 @@ void Input::GetAllUserInput(void)
                 }
                 break;
 
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                visuals->InvalidateStaticLayer();
+                visuals->InvalidateBoards();
+                screens->ScreenIsDirty = 2;
+                break;
+
             case SDL_KEYDOWN:
                 KeyOnKeyboardPressedByUser = SDL_GetKeyFromScancode(Event.key.keysym.scancode);
 
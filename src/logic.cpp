@@ -29,6 +29,13 @@
 #include "SDL_ttf.h"
 
 #include "logic.h"
+#include "bitboard.h"
+#include "transposition.h"
+#include "neural.h"
+#include "rollout.h"
+#include "hint.h"
+#include "trace.h"
+#include "search.h"
 
 #include "audio.h"
 #include "screens.h"
@@ -59,13 +66,65 @@ Logic::Logic(void)
     StoryLevelAdvanceCounter = -1;
     StoryLevelAdvanceValue = -1;
 
+    for (int player = 0; player < NumberOfPlayers; player++)  AIBitboard[player] = new Bitboard();
+
+    InitializeZobristKeys();
+    AITransposition = new Transposition();
+    VerifyPlayfieldHash = false;
+    PlayfieldHashMismatches = 0;
+
+    for (int player = 0; player < NumberOfPlayers; player++)  PlayerData[player].PlayfieldHash = 0;
+
+    /* C.P.U. skill is how long the A.I. may search each move: Slow plays the greedy A.I. with mistakes */
+    for (int player = 0; player < NumberOfPlayers; player++)  AISearch[player] = new Search();
+    AIMoveBudgetMicroseconds[0] = 0;
+    AIMoveBudgetMicroseconds[1] = 0;
+    AIMoveBudgetMicroseconds[2] = 100;
+    AIMoveBudgetMicroseconds[3] = 500;
+    AIMoveBudgetMicroseconds[4] = 1000;
+    AIMoveBudgetMicroseconds[5] = 0;
+    AIMoveBudgetMicroseconds[6] = 0;
+    AIMoveBudgetMicroseconds[7] = 100;
+    AIFrameMicrosecondsLeft = AIFrameBudgetMicroseconds;
+    AIFrameMicrosecondsMostUsed = 0;
+    AISearchMoves = 0;
+    AISearchDepthTotal = 0;
+    AISearchReplans = 0;
+    AISearchReplanNodes = 0;
+    AISearchReplanDepthTotal = 0;
+
+    AINeural = new Neural();
+    AINeural->LoadWeights("data/ai/Neural-Weights.txt");
+    AIRollout = new Rollout();
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        PlayerData[player].AIRollouts = false;
+        PlayerData[player].AIEvaluator = SearchGiftOfSight;
+        PlayerData[player].AIMaxDepth = SearchMaxDepth;
+        PlayerData[player].AIMoveBudget = 0;
+        PlayerData[player].AIMoves = 0;
+        PlayerData[player].AIMicroseconds = 0;
+    }
+    AISearchRollouts = 0;
+
+    RandomState = 0;
+
+    AIHint = new Hint();
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        PlayerData[player].HintKey = 0;
+        PlayerData[player].HintReady = false;
+    }
+    DisplayHints = false;
+
+    AITrace = NULL;
+    AITraceLane = -1;
+
+    ReferenceEngine = false;
+
     PlayersCanJoin = false;
 
     Uint8 piece, rotation, box;
-    for (piece = 0; piece < 8; piece++)
-        for (rotation = 0; rotation < 5; rotation++)
-            for (box = 0; box < 17; box++)
-                PieceData[piece][rotation][box] = 0;
 
     Multiplier = 0.0f;
     MultiplierSelected = -1;
@@ -144,23 +203,12 @@ Logic::Logic(void)
     TotalThreeLines = 0;
     TotalFourLines = 0;
 
-    MaxRotationArray[0] = 0;
-    MaxRotationArray[1] = 2;
-    MaxRotationArray[2] = 2;
-    MaxRotationArray[3] = 4;
-    MaxRotationArray[4] = 4;
-    MaxRotationArray[5] = 4;
-    MaxRotationArray[6] = 1;
-    MaxRotationArray[7] = 2;
-
-    PieceDropStartHeight[0] = 0;
-    PieceDropStartHeight[1] = 4;
-    PieceDropStartHeight[2] = 4;
-    PieceDropStartHeight[3] = 4;
-    PieceDropStartHeight[4] = 4;
-    PieceDropStartHeight[5] = 4;
-    PieceDropStartHeight[6] = 3;
-    PieceDropStartHeight[7] = 5;
+    /* Shapes stay empty until InitializePieceData(), rotations and drop heights are needed before */
+    FillPieceTables(PieceData, MaxRotationArray, PieceDropStartHeight);
+    for (piece = 0; piece < 8; piece++)
+        for (rotation = 0; rotation < 5; rotation++)
+            for (box = 0; box < 17; box++)
+                PieceData[piece][rotation][box] = 0;
 
     Player = 0;
 
@@ -174,165 +222,280 @@ Logic::Logic(void)
 //-------------------------------------------------------------------------------------------------
 Logic::~Logic(void)
 {
+    for (int player = 0; player < NumberOfPlayers; player++)  delete AISearch[player];
+    delete AIHint;
+    delete AIRollout;
+    delete AINeural;
+    delete AITransposition;
+    for (int player = 0; player < NumberOfPlayers; player++)  delete AIBitboard[player];
+}
+
+//-------------------------------------------------------------------------------------------------
+int Logic::Random(void)
+{
+    if (RandomState == 0)  return( rand() );
 
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+
+    return( (int)(RandomState >> 1) );
 }
 
 //-------------------------------------------------------------------------------------------------
-void Logic::InitializePieceData(void)
+void Logic::InitializeZobristKeys(void)
+{
+Uint64 seed = 0x16B175AF7C4ULL;
+
+    /* SplitMix64, fixed seed so hashes are identical on every run */
+    for (int index = 0; index < (15*26)+8+26+8+8+2+1+4; index++)
+    {
+        seed += 0x9E3779B97F4A7C15ULL;
+        Uint64 key = seed;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+        key = key ^ (key >> 31);
+
+        if (index < (15*26))  ZobristBox[index % 15][index / 15] = key;
+        else if (index < (15*26)+8)  ZobristPiece[index - (15*26)] = key;
+        else if (index < (15*26)+8+26)  ZobristRow[index - (15*26) - 8] = key;
+        else if (index < (15*26)+8+26+8)  ZobristNextPiece[index - (15*26) - 8 - 26] = key;
+        else if (index < (15*26)+8+26+8+8)  ZobristSkill[index - (15*26) - 8 - 26 - 8] = key;
+        else if (index < (15*26)+8+26+8+8+2)  ZobristEvaluator[index - (15*26) - 8 - 26 - 8 - 8] = key;
+        else if (index < (15*26)+8+26+8+8+2+1)  ZobristRollouts = key;
+        else  ZobristDepth[index - (15*26) - 8 - 26 - 8 - 8 - 2 - 1] = key;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint64 Logic::ComputePlayfieldHash(int player)
+{
+Uint64 hash = 0;
+
+    /* Only the locked stack is hashed: boxes in rows 4-23 (the falling and next pieces live elsewhere) */
+    for (int y = 4; y < 24; y++)
+        for (int x = 2; x < 12; x++)
+        {
+            if (PlayerData[player].Playfield[x][y] > 10 && PlayerData[player].Playfield[x][y] < 20)  hash ^= ZobristBox[x][y];
+        }
+
+    return(hash);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::RehashPlayfield(int player)
+{
+    PlayerData[player].PlayfieldHash = ComputePlayfieldHash(player);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::HashLockedPiece(void)
+{
+Uint8 box = 1;
+
+    for (int y = 0; y < 4; y++)
+        for (int x = 0; x < 4; x++)
+        {
+            int playfieldX = PlayerData[Player].PiecePlayfieldX + x;
+            int playfieldY = PlayerData[Player].PiecePlayfieldY + y;
+
+            if (PieceData [PlayerData[Player].Piece] [PlayerData[Player].PieceRotation] [box] == 1
+                && playfieldY > 3 && playfieldY < 24 && playfieldX > 1 && playfieldX < 12)
+                PlayerData[Player].PlayfieldHash ^= ZobristBox[playfieldX][playfieldY];
+
+            box++;
+        }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::FillPieceTables(Uint8 pieceData[8][5][17], Uint8 maxRotation[8], Uint8 dropStartHeight[8])
 {
 Uint8 piece, rotation, box;
 
     for (rotation = 0; rotation < 5; rotation++)
         for (piece = 0; piece < 8; piece++)
             for (box = 0; box < 17; box++)
-                PieceData [piece] [rotation] [box] = 0;
+                pieceData [piece] [rotation] [box] = 0;
 
     /* RED "S Piece"... */
-    PieceData [1] [1] [10] = 1; /* 01 02 03 04 */
-    PieceData [1] [1] [11] = 1; /* 05 06 07 08 */
-    PieceData [1] [1] [13] = 1; /* 09 [] [] 12 */
-    PieceData [1] [1] [14] = 1; /* [] [] 15 16 */
-
-    PieceData [1] [2] [ 5] = 1;
-    PieceData [1] [2] [ 9] = 1;
-    PieceData [1] [2] [10] = 1;
-    PieceData [1] [2] [14] = 1;
-
-    PieceData [1] [3] [10] = 1;
-    PieceData [1] [3] [11] = 1;
-    PieceData [1] [3] [13] = 1;
-    PieceData [1] [3] [14] = 1;
-
-    PieceData [1] [4] [ 5] = 1;
-    PieceData [1] [4] [ 9] = 1;
-    PieceData [1] [4] [10] = 1;
-    PieceData [1] [4] [14] = 1;
+    pieceData [1] [1] [10] = 1; /* 01 02 03 04 */
+    pieceData [1] [1] [11] = 1; /* 05 06 07 08 */
+    pieceData [1] [1] [13] = 1; /* 09 [] [] 12 */
+    pieceData [1] [1] [14] = 1; /* [] [] 15 16 */
+
+    pieceData [1] [2] [ 5] = 1;
+    pieceData [1] [2] [ 9] = 1;
+    pieceData [1] [2] [10] = 1;
+    pieceData [1] [2] [14] = 1;
+
+    pieceData [1] [3] [10] = 1;
+    pieceData [1] [3] [11] = 1;
+    pieceData [1] [3] [13] = 1;
+    pieceData [1] [3] [14] = 1;
+
+    pieceData [1] [4] [ 5] = 1;
+    pieceData [1] [4] [ 9] = 1;
+    pieceData [1] [4] [10] = 1;
+    pieceData [1] [4] [14] = 1;
 
     /* ORANGE "Z Piece"... */
-    PieceData [2] [1] [ 9] = 1;
-    PieceData [2] [1] [10] = 1;
-    PieceData [2] [1] [14] = 1;
-    PieceData [2] [1] [15] = 1;
-
-    PieceData [2] [2] [ 6] = 1;
-    PieceData [2] [2] [ 9] = 1;
-    PieceData [2] [2] [10] = 1;
-    PieceData [2] [2] [13] = 1;
-
-    PieceData [2] [3] [ 9] = 1;
-    PieceData [2] [3] [10] = 1;
-    PieceData [2] [3] [14] = 1;
-    PieceData [2] [3] [15] = 1;
-
-    PieceData [2] [4] [ 6] = 1;
-    PieceData [2] [4] [ 9] = 1;
-    PieceData [2] [4] [10] = 1;
-    PieceData [2] [4] [13] = 1;
+    pieceData [2] [1] [ 9] = 1;
+    pieceData [2] [1] [10] = 1;
+    pieceData [2] [1] [14] = 1;
+    pieceData [2] [1] [15] = 1;
+
+    pieceData [2] [2] [ 6] = 1;
+    pieceData [2] [2] [ 9] = 1;
+    pieceData [2] [2] [10] = 1;
+    pieceData [2] [2] [13] = 1;
+
+    pieceData [2] [3] [ 9] = 1;
+    pieceData [2] [3] [10] = 1;
+    pieceData [2] [3] [14] = 1;
+    pieceData [2] [3] [15] = 1;
+
+    pieceData [2] [4] [ 6] = 1;
+    pieceData [2] [4] [ 9] = 1;
+    pieceData [2] [4] [10] = 1;
+    pieceData [2] [4] [13] = 1;
 
     /* AQUA "T Piece"... */
-    PieceData [3] [1] [ 9] = 1;
-    PieceData [3] [1] [10] = 1;
-    PieceData [3] [1] [11] = 1;
-    PieceData [3] [1] [14] = 1;
-
-    PieceData [3] [2] [ 6] = 1;
-    PieceData [3] [2] [ 9] = 1;
-    PieceData [3] [2] [10] = 1;
-    PieceData [3] [2] [14] = 1;
-
-    PieceData [3] [3] [ 6] = 1;
-    PieceData [3] [3] [ 9] = 1;
-    PieceData [3] [3] [10] = 1;
-    PieceData [3] [3] [11] = 1;
-
-    PieceData [3] [4] [ 6] = 1;
-    PieceData [3] [4] [10] = 1;
-    PieceData [3] [4] [11] = 1;
-    PieceData [3] [4] [14] = 1;
+    pieceData [3] [1] [ 9] = 1;
+    pieceData [3] [1] [10] = 1;
+    pieceData [3] [1] [11] = 1;
+    pieceData [3] [1] [14] = 1;
+
+    pieceData [3] [2] [ 6] = 1;
+    pieceData [3] [2] [ 9] = 1;
+    pieceData [3] [2] [10] = 1;
+    pieceData [3] [2] [14] = 1;
+
+    pieceData [3] [3] [ 6] = 1;
+    pieceData [3] [3] [ 9] = 1;
+    pieceData [3] [3] [10] = 1;
+    pieceData [3] [3] [11] = 1;
+
+    pieceData [3] [4] [ 6] = 1;
+    pieceData [3] [4] [10] = 1;
+    pieceData [3] [4] [11] = 1;
+    pieceData [3] [4] [14] = 1;
 
     /* YELLOW "L Piece"... */
-    PieceData [4] [1] [ 9] = 1;
-    PieceData [4] [1] [10] = 1;
-    PieceData [4] [1] [11] = 1;
-    PieceData [4] [1] [13] = 1;
-
-    PieceData [4] [2] [ 5] = 1;
-    PieceData [4] [2] [ 6] = 1;
-    PieceData [4] [2] [10] = 1;
-    PieceData [4] [2] [14] = 1;
-
-    PieceData [4] [3] [ 7] = 1;
-    PieceData [4] [3] [ 9] = 1;
-    PieceData [4] [3] [10] = 1;
-    PieceData [4] [3] [11] = 1;
-
-    PieceData [4] [4] [ 6] = 1;
-    PieceData [4] [4] [10] = 1;
-    PieceData [4] [4] [14] = 1;
-    PieceData [4] [4] [15] = 1;
+    pieceData [4] [1] [ 9] = 1;
+    pieceData [4] [1] [10] = 1;
+    pieceData [4] [1] [11] = 1;
+    pieceData [4] [1] [13] = 1;
+
+    pieceData [4] [2] [ 5] = 1;
+    pieceData [4] [2] [ 6] = 1;
+    pieceData [4] [2] [10] = 1;
+    pieceData [4] [2] [14] = 1;
+
+    pieceData [4] [3] [ 7] = 1;
+    pieceData [4] [3] [ 9] = 1;
+    pieceData [4] [3] [10] = 1;
+    pieceData [4] [3] [11] = 1;
+
+    pieceData [4] [4] [ 6] = 1;
+    pieceData [4] [4] [10] = 1;
+    pieceData [4] [4] [14] = 1;
+    pieceData [4] [4] [15] = 1;
 
     /* GREEN "Backwards L Piece"... */
-    PieceData [5] [1] [ 9] = 1;
-    PieceData [5] [1] [10] = 1;
-    PieceData [5] [1] [11] = 1;
-    PieceData [5] [1] [15] = 1;
-
-    PieceData [5] [2] [ 6] = 1;
-    PieceData [5] [2] [10] = 1;
-    PieceData [5] [2] [13] = 1;
-    PieceData [5] [2] [14] = 1;
-
-    PieceData [5] [3] [ 5] = 1;
-    PieceData [5] [3] [ 9] = 1;
-    PieceData [5] [3] [10] = 1;
-    PieceData [5] [3] [11] = 1;
-
-    PieceData [5] [4] [ 6] = 1;
-    PieceData [5] [4] [ 7] = 1;
-    PieceData [5] [4] [10] = 1;
-    PieceData [5] [4] [14] = 1;
+    pieceData [5] [1] [ 9] = 1;
+    pieceData [5] [1] [10] = 1;
+    pieceData [5] [1] [11] = 1;
+    pieceData [5] [1] [15] = 1;
+
+    pieceData [5] [2] [ 6] = 1;
+    pieceData [5] [2] [10] = 1;
+    pieceData [5] [2] [13] = 1;
+    pieceData [5] [2] [14] = 1;
+
+    pieceData [5] [3] [ 5] = 1;
+    pieceData [5] [3] [ 9] = 1;
+    pieceData [5] [3] [10] = 1;
+    pieceData [5] [3] [11] = 1;
+
+    pieceData [5] [4] [ 6] = 1;
+    pieceData [5] [4] [ 7] = 1;
+    pieceData [5] [4] [10] = 1;
+    pieceData [5] [4] [14] = 1;
 
     /* BLUE "Box Piece"... */
-    PieceData [6] [1] [10] = 1;
-    PieceData [6] [1] [11] = 1;
-    PieceData [6] [1] [14] = 1;
-    PieceData [6] [1] [15] = 1;
-
-    PieceData [6] [2] [10] = 1;
-    PieceData [6] [2] [11] = 1;
-    PieceData [6] [2] [14] = 1;
-    PieceData [6] [2] [15] = 1;
-
-    PieceData [6] [3] [10] = 1;
-    PieceData [6] [3] [11] = 1;
-    PieceData [6] [3] [14] = 1;
-    PieceData [6] [3] [15] = 1;
-
-    PieceData [6] [4] [10] = 1;
-    PieceData [6] [4] [11] = 1;
-    PieceData [6] [4] [14] = 1;
-    PieceData [6] [4] [15] = 1;
+    pieceData [6] [1] [10] = 1;
+    pieceData [6] [1] [11] = 1;
+    pieceData [6] [1] [14] = 1;
+    pieceData [6] [1] [15] = 1;
+
+    pieceData [6] [2] [10] = 1;
+    pieceData [6] [2] [11] = 1;
+    pieceData [6] [2] [14] = 1;
+    pieceData [6] [2] [15] = 1;
+
+    pieceData [6] [3] [10] = 1;
+    pieceData [6] [3] [11] = 1;
+    pieceData [6] [3] [14] = 1;
+    pieceData [6] [3] [15] = 1;
+
+    pieceData [6] [4] [10] = 1;
+    pieceData [6] [4] [11] = 1;
+    pieceData [6] [4] [14] = 1;
+    pieceData [6] [4] [15] = 1;
 
     /* PURPLE "Line Piece"... */
-    PieceData [7] [1] [ 9] = 1;
-    PieceData [7] [1] [10] = 1;
-    PieceData [7] [1] [11] = 1;
-    PieceData [7] [1] [12] = 1;
-
-    PieceData [7] [2] [ 2] = 1;
-    PieceData [7] [2] [ 6] = 1;
-    PieceData [7] [2] [10] = 1;
-    PieceData [7] [2] [14] = 1;
-
-    PieceData [7] [3] [ 9] = 1;
-    PieceData [7] [3] [10] = 1;
-    PieceData [7] [3] [11] = 1;
-    PieceData [7] [3] [12] = 1;
-
-    PieceData [7] [4] [ 2] = 1;
-    PieceData [7] [4] [ 6] = 1;
-    PieceData [7] [4] [10] = 1;
-    PieceData [7] [4] [14] = 1;
+    pieceData [7] [1] [ 9] = 1;
+    pieceData [7] [1] [10] = 1;
+    pieceData [7] [1] [11] = 1;
+    pieceData [7] [1] [12] = 1;
+
+    pieceData [7] [2] [ 2] = 1;
+    pieceData [7] [2] [ 6] = 1;
+    pieceData [7] [2] [10] = 1;
+    pieceData [7] [2] [14] = 1;
+
+    pieceData [7] [3] [ 9] = 1;
+    pieceData [7] [3] [10] = 1;
+    pieceData [7] [3] [11] = 1;
+    pieceData [7] [3] [12] = 1;
+
+    pieceData [7] [4] [ 2] = 1;
+    pieceData [7] [4] [ 6] = 1;
+    pieceData [7] [4] [10] = 1;
+    pieceData [7] [4] [14] = 1;
+
+    maxRotation[0] = 0;
+    maxRotation[1] = 2;
+    maxRotation[2] = 2;
+    maxRotation[3] = 4;
+    maxRotation[4] = 4;
+    maxRotation[5] = 4;
+    maxRotation[6] = 1;
+    maxRotation[7] = 2;
+
+    dropStartHeight[0] = 0;
+    dropStartHeight[1] = 4;
+    dropStartHeight[2] = 4;
+    dropStartHeight[3] = 4;
+    dropStartHeight[4] = 4;
+    dropStartHeight[5] = 4;
+    dropStartHeight[6] = 3;
+    dropStartHeight[7] = 5;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::InitializePieceData(void)
+{
+    FillPieceTables(PieceData, MaxRotationArray, PieceDropStartHeight);
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        AIBitboard[player]->LoadPieceData(PieceData);
+        AISearch[player]->LoadPieceData(PieceData, MaxRotationArray);
+    }
+
+    AIRollout->LoadPieceData(PieceData, MaxRotationArray);
+    AIHint->LoadPieceData(PieceData, MaxRotationArray);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -351,6 +514,8 @@ void Logic::ClearPlayfieldsWithCollisionDetection(void)
         for (int y = 5; y < 24; y++)
             for (int x = 2; x < 12; x++)
                 PlayerData[player].Playfield[x][y] = 0;
+
+        PlayerData[player].PlayfieldHash = 0;
 	}
 }
 
@@ -367,13 +532,13 @@ bool done = false;
         PlayerData[player].PieceSelectedAlready[index] = false;
     }
 
-    PlayerData[player].PieceBag[0][1] = ( rand()%7 + 1 );
+    PlayerData[player].PieceBag[0][1] = ( Random()%7 + 1 );
     PlayerData[player].PieceSelectedAlready[ PlayerData[player].PieceBag[0][1] ] = true;
     while (done == false)
     {
         for (int x = 2; x < 8; x++)
         {
-            int randomPieceToTry = ( rand()%7 + 1 );
+            int randomPieceToTry = ( Random()%7 + 1 );
             if (PlayerData[player].PieceSelectedAlready[randomPieceToTry] == false)
             {
                 PlayerData[player].PieceBag[0][x] = randomPieceToTry;
@@ -705,6 +870,7 @@ void Logic::CheckForCompletedLines(void)
 int numberOfCompletedLines = 0;
 
     AddPieceToPlayfieldMemory(Current);
+    HashLockedPiece();
 
 	for (int y = 5; y < 24; y++)
 	{
@@ -785,33 +951,8 @@ bool inDanger = false;
 }
 
 //-------------------------------------------------------------------------------------------------
-void Logic::MovePieceDown(bool Force)
+void Logic::MovePieceDown(void)
 {
-    if (Force == false)
-    {
-        if (PlayerData[Player].PlayerInput == CPU)
-        {
-            if (CPUPlayerEnabled == 1 || CPUPlayerEnabled == 6)
-            {
-                PlayerData[Player].CPUFrame++;
-                if (PlayerData[Player].CPUFrame < 10)
-                {
-                    return;
-                }
-                else  PlayerData[Player].CPUFrame = 0;
-            }
-            else if (CPUPlayerEnabled == 2 || CPUPlayerEnabled == 7)
-            {
-                PlayerData[Player].CPUFrame++;
-                if (PlayerData[Player].CPUFrame < 5)
-                {
-                    return;
-                }
-                else  PlayerData[Player].CPUFrame = 0;
-            }
-        }
-    }
-
     DeletePieceFromPlayfieldMemory(Current);
 
 	PlayerData[Player].PiecePlayfieldY++;
@@ -1237,8 +1378,6 @@ void Logic::SetupForNewGame(void)
         PlayerData[Player].BestMoveCalculated = false;
         PlayerData[Player].MovedToBestMove = false;
 
-        PlayerData[Player].CPUFrame = 0;
-
         BlockAttackTransparency[Player] = 0;
 	}
 
@@ -1375,7 +1514,7 @@ void Logic::SetupForNewGame(void)
                 int boxTotal = 0;
                 for (int x = 2; x < 12; x++)
                 {
-                    Uint32 box = rand()%8;
+                    Uint32 box = Random()%8;
                     if (box > 0)  boxTotal++;
 
                     if (boxTotal < 10)
@@ -1389,6 +1528,8 @@ void Logic::SetupForNewGame(void)
         }
     }
 
+    for (int player = 0; player < NumberOfPlayers; player++)  RehashPlayfield(player);
+
 //    TestMode = true;
     if (TestMode == true)
     {
@@ -1457,7 +1598,8 @@ void Logic::SetupForNewLevelStory(void)
     PlayerData[Player].BestMoveCalculated = false;
     PlayerData[Player].MovedToBestMove = false;
 
-    PlayerData[Player].CPUFrame = 0;
+    /* The story screen can cut in while completed lines are still being cleared */
+    RehashPlayfield(player);
 
     BlockAttackTransparency[Player] = 0;
 
@@ -1706,6 +1848,8 @@ bool thereWasACompletedLine = false;
 
 	if (thereWasACompletedLine == false)
 	{
+        RehashPlayfield(Player);
+
 		SetupNewPiece();
 		PlayerData[Player].PlayerStatus = NewPieceDropping;
 	}
@@ -1731,7 +1875,7 @@ int TEMP_Player = Player;
                     }
                 }
 
-                if (PieceCollisionDown() == CollisionWithPlayfield)  MovePieceDown(true);
+                if (PieceCollisionDown() == CollisionWithPlayfield)  MovePieceDown();
 
                 if (PlayerData[Player].PlayerStatus != FlashingCompletedLines
                     && PlayerData[Player].PlayerStatus != ClearingCompletedLines)
@@ -1755,6 +1899,8 @@ int TEMP_Player = Player;
                         PlayerData[Player].Playfield[x][23] = PlayerData[TEMP_Player].AttackLines[attackX][11];
                         attackX++;
                     }
+
+                    RehashPlayfield(Player);
                 }
             }
             else
@@ -1795,7 +1941,7 @@ bool Logic::AddAnIncompleteLineToPlayfieldCrisisMode(void)
         }
     }
 
-    if (PieceCollisionDown() == CollisionWithPlayfield)  MovePieceDown(true);
+    if (PieceCollisionDown() == CollisionWithPlayfield)  MovePieceDown();
 
     for (int y = 5; y < 23; y++)
 	    for (int x = 2; x < 12; x++)
@@ -1807,7 +1953,7 @@ bool Logic::AddAnIncompleteLineToPlayfieldCrisisMode(void)
     int boxTotal = 0;
     for (int x = 2; x < 12; x++)
     {
-        Uint32 box = rand()%8;
+        Uint32 box = Random()%8;
         if (box > 0)  boxTotal++;
 
         if (boxTotal < 10)
@@ -1818,6 +1964,8 @@ bool Logic::AddAnIncompleteLineToPlayfieldCrisisMode(void)
         else  PlayerData[Player].Playfield[x][23] = 0;
     }
 
+    RehashPlayfield(Player);
+
     return(true);
 }
 
@@ -1862,6 +2010,8 @@ void Logic::RunTetriGameEngine(void)
 
 	if (PAUSEgame == false)
 	{
+        AIFrameMicrosecondsLeft = AIFrameBudgetMicroseconds;
+
 		for (Player = 0; Player < NumberOfPlayers; Player++)
 		{
             if (PlayerData[Player].PlayerStatus != GameOver)
@@ -1880,7 +2030,7 @@ void Logic::RunTetriGameEngine(void)
                     PlayerData[Player].DropBonus = 0;
 
                     if (PlayerData[Player].PiecePlayfieldY < PieceDropStartHeight[ PlayerData[Player].Piece ])
-                        MovePieceDown(true);
+                        MovePieceDown();
                     else
                     {
                         if (DisplayNextPiece == 1)  AddPieceToPlayfieldMemory(Next);
@@ -1896,7 +2046,7 @@ void Logic::RunTetriGameEngine(void)
 
                     if (PlayerData[Player].PieceDropTimer > PlayerData[Player].TimeToDropPiece)
                     {
-                        MovePieceDown(false);
+                        MovePieceDown();
                     }
 
                     if (PlayerData[Player].PlayerInput == CPU)
@@ -2064,7 +2214,7 @@ void Logic::RunTetriGameEngine(void)
                         {
                             if (mousePlayfieldX < PlayerData[Player].PiecePlayfieldX)  MovePieceLeft();
                             else if (mousePlayfieldX > PlayerData[Player].PiecePlayfieldX)  MovePieceRight();
-                            else if (mousePlayfieldY > PlayerData[Player].PiecePlayfieldY)  MovePieceDown(false);
+                            else if (mousePlayfieldY > PlayerData[Player].PiecePlayfieldY)  MovePieceDown();
 
                             if (mousePlayfieldX != PlayerData[Player].PiecePlayfieldX || mousePlayfieldY > PlayerData[Player].PiecePlayfieldY)
                                 input->MouseButtonWasClicked[0] = false;
@@ -2112,6 +2262,9 @@ void Logic::RunTetriGameEngine(void)
 
             if (BlockAttackTransparency[Player] > 0.0f)  BlockAttackTransparency[Player]-=5;
 		}
+
+        if ( (Uint32)(AIFrameBudgetMicroseconds - AIFrameMicrosecondsLeft) > AIFrameMicrosecondsMostUsed )
+            AIFrameMicrosecondsMostUsed = (Uint32)(AIFrameBudgetMicroseconds - AIFrameMicrosecondsLeft);
 	}
 }
 
@@ -2133,6 +2286,8 @@ bool returnValue = false;
         PlayerData[Player].Playfield[x][5] = 0;
     }
 
+    RehashPlayfield(Player);
+
 	for (int y = 5; y < 24; y++)
 	{
 		for (int x = 2; x < 12; x++)
@@ -2145,148 +2300,425 @@ bool returnValue = false;
 }
 
 //-------------------------------------------------------------------------------------------------
-void Logic::ComputeComputerPlayerMove(void)
+void Logic::RestartComputerSkillTestPlayer(void)
 {
-    if (PlayerData[Player].PlayerStatus != PieceFalling)  return;
+    NumberofCPUGames++;
+
+    for (int y = 0; y < 26; y++)
+        for (int x = 0; x < 15; x++)
+            PlayerData[Player].Playfield[x][y] = 255; /* Collision detection value */
+
+    for (int y = 2; y < 5; y++)
+        for (int x = 5; x < 9; x++)
+            PlayerData[Player].Playfield[x][y] = 0;
+
+    for (int y = 5; y < 24; y++)
+        for (int x = 2; x < 12; x++)
+            PlayerData[Player].Playfield[x][y] = 0;
+
+    PlayerData[Player].PiecePlayfieldX = 5;
+    PlayerData[Player].PiecePlayfieldY = 0;
+
+    FillPieceBag(Player);
+    PlayerData[Player].Piece = PlayerData[Player].PieceBag[0][PlayerData[Player].PieceBagIndex];
+    PlayerData[Player].PieceBagIndex = 1;
+    PlayerData[Player].NextPiece = PlayerData[Player].PieceBag[0][PlayerData[Player].PieceBagIndex];
+
+    PlayerData[Player].Piece = PlayerData[Player].NextPiece;
+    PlayerData[Player].PieceBagIndex = 2;
+    PlayerData[Player].NextPiece = PlayerData[Player].PieceBag[0][PlayerData[Player].PieceBagIndex];
+
+    PlayerData[Player].PieceMovementDelay = 0;
+    PlayerData[Player].PieceRotation = 1;
+
+    PlayerData[Player].PlayerStatus = NewPieceDropping;
+
+    PlayerData[Player].PieceDropTimer = 0;
+    PlayerData[Player].TimeToDropPiece = 47;
+
+    PlayerData[Player].PieceRotated1 = false;
+    PlayerData[Player].PieceRotated2 = false;
+
+    PlayerData[Player].FlashCompletedLinesTimer = 0;
+    PlayerData[Player].ClearCompletedLinesTimer = 0;
+
+    PlayerData[Player].Score = 0;
+    PlayerData[Player].DropBonus = 0;
+    PlayerData[Player].Level = 0;
+    PlayerData[Player].Lines = 0;
+
+    RehashPlayfield(Player);
+}
 
-    if (PlayerData[Player].BestMoveCalculated == false)
+//-------------------------------------------------------------------------------------------------
+void Logic::ScoreComputerPlayerMoves(void)
+{
+Bitboard *board = AIBitboard[Player];
+
+    /* Board features and scored moves are kept per player and only rebuilt when the playfield changes */
+    board->LoadPlayfieldIfChanged(PlayerData[Player].Playfield);
+    board->ScoreAllMoves(PlayerData[Player].Piece, MaxRotationArray[ PlayerData[Player].Piece ]
+                         , PlayerData[Player].PlayfieldStartX, PlayerData[Player].PlayfieldEndX, PlayerData[Player].PiecePlayfieldY);
+
+    for (int move = 0; move < board->MovesCount; move++)
     {
-        int TEMP_PieceRotation;
-        int TEMP_PiecePlayfieldX;
-        int TEMP_PiecePlayfieldY;
-        int posY;
-        int posX;
-
-        DeletePieceFromPlayfieldMemory(Current);
-        for (int pieceTestX = (PlayerData[Player].PlayfieldStartX-2); pieceTestX < (PlayerData[Player].PlayfieldEndX-1); pieceTestX+=1)
+        int x = board->MoveX[move];
+        int rot = board->MoveRotation[move];
+
+        PlayerData[Player].MovePieceCollision[x][rot] = board->MoveCollision[move];
+        PlayerData[Player].MovePieceHeight[x][rot] = board->MoveHeight[move];
+        if (board->MoveCollision[move] == true)  continue;
+
+        PlayerData[Player].MoveTrappedHoles[x][rot] = board->MoveTrappedHoles[move];
+        PlayerData[Player].MoveCompletedLines[x][rot] = board->MoveCompletedLines[move];
+        PlayerData[Player].MovePlayfieldBoxEdges[x][rot] = board->MoveBoxEdges[move];
+        PlayerData[Player].MoveOneBlockCavernHoles[x][rot] = board->MoveOneBlockCavernHoles[move];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::ScoreComputerPlayerMovesReference(void)
+{
+    /* Original cell-by-cell scoring, kept to check the bitboard kernels against ("--benchmark") */
+    int TEMP_PieceRotation;
+    int TEMP_PiecePlayfieldX;
+    int TEMP_PiecePlayfieldY;
+    int posY;
+    int posX;
+
+    for (int pieceTestX = (PlayerData[Player].PlayfieldStartX-2); pieceTestX < (PlayerData[Player].PlayfieldEndX-1); pieceTestX+=1)
+    {
+        for (int rotationTest = 1; rotationTest <= MaxRotationArray[ PlayerData[Player].Piece ]; rotationTest+=1)
         {
-            for (int rotationTest = 1; rotationTest <= MaxRotationArray[ PlayerData[Player].Piece ]; rotationTest+=1)
-            {
-                TEMP_PieceRotation = PlayerData[Player].PieceRotation;
-                TEMP_PiecePlayfieldX = PlayerData[Player].PiecePlayfieldX;
-                TEMP_PiecePlayfieldY = PlayerData[Player].PiecePlayfieldY;
+            TEMP_PieceRotation = PlayerData[Player].PieceRotation;
+            TEMP_PiecePlayfieldX = PlayerData[Player].PiecePlayfieldX;
+            TEMP_PiecePlayfieldY = PlayerData[Player].PiecePlayfieldY;
 
-                PlayerData[Player].PiecePlayfieldX = pieceTestX;
-                PlayerData[Player].PieceRotation = rotationTest;
+            PlayerData[Player].PiecePlayfieldX = pieceTestX;
+            PlayerData[Player].PieceRotation = rotationTest;
 
-                PlayerData[Player].MovePieceCollision[pieceTestX][rotationTest] = false;
-                PlayerData[Player].MovePieceHeight[pieceTestX][rotationTest] = 0;
-                if (PieceCollision() == CollisionNotTrue)
+            PlayerData[Player].MovePieceCollision[pieceTestX][rotationTest] = false;
+            PlayerData[Player].MovePieceHeight[pieceTestX][rotationTest] = 0;
+            if (PieceCollision() == CollisionNotTrue)
+            {
+                for (posY = PlayerData[Player].PiecePlayfieldY; posY < 23; posY+=1)
                 {
-                    for (posY = PlayerData[Player].PiecePlayfieldY; posY < 23; posY+=1)
+                    PlayerData[Player].PiecePlayfieldY  = posY;
+                    if (PieceCollision() != CollisionNotTrue)
                     {
-                        PlayerData[Player].PiecePlayfieldY  = posY;
-                        if (PieceCollision() != CollisionNotTrue)
-                        {
-                            PlayerData[Player].PiecePlayfieldY = posY-1;
-                            PlayerData[Player].MovePieceHeight[pieceTestX][rotationTest] = PlayerData[Player].PiecePlayfieldY;
-                            posY = 100;
-                        }
+                        PlayerData[Player].PiecePlayfieldY = posY-1;
+                        PlayerData[Player].MovePieceHeight[pieceTestX][rotationTest] = PlayerData[Player].PiecePlayfieldY;
+                        posY = 100;
                     }
+                }
 
-                    AddPieceToPlayfieldMemory(Current);
+                AddPieceToPlayfieldMemory(Current);
 
-                    PlayerData[Player].MoveTrappedHoles[pieceTestX][rotationTest] = 0;
-                    for (posX = PlayerData[Player].PlayfieldStartX; posX < PlayerData[Player].PlayfieldEndX; posX+=1)
+                PlayerData[Player].MoveTrappedHoles[pieceTestX][rotationTest] = 0;
+                for (posX = PlayerData[Player].PlayfieldStartX; posX < PlayerData[Player].PlayfieldEndX; posX+=1)
+                {
+                    int numberOfEmpties;
+                    numberOfEmpties = 0;
+                    for (posY = 23; posY > 4; posY-=1)
                     {
-                        int numberOfEmpties;
-                        numberOfEmpties = 0;
-                        for (posY = 23; posY > 4; posY-=1)
+                        if (PlayerData[Player].Playfield[posX][posY] == 0)
                         {
-                            if (PlayerData[Player].Playfield[posX][posY] == 0)
-                            {
-                                numberOfEmpties+=1;
-                            }
-                            else if (PlayerData[Player].Playfield[posX][posY] > 10 && PlayerData[Player].Playfield[posX][posY] < 20)
-                            {
-                                PlayerData[Player].MoveTrappedHoles[pieceTestX][rotationTest]+=numberOfEmpties;
-                                numberOfEmpties = 0;
-                            }
+                            numberOfEmpties+=1;
+                        }
+                        else if (PlayerData[Player].Playfield[posX][posY] > 10 && PlayerData[Player].Playfield[posX][posY] < 20)
+                        {
+                            PlayerData[Player].MoveTrappedHoles[pieceTestX][rotationTest]+=numberOfEmpties;
+                            numberOfEmpties = 0;
                         }
                     }
+                }
 
-                    PlayerData[Player].MoveCompletedLines[pieceTestX][rotationTest] = 0;
-                    PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest] = 0;
-                    for (posY = 5; posY < 25; posY+=1)
+                PlayerData[Player].MoveCompletedLines[pieceTestX][rotationTest] = 0;
+                PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest] = 0;
+                for (posY = 5; posY < 25; posY+=1)
+                {
+                    int boxTotal;
+                    boxTotal = 0;
+                    for ( posX = (PlayerData[Player].PlayfieldStartX-1); posX < PlayerData[Player].PlayfieldEndX; posX+=1 )
                     {
-                        int boxTotal;
-                        boxTotal = 0;
-                        for ( posX = (PlayerData[Player].PlayfieldStartX-1); posX < PlayerData[Player].PlayfieldEndX; posX+=1 )
+                        if ( (PlayerData[Player].Playfield[posX][posY] > 10 && PlayerData[Player].Playfield[posX][posY] < 20)
+                            || PlayerData[Player].Playfield[posX][posY] == 255 )
                         {
-                            if ( (PlayerData[Player].Playfield[posX][posY] > 10 && PlayerData[Player].Playfield[posX][posY] < 20)
-                                || PlayerData[Player].Playfield[posX][posY] == 255 )
-                            {
-                                if (PlayerData[Player].Playfield[posX][posY] != 255)  boxTotal+=1;
+                            if (PlayerData[Player].Playfield[posX][posY] != 255)  boxTotal+=1;
 
-                                if (PlayerData[Player].Playfield[posX][(posY-1)] == 0)
-                                    PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
+                            if (PlayerData[Player].Playfield[posX][(posY-1)] == 0)
+                                PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
 
-                                if (PlayerData[Player].Playfield[posX][(posY+1)] == 0)
-                                    PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
+                            if (PlayerData[Player].Playfield[posX][(posY+1)] == 0)
+                                PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
 
-                                if (PlayerData[Player].Playfield[(posX-1)][posY] == 0)
-                                    PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
+                            if (PlayerData[Player].Playfield[(posX-1)][posY] == 0)
+                                PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
 
-                                if (PlayerData[Player].Playfield[(posX+1)][posY] == 0)
-                                    PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
-                            }
+                            if (PlayerData[Player].Playfield[(posX+1)][posY] == 0)
+                                PlayerData[Player].MovePlayfieldBoxEdges[pieceTestX][rotationTest]+=1;
                         }
-
-                        if (boxTotal == 10)  PlayerData[Player].MoveCompletedLines[pieceTestX][rotationTest]+=1;
                     }
 
-                    PlayerData[Player].MoveOneBlockCavernHoles[pieceTestX][rotationTest] = 0;
-                    for (posY = 5; posY < 24; posY+=1)
+                    if (boxTotal == 10)  PlayerData[Player].MoveCompletedLines[pieceTestX][rotationTest]+=1;
+                }
+
+                PlayerData[Player].MoveOneBlockCavernHoles[pieceTestX][rotationTest] = 0;
+                for (posY = 5; posY < 24; posY+=1)
+                {
+                    for (posX = PlayerData[Player].PlayfieldStartX; posX < PlayerData[Player].PlayfieldEndX; posX+=1)
                     {
-                        for (posX = PlayerData[Player].PlayfieldStartX; posX < PlayerData[Player].PlayfieldEndX; posX+=1)
-                        {
-                            if (PlayerData[Player].Playfield[posX][posY] == 0
-                            && PlayerData[Player].Playfield[(posX-1)][posY] != 0 && PlayerData[Player].Playfield[(posX+1)][posY] != 0)
-                                PlayerData[Player].MoveOneBlockCavernHoles[pieceTestX][rotationTest]+=1;
-                        }
+                        if (PlayerData[Player].Playfield[posX][posY] == 0
+                        && PlayerData[Player].Playfield[(posX-1)][posY] != 0 && PlayerData[Player].Playfield[(posX+1)][posY] != 0)
+                            PlayerData[Player].MoveOneBlockCavernHoles[pieceTestX][rotationTest]+=1;
                     }
-
-                    DeletePieceFromPlayfieldMemory(Current);
                 }
-                else  PlayerData[Player].MovePieceCollision[pieceTestX][rotationTest] = true;
 
-                PlayerData[Player].PieceRotation = TEMP_PieceRotation;
-                PlayerData[Player].PiecePlayfieldX = TEMP_PiecePlayfieldX;
-                PlayerData[Player].PiecePlayfieldY = TEMP_PiecePlayfieldY;
+                DeletePieceFromPlayfieldMemory(Current);
             }
+            else  PlayerData[Player].MovePieceCollision[pieceTestX][rotationTest] = true;
+
+            PlayerData[Player].PieceRotation = TEMP_PieceRotation;
+            PlayerData[Player].PiecePlayfieldX = TEMP_PiecePlayfieldX;
+            PlayerData[Player].PiecePlayfieldY = TEMP_PiecePlayfieldY;
         }
+    }
+}
 
-        PlayerData[Player].BestMoveX = -1;
-        PlayerData[Player].BestRotation = -1;
-        float bestValue;
-        bestValue = FLT_MAX;
-        for (posX = (PlayerData[Player].PlayfieldStartX-1); posX < (PlayerData[Player].PlayfieldEndX-1); posX+=1)
+//-------------------------------------------------------------------------------------------------
+void Logic::ChooseComputerPlayerMoveReference(void)
+{
+float bestValue = FLT_MAX;
+Uint8 piece = PlayerData[Player].Piece;
+
+    ScoreComputerPlayerMovesReference();
+
+    /* Same placements, values and "<=" tie-break as a depth 1 Search of the Gift Of Sight A.I. */
+    PlayerData[Player].BestMoveX = -1;
+    PlayerData[Player].BestRotation = -1;
+    for (int x = (PlayerData[Player].PlayfieldStartX-2); x < (PlayerData[Player].PlayfieldEndX-1); x++)
+        for (int rot = 1; rot <= MaxRotationArray[piece]; rot++)
         {
-            for (int rot = 1; rot <= MaxRotationArray[ PlayerData[Player].Piece ]; rot+=1)
-            {
-                if (PlayerData[Player].MovePieceCollision[posX][rot] == false)
-                {
-                    PlayerData[Player].MovePieceHeight[posX][rot]+=PlayerData[Player].MoveCompletedLines[posX][rot];
+            if (PlayerData[Player].MovePieceCollision[x][rot] == true || x < (PlayerData[Player].PlayfieldStartX-1))  continue;
 
-                    float testValue;
-                    /* -- JeZxLee's ["Gift Of Sight" Tetri A.I. Algorithm ~691,000+]--------------------------------------- */
-                    testValue = ( (3*PlayerData[Player].MoveTrappedHoles[posX][rot])
-                                +(1*PlayerData[Player].MoveOneBlockCavernHoles[posX][rot])
-                                +(1*PlayerData[Player].MovePlayfieldBoxEdges[posX][rot])
-                                -(1*PlayerData[Player].MovePieceHeight[posX][rot]) );
-                    /* --------------------------------------- JeZxLee's ["Gift Of Sight" Tetri A.I. Algorithm ~691,000+]-- */
+            float value = ( (3.0f*PlayerData[Player].MoveTrappedHoles[x][rot])
+                           +(1.0f*PlayerData[Player].MoveOneBlockCavernHoles[x][rot])
+                           +(1.0f*PlayerData[Player].MovePlayfieldBoxEdges[x][rot])
+                           -(1.0f*(PlayerData[Player].MovePieceHeight[x][rot] + PlayerData[Player].MoveCompletedLines[x][rot])) );
 
-                    if (testValue <= bestValue)
-                    {
-                        bestValue = testValue;
-                        PlayerData[Player].BestMoveX = posX;
-                        PlayerData[Player].BestRotation = rot;
-                    }
-                }
+            if (value <= bestValue)
+            {
+                bestValue = value;
+                PlayerData[Player].BestMoveX = x;
+                PlayerData[Player].BestRotation = rot;
             }
         }
+
+    PlayerData[Player].SearchPlayfieldHash = PlayerData[Player].PlayfieldHash;
+    AISearch[Player]->Done = true;
+    AISearch[Player]->MicrosecondsUsed = 0;
+    PlayerData[Player].BestMoveCalculated = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::StartComputerPlayerSearch(void)
+{
+int cachedValue;
+Search *search = AISearch[Player];
+
+    if (VerifyPlayfieldHash == true && PlayerData[Player].PlayfieldHash != ComputePlayfieldHash(Player))
+    {
+        if (PlayfieldHashMismatches == 0)  printf("*****ERROR: Player %i playfield hash is stale*****\n", Player);
+        PlayfieldHashMismatches++;
+        RehashPlayfield(Player);
+    }
+
+    if (ReferenceEngine == true)
+    {
+        ChooseComputerPlayerMoveReference();
+        return;
+    }
+
+    search->Network = AINeural;
+    if (PlayerData[Player].AIEvaluator == SearchNeural && AINeural->Loaded == true)  search->Evaluator = SearchNeural;
+    else  search->Evaluator = SearchGiftOfSight;
+    search->MaxDepth = PlayerData[Player].AIMaxDepth;
+
+    PlayerData[Player].SearchKey = ComputerPlayerSearchKey();
+    PlayerData[Player].SearchPlayfieldHash = PlayerData[Player].PlayfieldHash;
+    PlayerData[Player].SearchReplanned = false;
+
+    if ( AITransposition->Probe(PlayerData[Player].SearchKey, &PlayerData[Player].BestMoveX, &PlayerData[Player].BestRotation, &cachedValue) == true )
+    {
+        /* No root moves of this piece to re-plan from */
+        search->RootCount = 0;
+        search->Done = true;
+
+        /* No search ran, so the trace needs the candidates scored here */
+        if (AITrace != NULL)
+        {
+            AIBitboard[Player]->LoadPlayfieldIfChanged(PlayerData[Player].Playfield);
+            AIBitboard[Player]->ScoreAllMoves(PlayerData[Player].Piece, MaxRotationArray[ PlayerData[Player].Piece ]
+                                              , PlayerData[Player].PlayfieldStartX, PlayerData[Player].PlayfieldEndX, PlayerData[Player].PiecePlayfieldY);
+            TraceComputerPlayerMove(AIBitboard[Player]);
+        }
+    }
+    else
+    {
+        AIBitboard[Player]->LoadPlayfieldIfChanged(PlayerData[Player].Playfield);
+        search->Start(AIBitboard[Player], PlayerData[Player].Piece, PlayerData[Player].NextPiece
+                      , PlayerData[Player].PlayfieldStartX, PlayerData[Player].PlayfieldEndX, PlayerData[Player].PiecePlayfieldY);
+
+        if (PlayerData[Player].AIRollouts == true)  search->StartRollouts(PlayerData[Player].SearchKey);
+
+        PlayerData[Player].BestMoveX = search->BestMoveX;
+        PlayerData[Player].BestRotation = search->BestRotation;
+
+        AIFrameMicrosecondsLeft-=search->MicrosecondsUsed;
+    }
+
+    PlayerData[Player].BestMoveCalculated = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint64 Logic::ComputerPlayerSearchKey(void)
+{
+Search *search = AISearch[Player];
+Uint64 key;
+
+    key = ( PlayerData[Player].PlayfieldHash ^ ZobristPiece[ PlayerData[Player].Piece ]
+          ^ ZobristRow[ PlayerData[Player].PiecePlayfieldY ]
+          ^ ZobristNextPiece[ PlayerData[Player].NextPiece ] ^ ZobristSkill[CPUPlayerEnabled & 7] );
+
+    key ^= ZobristEvaluator[search->Evaluator];
+    if (PlayerData[Player].AIRollouts == true)  key ^= ZobristRollouts;
+
+    /* Players with their own depth or budget (A.I. tournaments) must not share answers with the others */
+    if (search->MaxDepth != SearchMaxDepth)  key ^= ZobristDepth[search->MaxDepth & 3];
+    if (PlayerData[Player].AIMoveBudget > 0)  key ^= ( (Uint64)PlayerData[Player].AIMoveBudget * 0x9E3779B97F4A7C15ULL );
+
+    return(key);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::ReplanComputerPlayerSearch(void)
+{
+Search *search = AISearch[Player];
+Uint32 used = search->MicrosecondsUsed;
+int cachedValue;
+
+    PlayerData[Player].SearchKey = ComputerPlayerSearchKey();
+    PlayerData[Player].SearchPlayfieldHash = PlayerData[Player].PlayfieldHash;
+
+    if (ReferenceEngine == true)
+    {
+        StartComputerPlayerSearch();
+    }
+    else if ( AITransposition->Probe(PlayerData[Player].SearchKey, &PlayerData[Player].BestMoveX, &PlayerData[Player].BestRotation, &cachedValue) == true )
+    {
+        search->RootCount = 0;
+        search->Done = true;
+    }
+    else
+    {
+        /* Only the old plan's best root moves are searched again, on the new stack */
+        AIBitboard[Player]->LoadPlayfieldIfChanged(PlayerData[Player].Playfield);
+        search->Replan(AIBitboard[Player], PlayerData[Player].Piece, PlayerData[Player].NextPiece
+                       , PlayerData[Player].PlayfieldStartX, PlayerData[Player].PlayfieldEndX, PlayerData[Player].PiecePlayfieldY);
+
+        if (PlayerData[Player].AIRollouts == true)  search->StartRollouts(PlayerData[Player].SearchKey);
+
+        PlayerData[Player].BestMoveX = search->BestMoveX;
+        PlayerData[Player].BestRotation = search->BestRotation;
+
+        AIFrameMicrosecondsLeft-=search->MicrosecondsUsed;
+        AISearchReplanNodes+=search->Nodes;
+
+        /* The new plan only gets what is left of this piece's thinking time */
+        search->MicrosecondsUsed+=used;
+    }
+
+    PlayerData[Player].SearchReplanned = true;
+    PlayerData[Player].MovedToBestMove = false;
+    AISearchReplans++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::ContinueComputerPlayerSearch(void)
+{
+Search *search = AISearch[Player];
+Uint32 moveBudget = ( PlayerData[Player].AIMoveBudget > 0 ? PlayerData[Player].AIMoveBudget : AIMoveBudgetMicroseconds[CPUPlayerEnabled & 7] );
+
+    if (search->Done == true)  return;
+
+    if (search->MicrosecondsUsed < moveBudget)
+    {
+        /* Each C.P.U. player gets at most its share of the frame, what the frame has left and what the move has left */
+        Sint32 moveLeft = (Sint32)(moveBudget - search->MicrosecondsUsed);
+        Sint32 share = (AIFrameBudgetMicroseconds / NumberOfPlayers);
+        if (share > moveLeft)  share = moveLeft;
+
+        Sint32 slice = share;
+        if (slice > AIFrameMicrosecondsLeft)  slice = AIFrameMicrosecondsLeft;
+        if (slice <= 0)  return;
+
+        Uint32 nodes = search->Nodes;
+        if (PlayerData[Player].AIRollouts == true)  AIFrameMicrosecondsLeft-=search->ContinueRollouts( AIRollout, (Uint32)slice );
+        else  AIFrameMicrosecondsLeft-=search->Continue( (Uint32)slice );
+
+        if (PlayerData[Player].SearchReplanned == true)  AISearchReplanNodes+=(search->Nodes - nodes);
+
+        PlayerData[Player].BestMoveX = search->BestMoveX;
+        PlayerData[Player].BestRotation = search->BestRotation;
+
+        /* Keep thinking next frame, unless the search is over or could not fit anything in a full share */
+        if ( search->Done == false && (search->Nodes > nodes || slice < share) )  return;
+    }
+
+    AISearchMoves++;
+    AISearchDepthTotal+=search->CompletedDepth;
+    if (PlayerData[Player].SearchReplanned == true)  AISearchReplanDepthTotal+=search->CompletedDepth;
+    PlayerData[Player].AIMoves++;
+    PlayerData[Player].AIMicroseconds+=search->MicrosecondsUsed;
+    if (PlayerData[Player].AIRollouts == true)  AISearchRollouts+=search->RolloutsDone;
+
+    /* Slow is weaker than the greedy A.I., the same position and piece always get the same mistake */
+    if ( (CPUPlayerEnabled == 1 || CPUPlayerEnabled == 6) && PlayerData[Player].AIMoveBudget == 0 && search->RootCount > 1 )
+    {
+        Uint64 mistake = ( PlayerData[Player].SearchKey * 0x9E3779B97F4A7C15ULL );
+        int candidates = ( search->RootCount < AISlowMistakeCandidates ? search->RootCount : AISlowMistakeCandidates );
+
+        if ( ( (mistake >> 32) % AISlowMistakeOneIn ) == 0 )
+        {
+            int move = search->RootMove[ 1 + ( (mistake >> 48) % (candidates-1) ) ];
+
+            PlayerData[Player].BestMoveX = search->Board[0]->MoveX[move];
+            PlayerData[Player].BestRotation = search->Board[0]->MoveRotation[move];
+        }
     }
 
+    AITransposition->Store(PlayerData[Player].SearchKey, PlayerData[Player].BestMoveX, PlayerData[Player].BestRotation
+                           , (search->BestValue == FLT_MAX ? 0 : (int)search->BestValue));
+
+    if (AITrace != NULL)  TraceComputerPlayerMove(search->Board[0]);
+
+    search->Done = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::ComputeComputerPlayerMove(void)
+{
+    if (PlayerData[Player].PlayerStatus != PieceFalling)  return;
+
+    DeletePieceFromPlayfieldMemory(Current);
+
+    /* An attack line pushed the stack up under the falling piece, so plan again for the new surface */
+    if (PlayerData[Player].BestMoveCalculated == true && PlayerData[Player].SearchPlayfieldHash != PlayerData[Player].PlayfieldHash)
+        ReplanComputerPlayerSearch();
+    else if (PlayerData[Player].BestMoveCalculated == false)  StartComputerPlayerSearch();
+
+    ContinueComputerPlayerSearch();
+
     if (PlayerData[Player].MovedToBestMove == false && PlayerData[Player].BestMoveX != -1 && PlayerData[Player].BestRotation != -1)
     {
         if (PlayerData[Player].PieceRotation < PlayerData[Player].BestRotation)  RotatePieceClockwise();
@@ -2296,17 +2728,102 @@ void Logic::ComputeComputerPlayerMove(void)
             MovePieceLeft();
         else if (PlayerData[Player].BestMoveX > PlayerData[Player].PiecePlayfieldX)
             MovePieceRight();
-        else if (PlayerData[Player].PieceRotation == PlayerData[Player].BestRotation)
+        else if (PlayerData[Player].PieceRotation == PlayerData[Player].BestRotation && AISearch[Player]->Done == true)
         {
-            if (CPUPlayerEnabled != 4)  MovePieceDown(true);
+            if (CPUPlayerEnabled != 4)  MovePieceDown();
             PlayerData[Player].MovedToBestMove = true;
         }
     }
     else
     {
-        if (CPUPlayerEnabled != 4)  MovePieceDown(false);
+        if (CPUPlayerEnabled != 4)  MovePieceDown();
         else  MovePieceDownFast();
     }
 }
 
 //-------------------------------------------------------------------------------------------------
+void Logic::TraceComputerPlayerMove(Bitboard *board)
+{
+Trace::TraceRecord *record;
+int startX = PlayerData[Player].PlayfieldStartX;
+
+    if (AITraceLane == -1)  AITraceLane = AITrace->OpenLane();
+    if (AITraceLane == -1)  return;
+
+    record = AITrace->NextRecord(AITraceLane);
+    record->BoardHash = PlayerData[Player].SearchPlayfieldHash;
+    record->Lane = (Uint8)AITraceLane;
+    record->Player = (Uint8)Player;
+    record->Piece = PlayerData[Player].Piece;
+    record->NextPiece = PlayerData[Player].NextPiece;
+    record->Candidates = 0;
+    record->Chosen = TraceNoChoice;
+    record->ChosenX = (Uint8)PlayerData[Player].BestMoveX;
+    record->ChosenRotation = (Uint8)PlayerData[Player].BestRotation;
+
+    /* The placements Search::Start() chooses from, with the features the Gift Of Sight A.I. weighs */
+    for (int move = 0; move < board->MovesCount; move++)
+    {
+        if (board->MoveCollision[move] == true || board->MoveX[move] < (startX-1))  continue;
+
+        Trace::TraceCandidate *candidate = &record->Candidate[record->Candidates];
+        candidate->X = (Uint8)board->MoveX[move];
+        candidate->Rotation = (Uint8)board->MoveRotation[move];
+        candidate->TrappedHoles = (Uint8)board->MoveTrappedHoles[move];
+        candidate->OneBlockCavernHoles = (Uint8)board->MoveOneBlockCavernHoles[move];
+        candidate->PlayfieldBoxEdges = board->MoveBoxEdges[move];
+        candidate->PieceHeight = (Uint8)board->MoveHeight[move];
+        candidate->CompletedLines = (Uint8)board->MoveCompletedLines[move];
+
+        if (board->MoveX[move] == PlayerData[Player].BestMoveX && board->MoveRotation[move] == PlayerData[Player].BestRotation)
+            record->Chosen = record->Candidates;
+
+        record->Candidates++;
+    }
+
+    memset( &record->Candidate[record->Candidates], 0, (TraceCandidates - record->Candidates) * sizeof(Trace::TraceCandidate) );
+
+    AITrace->CommitRecord(AITraceLane);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Logic::UpdateHints(void)
+{
+    /* Only asks and collects, the search itself runs on the hint thread so it never costs frame time */
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        if (DisplayHints == false || PlayerData[player].PlayerInput == CPU || PlayerData[player].PlayerStatus != PieceFalling)
+        {
+            PlayerData[player].HintKey = 0;
+            PlayerData[player].HintReady = false;
+            continue;
+        }
+
+        Uint64 key = ( PlayerData[player].PlayfieldHash ^ ZobristPiece[ PlayerData[player].Piece ]
+                     ^ ZobristNextPiece[ PlayerData[player].NextPiece ] );
+
+        if (key != PlayerData[player].HintKey)
+        {
+            AIHint->Request(player, key, PlayerData[player].Playfield, PlayerData[player].Piece, PlayerData[player].NextPiece
+                            , PlayerData[player].PlayfieldStartX, PlayerData[player].PlayfieldEndX, PlayerData[player].PiecePlayfieldY);
+
+            PlayerData[player].HintKey = key;
+            PlayerData[player].HintReady = false;
+        }
+
+        if (PlayerData[player].HintReady == false)
+            PlayerData[player].HintReady = AIHint->Answer(player, key, &PlayerData[player].HintX, &PlayerData[player].HintRotation, &PlayerData[player].HintY);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Logic::HintCoversBox(int player, int x, int y)
+{
+int boxX = ( x - PlayerData[player].HintX );
+int boxY = ( y - PlayerData[player].HintY );
+
+    if (PlayerData[player].HintReady == false)  return(false);
+    if (boxX < 0 || boxX > 3 || boxY < 0 || boxY > 3)  return(false);
+
+    return( PieceData [PlayerData[player].Piece] [PlayerData[player].HintRotation] [1 + (boxY*4) + boxX] == 1 );
+}
@@ -21,6 +21,14 @@
 #ifndef LOGIC
 #define LOGIC
 
+class Bitboard;
+class Transposition;
+class Search;
+class Neural;
+class Rollout;
+class Hint;
+class Trace;
+
 class Logic
 {
 public:
@@ -123,8 +131,23 @@ public:
 
         Uint8 TwentyLineCounter;
 
-        int SkipAFrameForCPUPieceDrop;
-        int CPUFrame;
+        Uint64 SearchKey;
+        Uint64 SearchPlayfieldHash;  /* The stack BestMoveX/BestRotation were planned for */
+        bool SearchReplanned;
+        bool AIRollouts;  /* Monte Carlo A.I.: the move budget plays out random futures instead of searching deeper */
+        int AIEvaluator;  /* SearchGiftOfSight or SearchNeural, the network is only used once its weights loaded */
+        int AIMaxDepth;
+        Uint32 AIMoveBudget;  /* Microseconds, 0 is the skill's AIMoveBudgetMicroseconds[] */
+        Uint32 AIMoves;
+        Uint64 AIMicroseconds;
+
+        Uint64 PlayfieldHash;
+
+        Uint64 HintKey;  /* Stack, piece and next piece the hint was asked for */
+        bool HintReady;
+        int HintX;
+        int HintRotation;
+        int HintY;
 
         Uint64 Score;
         Uint32 DropBonus;
@@ -201,11 +224,63 @@ public:
 
     Uint8 TileSet;
 
+    Uint32 RandomState;  /* 0 uses rand(), otherwise a per-game xorshift so games running side by side stay reproducible */
+
+    Bitboard *AIBitboard[NumberOfPlayers];
+
+    Uint64 ZobristBox[15][26];
+    Uint64 ZobristPiece[8];
+    Uint64 ZobristRow[26];
+    Uint64 ZobristNextPiece[8];
+    Uint64 ZobristSkill[8];
+    Uint64 ZobristEvaluator[2];
+    Uint64 ZobristRollouts;
+    Uint64 ZobristDepth[4];  /* Indexed by a player's AIMaxDepth */
+
+    Transposition *AITransposition;
+    bool VerifyPlayfieldHash;
+    Uint32 PlayfieldHashMismatches;
+
+    Search *AISearch[NumberOfPlayers];
+    #define AIFrameBudgetMicroseconds   1000  /* Shared by every C.P.U. player, each frame */
+    Uint32 AIMoveBudgetMicroseconds[8];
+    #define AISlowMistakeOneIn          8     /* Slow C.P.U. players misplace about one piece in this many, */
+    #define AISlowMistakeCandidates     3     /* taking one of the greedy A.I.'s next best placements instead */
+    Sint32 AIFrameMicrosecondsLeft;
+    Uint32 AIFrameMicrosecondsMostUsed;
+    Uint32 AISearchMoves;
+    Uint32 AISearchDepthTotal;
+    Uint32 AISearchReplans;
+    Uint32 AISearchReplanNodes;  /* Boards scored by re-plans, so their cost can be measured */
+    Uint32 AISearchReplanDepthTotal;
+
+    Neural *AINeural;
+
+    Rollout *AIRollout;
+    Uint32 AISearchRollouts;
+
+    Hint *AIHint;
+    bool DisplayHints;  /* Shift+H while playing: ghost of the A.I.'s placement for human players' pieces */
+
+    Trace *AITrace;  /* Not owned, NULL unless "--trace" was given */
+    int AITraceLane;
+
+    bool ReferenceEngine;  /* Original cell-by-cell greedy A.I. for every C.P.U. player, the oracle for "--differential" */
+
 	Logic(void);
 	virtual ~Logic(void);
 
+    /* Static, so the headless tools and the C interface get the piece shapes without a Logic */
+    static void FillPieceTables(Uint8 pieceData[8][5][17], Uint8 maxRotation[8], Uint8 dropStartHeight[8]);
 	void InitializePieceData(void);
 
+    int Random(void);
+
+    void InitializeZobristKeys(void);
+    Uint64 ComputePlayfieldHash(int player);
+    void RehashPlayfield(int player);
+    void HashLockedPiece(void);
+
 	void ClearPlayfieldsWithCollisionDetection(void);
 
     void FillPieceBag(int player);
@@ -232,7 +307,7 @@ public:
 
     void CheckForDanger(void);
 
-	void MovePieceDown(bool Force);
+	void MovePieceDown(void);
     void MovePieceDownFast(void);
     void MovePieceDownFastDropAndDrag(void);
 	bool RotatePieceCounterClockwise(void);
@@ -254,7 +329,20 @@ public:
 
     bool CrisisModeClearPlayfield(void);
 
+    void RestartComputerSkillTestPlayer(void);
+
+    void ScoreComputerPlayerMoves(void);
+    void ScoreComputerPlayerMovesReference(void);
+    void ChooseComputerPlayerMoveReference(void);
+    Uint64 ComputerPlayerSearchKey(void);
+    void StartComputerPlayerSearch(void);
+    void ReplanComputerPlayerSearch(void);
+    void ContinueComputerPlayerSearch(void);
     void ComputeComputerPlayerMove(void);
+    void TraceComputerPlayerMove(Bitboard *board);
+
+    void UpdateHints(void);
+    bool HintCoversBox(int player, int x, int y);
 };
 
 #endif
@@ -46,6 +46,15 @@ ________________________________________________________________________________
 #include "audio.h"
 #include "data.h"
 #include "logic.h"
+#include "benchmark.h"
+#include "trainer.h"
+#include "tournament.h"
+#include "differential.h"
+#include "perft.h"
+#include "microbenchmark.h"
+#include "soak.h"
+#include "trace.h"
+#include "assetpack.h"
 
 Visuals *visuals;
 Input *input;
@@ -54,12 +63,131 @@ Interface *interface;
 Audio *audio;
 Data *data;
 Logic *logic;
+AssetPack *assetPack;
 
 //-------------------------------------------------------------------------------------------------
 int main( int argc, char* args[] )
 {
+const char *traceFilename = NULL;
+Trace *trace = NULL;
+int textureBudgetMB = -1;
+Uint64 launchTicks = SDL_GetPerformanceCounter();
+
     printf("''GT-R Twin TurboCharged'' game framework started!\n");
-    argc = argc; args = args;
+
+    /* "--trace [file]" goes before everything else, then the game or tool runs as usual */
+    if (argc > 2 && strcmp(args[1], "--trace") == 0)
+    {
+        traceFilename = args[2];
+        args+=2;
+        argc-=2;
+    }
+
+    /* "--texture-budget [MB]" too, it caps the screen images kept loaded after their screen is left */
+    if (argc > 2 && strcmp(args[1], "--texture-budget") == 0)
+    {
+        textureBudgetMB = atoi(args[2]);
+        args+=2;
+        argc-=2;
+    }
+
+    assetPack = new AssetPack();
+
+    if ( argc > 1 && (strcmp(args[1], "--benchmark") == 0 || strcmp(args[1], "--batch") == 0
+    || strcmp(args[1], "--crisis") == 0 || strcmp(args[1], "--train") == 0 || strcmp(args[1], "--tournament") == 0
+    || strcmp(args[1], "--env") == 0 || strcmp(args[1], "--differential") == 0
+    || strcmp(args[1], "--perft") == 0 || strcmp(args[1], "--micro") == 0 || strcmp(args[1], "--soak") == 0
+    || strcmp(args[1], "--pack") == 0) )
+    {
+        if ( SDL_Init(SDL_INIT_TIMER) != 0 )
+        {
+            printf( "Unable to initialize SDL2: %s\n", SDL_GetError() );
+            return(1);
+        }
+
+        input = new Input();
+        screens = new Screens();
+        audio = new Audio();
+        logic = new Logic();
+
+        if (traceFilename != NULL)
+        {
+            trace = new Trace();
+            if (trace->Open(traceFilename) == true)  logic->AITrace = trace;
+        }
+
+        /* The text cache and the asset packer need a renderer and fonts, the other tools run without a window */
+        visuals = NULL;
+        if ( (strcmp(args[1], "--micro") == 0 || strcmp(args[1], "--soak") == 0 || strcmp(args[1], "--pack") == 0)
+          && SDL_InitSubSystem(SDL_INIT_VIDEO) == 0 )
+        {
+            visuals = new Visuals();
+            if (visuals->CoreFailure == false && visuals->InitializeWindow() == true && visuals->LoadFontsIntoMemory() == true)
+                SDL_HideWindow(visuals->Window);
+            else
+            {
+                delete visuals;
+                visuals = NULL;
+            }
+        }
+
+        Benchmark *benchmark = new Benchmark();
+        Trainer *trainer = new Trainer();
+        Tournament *tournament = new Tournament();
+        bool passed;
+        if (strcmp(args[1], "--batch") == 0 || strcmp(args[1], "--crisis") == 0)
+            passed = benchmark->RunAIBatch( (argc > 2 ? (Uint32)atoi(args[2]) : 100), (argc > 3 ? (Uint32)atoi(args[3]) : 1000000)
+                                           , (argc > 4 ? atoi(args[4]) : 3), (argc > 5 ? atoi(args[5]) : BenchmarkAIGiftOfSight)
+                                           , (strcmp(args[1], "--crisis") == 0 ? CrisisMode : OriginalMode) );
+        else if (strcmp(args[1], "--train") == 0)
+            passed = trainer->Run( (argc > 2 ? atoi(args[2]) : 30), (argc > 3 ? args[3] : "data/ai/Neural-Weights.txt") );
+        else if (strcmp(args[1], "--tournament") == 0)
+            passed = tournament->Run( (argc > 2 ? atoi(args[2]) : 1), (argc > 3 ? (Uint32)atoi(args[3]) : 20000) );
+        else if (strcmp(args[1], "--env") == 0)
+            passed = benchmark->RunEnvironmentBenchmark( (argc > 2 ? atoi(args[2]) : 256), (argc > 3 ? (Uint32)atoi(args[3]) : 10000) );
+        else if (strcmp(args[1], "--differential") == 0)
+        {
+            Differential *differential = new Differential();
+            passed = differential->Run( (argc > 2 ? atoi(args[2]) : 10), (argc > 3 ? (Uint32)atoi(args[3]) : 100000), (argc > 4 ? args[4] : NULL) );
+            delete differential;
+        }
+        else if (strcmp(args[1], "--perft") == 0)
+        {
+            Perft *perft = new Perft();
+            passed = perft->Run( benchmark, (argc > 2 ? atoi(args[2]) : 3), (argc > 3 ? atoi(args[3]) : 8) );
+            delete perft;
+        }
+        else if (strcmp(args[1], "--micro") == 0)
+        {
+            Microbenchmark *microbenchmark = new Microbenchmark();
+            passed = microbenchmark->Run( benchmark, (argc > 2 ? args[2] : "Microbenchmarks.json") );
+            delete microbenchmark;
+        }
+        else if (strcmp(args[1], "--soak") == 0)
+        {
+            Soak *soak = new Soak();
+            passed = soak->Run( (argc > 2 ? (Uint64)strtoull(args[2], NULL, 10) : 100000000), (argc > 3 ? (Uint32)atoi(args[3]) : 1)
+                               , (argc > 4 ? args[4] : "Soak.csv") );
+            delete soak;
+        }
+        else if (strcmp(args[1], "--pack") == 0)
+            passed = assetPack->Pack( (argc > 2 ? args[2] : AssetPackFilename) );
+        else  passed = benchmark->RunAIBenchmark();
+        delete tournament;
+        delete trainer;
+        delete benchmark;
+
+        delete trace;
+        delete visuals;
+        delete logic;
+        delete audio;
+        delete assetPack;
+        delete screens;
+        delete input;
+
+        SDL_Quit();
+        return(passed == true ? 0 : 1);
+    }
 
     if ( SDL_Init(SDL_INIT_TIMER|SDL_INIT_AUDIO|SDL_INIT_VIDEO|SDL_INIT_JOYSTICK|SDL_INIT_HAPTIC|SDL_INIT_GAMECONTROLLER|SDL_INIT_EVENTS) != 0 )
     {
@@ -80,10 +208,15 @@ int main( int argc, char* args[] )
     }
 
     visuals = new Visuals();
+    visuals->LaunchTicks = launchTicks;
+    if (textureBudgetMB >= 0)  visuals->TextureBudgetKB = (Uint32)textureBudgetMB * 1024;
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
     if ( visuals->InitializeWindow() != true ) visuals->CoreFailure = true;
 
+    /* Pre-decoded sprites and sound effects, without the pack everything loads from the loose files */
+    assetPack->Open(AssetPackFilename);
+
     if ( visuals->LoadFontsIntoMemory() != true )  visuals->CoreFailure = true;
     if ( visuals->LoadSpritesAndInitialize() != true )  visuals->CoreFailure = true;
 
@@ -99,6 +232,12 @@ int main( int argc, char* args[] )
 
     logic = new Logic();
 
+    if (traceFilename != NULL)
+    {
+        trace = new Trace();
+        if (trace->Open(traceFilename) == true)  logic->AITrace = trace;
+    }
+
     audio = new Audio();
     audio->SetupAudio();
 
@@ -113,6 +252,7 @@ int main( int argc, char* args[] )
         input->GetAllUserInput();
         visuals->CalculateFramerate();
         screens->ProcessScreenToDisplay();
+        visuals->StreamSpritesIntoMemory(SpriteStreamingBudgetMS);
         visuals->ProcessFramerate();
     }
     if (visuals->CoreFailure == true)  printf("*****ERROR: Game crashed in Main loop*****\n");
@@ -121,6 +261,7 @@ int main( int argc, char* args[] )
 
     data->SaveHighScoresAndOptions();
 
+    delete trace;
     delete logic;
     delete data;
     delete audio;
@@ -128,6 +269,7 @@ int main( int argc, char* args[] )
     delete screens;
     delete input;
     delete visuals;
+    delete assetPack;
     SDL_Quit();
     printf("SDL2 closed.\n");
     printf("''GT-R Twin TurboCharged'' game framework ended!\n");
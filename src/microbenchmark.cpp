@@ -0,0 +1,304 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+#include "SDL_ttf.h"
+
+#include "visuals.h"
+#include "input.h"
+#include "logic.h"
+#include "bitboard.h"
+#include "transposition.h"
+#include "search.h"
+#include "screens.h"
+#include "benchmark.h"
+
+#include "microbenchmark.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define MICROBENCHMARK_RDTSC
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define MICROBENCHMARK_RDTSC
+#endif
+
+extern Visuals* visuals;
+extern Logic* logic;
+extern Screens* screens;
+
+//-------------------------------------------------------------------------------------------------
+Microbenchmark::Microbenchmark(void)
+{
+    Fixtures = NULL;
+    Overhead = 0.0;
+    Results = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Microbenchmark::~Microbenchmark(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint64 Microbenchmark::Cycles(void)
+{
+#ifdef MICROBENCHMARK_RDTSC
+    return( __rdtsc() );
+#else
+    return(0);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+void Microbenchmark::Sort(double *values, int count)
+{
+    for (int index = 1; index < count; index++)
+    {
+        double value = values[index];
+        int slot = index;
+
+        while (slot > 0 && values[slot-1] > value)
+        {
+            values[slot] = values[slot-1];
+            slot--;
+        }
+
+        values[slot] = value;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Microbenchmark::Setup(int operation, int sample, int batch)
+{
+Logic::PlayData *playData = &logic->PlayerData[1];
+
+    if (operation == MicroNothing)  return;
+
+    /* Each sample starts from the next fixture board, outside the timed part */
+    Fixtures->SetupAIFixture(sample % BenchmarkFixtures);
+    logic->Player = 1;
+
+    if (operation == MicroCheckForCompletedLines)
+    {
+        while (logic->PieceCollisionDown() == CollisionNotTrue)  playData->PiecePlayfieldY++;
+    }
+    else if (operation == MicroClearCompletedLines)
+    {
+        for (int y = 22; y < 24; y++)
+            for (int x = 2; x < 12; x++)  playData->Playfield[x][y] = ( 11 + (x % 7) );
+
+        playData->PlayerStatus = ClearingCompletedLines;
+        playData->ClearCompletedLinesTimer = 9;  /* The next call moves the rows down */
+    }
+    else if (operation == MicroAddAnAttackLine)
+    {
+        for (int player = 0; player < NumberOfPlayers; player++)
+        {
+            if (player == 1)  continue;
+
+            memcpy( logic->PlayerData[player].Playfield, playData->Playfield, sizeof(playData->Playfield) );
+            logic->PlayerData[player].Piece = playData->Piece;
+            logic->PlayerData[player].PieceRotation = 1;
+            logic->PlayerData[player].PiecePlayfieldX = 5;
+            logic->PlayerData[player].PiecePlayfieldY = logic->PieceDropStartHeight[playData->Piece];
+            logic->PlayerData[player].PlayerStatus = PieceFalling;
+        }
+
+        for (int x = 0; x < 10; x++)  playData->AttackLines[x][11] = ( x == (sample % 10) ? 0 : 11 + (x % 7) );
+    }
+    else if (operation == MicroComputerPlayerMove)
+    {
+        /* A new piece with nothing cached, the work a C.P.U. player does on the frame a piece appears */
+        logic->CPUPlayerEnabled = 3;
+        logic->AITransposition->Clear();
+        logic->AISearch[1]->NodeBudget = true;
+        logic->AIFrameMicrosecondsLeft = AIFrameBudgetMicroseconds;
+        playData->PlayerInput = CPU;
+        playData->BestMoveCalculated = false;
+        playData->MovedToBestMove = false;
+        logic->AddPieceToPlayfieldMemory(Current);
+    }
+    else if (operation == MicroFillPieceBag)
+    {
+        logic->RandomState = ( 1 + (Uint32)sample );
+    }
+    else if (operation == MicroTextCacheHit)
+    {
+        visuals->DrawTextOntoScreenBuffer("SCORE 0001234", visuals->Font[1], 0, 100, JustifyCenter, 255, 255, 255, 1, 1, 1);
+    }
+    else if (operation == MicroTextCacheMiss)
+    {
+        /* Never drawn before, so every call renders new textures */
+        for (int index = 0; index < batch; index++)  snprintf(MissText[index], sizeof(MissText[index]), "LINES %07i", (sample * batch) + index);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Microbenchmark::Operation(int operation, int batch)
+{
+    for (int index = 0; index < batch; index++)
+    {
+        switch (operation)
+        {
+            case MicroPieceCollision:  logic->PieceCollision();  break;
+            case MicroPieceCollisionDown:  logic->PieceCollisionDown();  break;
+            case MicroPieceCollisionLeft:  logic->PieceCollisionLeft();  break;
+            case MicroPieceCollisionRight:  logic->PieceCollisionRight();  break;
+            case MicroAddPieceToPlayfield:  logic->AddPieceToPlayfieldMemory(Current);  break;
+            case MicroCheckForCompletedLines:  logic->CheckForCompletedLines();  break;
+            case MicroClearCompletedLines:  logic->ClearCompletedLines();  break;
+            case MicroAddAnAttackLine:  logic->AddAnAttackLineToEnemiesPlayfield();  break;
+            case MicroComputerPlayerMove:  logic->ComputeComputerPlayerMove();  break;
+            case MicroFillPieceBag:  logic->FillPieceBag(1);  break;
+
+            case MicroTextCacheHit:
+                visuals->DrawTextOntoScreenBuffer("SCORE 0001234", visuals->Font[1], 0, 100, JustifyCenter, 255, 255, 255, 1, 1, 1);
+                break;
+
+            case MicroTextCacheMiss:
+                visuals->DrawTextOntoScreenBuffer(MissText[index], visuals->Font[1], 0, 100, JustifyCenter, 255, 255, 255, 1, 1, 1);
+                break;
+
+            default:  break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Microbenchmark::Measure(int operation, const char *name, int batch)
+{
+double frequency = (double)SDL_GetPerformanceFrequency();
+
+    for (int sample = 0; sample < MicrobenchmarkSamples; sample++)
+    {
+        Setup(operation, sample, batch);
+
+        Uint64 startTicks = SDL_GetPerformanceCounter();
+        Uint64 startCycles = Cycles();
+        Operation(operation, batch);
+        Uint64 cycles = ( Cycles() - startCycles );
+        Uint64 ticks = ( SDL_GetPerformanceCounter() - startTicks );
+
+        Nanoseconds[sample] = ( ( ((double)ticks * 1000000000.0 / frequency) - Overhead ) / batch );
+        if (Nanoseconds[sample] < 0.0)  Nanoseconds[sample] = 0.0;
+        CycleCounts[sample] = ( (double)cycles / batch );
+
+        if (operation == MicroTextCacheHit || operation == MicroTextCacheMiss)  visuals->ClearScreenBufferWithColor(0, 0, 0, 255);
+    }
+
+    Sort(Nanoseconds, MicrobenchmarkSamples);
+    Sort(CycleCounts, MicrobenchmarkSamples);
+
+    if (operation == MicroNothing)
+    {
+        Overhead = Nanoseconds[MicrobenchmarkSamples / 2];
+        return;
+    }
+
+    ResultName[Results] = name;
+    ResultBatch[Results] = batch;
+    ResultMin[Results] = Nanoseconds[0];
+    ResultMedian[Results] = Nanoseconds[MicrobenchmarkSamples / 2];
+    ResultP99[Results] = Nanoseconds[ (MicrobenchmarkSamples * 99) / 100 ];
+    ResultCycles[Results] = -1.0;
+#ifdef MICROBENCHMARK_RDTSC
+    ResultCycles[Results] = CycleCounts[MicrobenchmarkSamples / 2];
+#endif
+
+    printf("  %-40s %10.1f %10.1f %10.1f %10.0f\n", name, ResultMin[Results], ResultMedian[Results], ResultP99[Results], ResultCycles[Results]);
+    Results++;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Microbenchmark::WriteJSON(const char *filename)
+{
+FILE *file = fopen(filename, "w");
+
+    if (file == NULL)
+    {
+        printf("*****ERROR: Could not write \"%s\"*****\n", filename);
+        return(false);
+    }
+
+    fprintf(file, "{\n  \"version\": %i,\n  \"samples\": %i,\n  \"timer_overhead_ns\": %.1f,\n  \"results\": [\n"
+            , MicrobenchmarkJSONVersion, MicrobenchmarkSamples, Overhead);
+
+    for (int result = 0; result < Results; result++)
+    {
+        fprintf(file, "    { \"name\": \"%s\", \"calls_per_sample\": %i, \"min_ns\": %.1f, \"median_ns\": %.1f, \"p99_ns\": %.1f, \"cycles\": "
+                , ResultName[result], ResultBatch[result], ResultMin[result], ResultMedian[result], ResultP99[result]);
+
+        if (ResultCycles[result] < 0.0)  fprintf(file, "null }");
+        else  fprintf(file, "%.0f }", ResultCycles[result]);
+
+        fprintf(file, "%s\n", (result < Results-1 ? "," : ""));
+    }
+
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+
+    printf("  Results written to \"%s\".\n", filename);
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Microbenchmark::Run(Benchmark *benchmark, const char *filename)
+{
+    Fixtures = benchmark;
+    Results = 0;
+
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+    logic->InitializePieceData();
+
+    printf("Microbenchmarks: %i samples each on the A.I. fixture boards, nanoseconds and cycles per call\n", MicrobenchmarkSamples);
+    printf("  %-40s %10s %10s %10s %10s\n", "", "min", "median", "p99", "cycles");
+
+    Overhead = 0.0;
+    Measure(MicroNothing, "", 1);
+
+    Measure(MicroPieceCollision, "Logic::PieceCollision", 1000);
+    Measure(MicroPieceCollisionDown, "Logic::PieceCollisionDown", 1000);
+    Measure(MicroPieceCollisionLeft, "Logic::PieceCollisionLeft", 1000);
+    Measure(MicroPieceCollisionRight, "Logic::PieceCollisionRight", 1000);
+    Measure(MicroAddPieceToPlayfield, "Logic::AddPieceToPlayfieldMemory", 1000);
+    Measure(MicroCheckForCompletedLines, "Logic::CheckForCompletedLines", 1);
+    Measure(MicroClearCompletedLines, "Logic::ClearCompletedLines", 1);
+    Measure(MicroAddAnAttackLine, "Logic::AddAnAttackLineToEnemiesPlayfield", 1);
+    Measure(MicroComputerPlayerMove, "Logic::ComputeComputerPlayerMove", 1);
+    Measure(MicroFillPieceBag, "Logic::FillPieceBag", 100);
+
+    /* The renderer is only there when a window could be opened */
+    if (visuals != NULL)
+    {
+        visuals->ClearTextCache();
+        Measure(MicroTextCacheHit, "Visuals::DrawTextOntoScreenBuffer hit", 100);
+        Measure(MicroTextCacheMiss, "Visuals::DrawTextOntoScreenBuffer miss", 20);
+        visuals->ClearTextCache();
+    }
+    else  printf("  (No window, the text cache timings are left out.)\n");
+
+    return( WriteJSON(filename) );
+}
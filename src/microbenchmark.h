@@ -0,0 +1,80 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MICROBENCHMARK
+#define MICROBENCHMARK
+
+class Benchmark;
+
+/* Timings of single engine and renderer functions on the A.I. fixture boards: "tc4-tribute3 --micro [JSON file]" */
+/* Every result is min/median/99th percentile nanoseconds and median cycles per call, written as JSON to diff builds */
+class Microbenchmark
+{
+public:
+
+    #define MicrobenchmarkSamples       101  /* Odd, so the median is a sample */
+    #define MicrobenchmarkMaxResults    16
+    #define MicrobenchmarkMaxBatch      1000
+    #define MicrobenchmarkJSONVersion   1
+
+    #define MicroNothing                0  /* Timer overhead, taken off every other sample */
+    #define MicroPieceCollision         1
+    #define MicroPieceCollisionDown     2
+    #define MicroPieceCollisionLeft     3
+    #define MicroPieceCollisionRight    4
+    #define MicroAddPieceToPlayfield    5
+    #define MicroCheckForCompletedLines 6
+    #define MicroClearCompletedLines    7
+    #define MicroAddAnAttackLine        8
+    #define MicroComputerPlayerMove     9
+    #define MicroFillPieceBag           10
+    #define MicroTextCacheHit           11
+    #define MicroTextCacheMiss          12
+
+    Benchmark *Fixtures;
+    char MissText[MicrobenchmarkMaxBatch][32];
+
+    double Overhead;
+    double Nanoseconds[MicrobenchmarkSamples];
+    double CycleCounts[MicrobenchmarkSamples];
+
+    int Results;
+    const char *ResultName[MicrobenchmarkMaxResults];
+    int ResultBatch[MicrobenchmarkMaxResults];
+    double ResultMin[MicrobenchmarkMaxResults];
+    double ResultMedian[MicrobenchmarkMaxResults];
+    double ResultP99[MicrobenchmarkMaxResults];
+    double ResultCycles[MicrobenchmarkMaxResults];  /* -1 without a cycle counter */
+
+	Microbenchmark(void);
+	virtual ~Microbenchmark(void);
+
+    static Uint64 Cycles(void);
+    static void Sort(double *values, int count);
+
+    void Setup(int operation, int sample, int batch);
+    void Operation(int operation, int batch);
+    void Measure(int operation, const char *name, int batch);
+
+    bool WriteJSON(const char *filename);
+    bool Run(Benchmark *benchmark, const char *filename);
+};
+
+#endif
@@ -0,0 +1,426 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "neural.h"
+
+using namespace std;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define NEURAL_X86
+    #define NEURAL_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #define NEURAL_X86
+    #define NEURAL_TARGET_AVX2
+#endif
+
+#define NeuralFileHeader    "T-Crisis4 Neural Evaluator"
+
+//-------------------------------------------------------------------------------------------------
+static inline int BitCount16(Uint16 value)
+{
+    value = value - ((value >> 1) & 0x5555);
+    value = (value & 0x3333) + ((value >> 2) & 0x3333);
+    value = (value + (value >> 4)) & 0x0F0F;
+    return( (value + (value >> 8)) & 0x001F );
+}
+
+//-------------------------------------------------------------------------------------------------
+static inline int CountRowTransitions(Uint16 empty)
+{
+Uint16 filled = ~empty & 0x1FFE;
+
+    /* Walls count as filled, so an empty cell against a wall is a transition */
+    return( BitCount16( (filled ^ (filled >> 1)) & 0x0FFE ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+static inline int CountColumnTransitions(Uint16 empty, Uint16 emptyBelow)
+{
+    return( BitCount16( (empty ^ emptyBelow) & 0x0FFC ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+Neural::Neural(void)
+{
+    Kernel = BestKernel();
+
+    Loaded = false;
+
+    RandomizeWeights(1);
+}
+
+//-------------------------------------------------------------------------------------------------
+Neural::~Neural(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+int Neural::BestKernel(void)
+{
+#ifdef NEURAL_X86
+    if (SDL_HasAVX2() == SDL_TRUE)  return(NeuralKernelAVX2);
+#endif
+
+    return(NeuralKernelScalar);
+}
+
+//-------------------------------------------------------------------------------------------------
+const char *Neural::KernelName(int kernel)
+{
+    if (kernel == NeuralKernelAVX2)  return("AVX2");
+
+    return("Scalar");
+}
+
+//-------------------------------------------------------------------------------------------------
+void Neural::RandomizeWeights(Uint32 seed)
+{
+    /* Xorshift, small symmetric weights so no hidden unit starts out dead */
+    for (int hidden = 0; hidden < NeuralHidden; hidden++)
+    {
+        for (int input = 0; input < NeuralInputs; input++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            Weights1[hidden][input] = ( (float)(seed % 2001) / 1000.0f - 1.0f ) * 0.4f;
+        }
+
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        Weights2[hidden] = ( (float)(seed % 2001) / 1000.0f - 1.0f ) * 0.4f;
+
+        Bias1[hidden] = 0.1f;
+    }
+
+    Bias2 = 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Neural::LoadWeights(const char *filename)
+{
+fstream fileStream;
+char textBuffer[100];
+int inputs = 0;
+int hidden = 0;
+
+    fileStream.open(filename, fstream::in);
+    if (fileStream.is_open() == false)
+    {
+        printf("Neural evaluator weights not found: %s\n", filename);
+        return(false);
+    }
+
+    fileStream.getline(textBuffer, 100);
+    if ( strncmp(textBuffer, NeuralFileHeader, strlen(NeuralFileHeader)) == 0 )
+        sscanf(textBuffer + strlen(NeuralFileHeader), "%i %i", &inputs, &hidden);
+
+    if (inputs != NeuralInputs || hidden != NeuralHidden)
+    {
+        printf("*****ERROR: %s is not a %i-%i-1 neural evaluator*****\n", filename, NeuralInputs, NeuralHidden);
+        fileStream.close();
+        return(false);
+    }
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+        for (int input = 0; input < NeuralInputs; input++)
+        {
+            fileStream.getline(textBuffer, 100);
+            Weights1[unit][input] = (float)atof(textBuffer);
+        }
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+    {
+        fileStream.getline(textBuffer, 100);
+        Bias1[unit] = (float)atof(textBuffer);
+    }
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+    {
+        fileStream.getline(textBuffer, 100);
+        Weights2[unit] = (float)atof(textBuffer);
+    }
+
+    fileStream.getline(textBuffer, 100);
+    Bias2 = (float)atof(textBuffer);
+
+    Loaded = (fileStream.fail() == false);
+    fileStream.close();
+
+    if (Loaded == false)  printf("*****ERROR: %s is too short*****\n", filename);
+
+    return(Loaded);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Neural::SaveWeights(const char *filename)
+{
+fstream fileStream;
+char textBuffer[100];
+
+    fileStream.open(filename, fstream::out);
+    if (fileStream.is_open() == false)  return(false);
+
+    SDL_snprintf(textBuffer, sizeof textBuffer, "%s %i %i\n", NeuralFileHeader, NeuralInputs, NeuralHidden);
+    fileStream<<textBuffer;
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+        for (int input = 0; input < NeuralInputs; input++)
+        {
+            SDL_snprintf(textBuffer, sizeof textBuffer, "%.9g\n", Weights1[unit][input]);
+            fileStream<<textBuffer;
+        }
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+    {
+        SDL_snprintf(textBuffer, sizeof textBuffer, "%.9g\n", Bias1[unit]);
+        fileStream<<textBuffer;
+    }
+
+    for (int unit = 0; unit < NeuralHidden; unit++)
+    {
+        SDL_snprintf(textBuffer, sizeof textBuffer, "%.9g\n", Weights2[unit]);
+        fileStream<<textBuffer;
+    }
+
+    SDL_snprintf(textBuffer, sizeof textBuffer, "%.9g\n", Bias2);
+    fileStream<<textBuffer;
+
+    fileStream.close();
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Neural::ExtractFeatures(NeuralLanes *lanes, Bitboard *board, int landedY, int completedLines, int lane)
+{
+int rowTransitions = 0;
+int columnTransitions = 0;
+
+    for (int x = 2; x < 12; x++)
+    {
+        int top = 24;
+        int holes = 0;
+
+        for (int y = 5; y < 24; y++)
+        {
+            if ( (board->Box[y] >> x) & 1 )
+            {
+                if (top == 24)  top = y;
+            }
+            else if (top < 24 && ( (board->Empty[y] >> x) & 1 ))  holes++;
+        }
+
+        lanes->Input[x-2][lane] = (float)(24 - top) / 20.0f;
+        lanes->Input[x+8][lane] = (float)holes / 20.0f;
+    }
+
+    for (int y = 5; y < 24; y++)
+    {
+        rowTransitions += CountRowTransitions(board->Empty[y]);
+        columnTransitions += CountColumnTransitions(board->Empty[y], board->Empty[y+1]);
+    }
+
+    lanes->Input[20][lane] = (float)rowTransitions / 40.0f;
+    lanes->Input[21][lane] = (float)columnTransitions / 40.0f;
+    lanes->Input[22][lane] = (float)completedLines / 4.0f;
+    lanes->Input[23][lane] = (float)(24 - landedY) / 20.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Neural::LoadBoard(NeuralLanes *lanes, Bitboard *board)
+{
+    /* Column tops and holes are the board's own cached features, only transitions are counted here */
+    if (board->FeaturesValid == false)  board->ComputeBoardFeatures();
+
+    for (int x = 2; x < 12; x++)
+    {
+        lanes->BoardInput[x-2] = (float)(24 - board->ColumnTop[x]) / 20.0f;
+        lanes->BoardInput[x+8] = (float)board->ColumnTrappedHoles[x] / 20.0f;
+    }
+
+    lanes->BoardRowTransitions = 0;
+    lanes->BoardColumnTransitions = 0;
+    for (int y = 5; y < 24; y++)
+    {
+        lanes->RowTransitions[y] = (Uint8)CountRowTransitions(board->Empty[y]);
+        lanes->ColumnTransitions[y] = (Uint8)CountColumnTransitions(board->Empty[y], board->Empty[y+1]);
+
+        lanes->BoardRowTransitions += lanes->RowTransitions[y];
+        lanes->BoardColumnTransitions += lanes->ColumnTransitions[y];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Neural::ExtractMoveFeatures(NeuralLanes *lanes, Bitboard *board, Uint8 piece, int move, int lane)
+{
+int landedY = board->MoveLandedY[move];
+int pieceX = board->MoveX[move];
+int rowTransitions = lanes->BoardRowTransitions;
+int columnTransitions = lanes->BoardColumnTransitions;
+Uint16 placed[6];
+Uint16 empty[6];
+
+    /* Same features as ExtractFeatures() on the board after the placement, which must not complete a line: */
+    /* only the piece's four rows, the row either side of them and the piece's columns can change */
+    for (int row = 0; row < 6; row++)
+    {
+        int y = (landedY - 1 + row);
+
+        placed[row] = ( (row >= 1 && row <= 4) ? (Uint16)(board->PieceRows[piece][ board->MoveRotation[move] ][row-1] << pieceX) : 0 );
+        empty[row] = ( (y >= 0 && y < BitboardRows) ? (Uint16)(board->Empty[y] & ~placed[row]) : 0 );
+    }
+
+    for (int row = 0; row < 5; row++)
+    {
+        int y = (landedY - 1 + row);
+        if (y < 5 || y > 23)  continue;
+
+        if (row > 0)  rowTransitions += CountRowTransitions(empty[row]) - lanes->RowTransitions[y];
+        columnTransitions += CountColumnTransitions(empty[row], empty[row+1]) - lanes->ColumnTransitions[y];
+    }
+
+    for (int input = 0; input < 20; input++)  lanes->Input[input][lane] = lanes->BoardInput[input];
+
+    for (int x = pieceX; x < pieceX+4; x++)
+    {
+        int pieceTop = 24;
+        int pieceBoxes = 0;
+
+        if (x < 2 || x > 11)  continue;
+
+        for (int row = 1; row <= 4; row++)
+        {
+            int y = (landedY - 1 + row);
+            if ( ( (placed[row] >> x) & 1 ) == 0 || y < 5 || y > 23 )  continue;
+
+            if (pieceBoxes == 0)  pieceTop = y;
+            pieceBoxes++;
+        }
+
+        if (pieceBoxes == 0)  continue;
+
+        /* The piece fills empties under the new top, except its own top box when that is the new top */
+        int top = ( pieceTop < board->ColumnTop[x] ? pieceTop : board->ColumnTop[x] );
+        int holes = board->ColumnEmptiesBelow[x][top] - (pieceBoxes - (top == pieceTop ? 1 : 0));
+
+        lanes->Input[x-2][lane] = (float)(24 - top) / 20.0f;
+        lanes->Input[x+8][lane] = (float)holes / 20.0f;
+    }
+
+    lanes->Input[20][lane] = (float)rowTransitions / 40.0f;
+    lanes->Input[21][lane] = (float)columnTransitions / 40.0f;
+    lanes->Input[22][lane] = (float)board->MoveCompletedLines[move] / 4.0f;
+    lanes->Input[23][lane] = (float)(24 - landedY) / 20.0f;
+}
+
+#ifdef NEURAL_X86
+//-------------------------------------------------------------------------------------------------
+NEURAL_TARGET_AVX2 static void EvaluateAVX2(Neural *network, NeuralLanes *lanes, int count)
+{
+    /* Eight placements per register, same operation order as the scalar loop so the results match exactly */
+    for (int lane = 0; lane < count; lane+=8)
+    {
+        __m256 output = _mm256_set1_ps(network->Bias2);
+
+        for (int hidden = 0; hidden < NeuralHidden; hidden++)
+        {
+            __m256 sum = _mm256_set1_ps(network->Bias1[hidden]);
+
+            for (int input = 0; input < NeuralInputs; input++)
+                sum = _mm256_add_ps( sum, _mm256_mul_ps(_mm256_set1_ps(network->Weights1[hidden][input]), _mm256_loadu_ps(&lanes->Input[input][lane])) );
+
+            sum = _mm256_max_ps( sum, _mm256_setzero_ps() );
+            _mm256_storeu_ps(&lanes->Hidden[hidden][lane], sum);
+
+            output = _mm256_add_ps( output, _mm256_mul_ps(_mm256_set1_ps(network->Weights2[hidden]), sum) );
+        }
+
+        _mm256_storeu_ps(&lanes->Output[lane], output);
+    }
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+void Neural::Evaluate(NeuralLanes *lanes, int count)
+{
+#ifdef NEURAL_X86
+    if (Kernel == NeuralKernelAVX2)
+    {
+        EvaluateAVX2( this, lanes, ( (count + 7) & ~7 ) );
+        return;
+    }
+#endif
+
+    for (int lane = 0; lane < count; lane++)
+    {
+        float output = Bias2;
+
+        for (int hidden = 0; hidden < NeuralHidden; hidden++)
+        {
+            float sum = Bias1[hidden];
+
+            for (int input = 0; input < NeuralInputs; input++)  sum = sum + (Weights1[hidden][input] * lanes->Input[input][lane]);
+
+            if (sum < 0.0f)  sum = 0.0f;
+            lanes->Hidden[hidden][lane] = sum;
+
+            output = output + (Weights2[hidden] * sum);
+        }
+
+        lanes->Output[lane] = output;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+float Neural::TrainLane(NeuralLanes *lanes, int lane, float target, float learningRate)
+{
+float error;
+
+    /* One step of gradient descent on the squared error, Evaluate() must have been run on this lane */
+    error = lanes->Output[lane] - target;
+
+    for (int hidden = 0; hidden < NeuralHidden; hidden++)
+    {
+        float gradient = error * Weights2[hidden];
+
+        Weights2[hidden]-=learningRate * error * lanes->Hidden[hidden][lane];
+
+        if (lanes->Hidden[hidden][lane] <= 0.0f)  continue;
+
+        for (int input = 0; input < NeuralInputs; input++)  Weights1[hidden][input]-=learningRate * gradient * lanes->Input[input][lane];
+        Bias1[hidden]-=learningRate * gradient;
+    }
+
+    Bias2-=learningRate * error;
+
+    return(error * error);
+}
@@ -0,0 +1,79 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef NEURAL
+#define NEURAL
+
+struct NeuralLanes;
+
+/* Small multilayer perceptron that scores a playfield after a placement, lower is better */
+/* Weights are only read while evaluating, so searches on several threads can share one network */
+class Neural
+{
+public:
+
+    #define NeuralInputs            24  /* Column heights and holes, row and column transitions, lines, landing row */
+    #define NeuralHidden            16
+    #define NeuralMaxLanes          BitboardMaxMoves
+
+    #define NeuralKernelScalar      0
+    #define NeuralKernelAVX2        1
+    int Kernel;
+
+    bool Loaded;
+
+    float Weights1[NeuralHidden][NeuralInputs];
+    float Bias1[NeuralHidden];
+    float Weights2[NeuralHidden];
+    float Bias2;
+
+	Neural(void);
+	virtual ~Neural(void);
+
+    int BestKernel(void);
+    const char *KernelName(int kernel);
+
+    void RandomizeWeights(Uint32 seed);
+    bool LoadWeights(const char *filename);
+    bool SaveWeights(const char *filename);
+
+    void ExtractFeatures(NeuralLanes *lanes, Bitboard *board, int landedY, int completedLines, int lane);
+    void LoadBoard(NeuralLanes *lanes, Bitboard *board);
+    void ExtractMoveFeatures(NeuralLanes *lanes, Bitboard *board, Uint8 piece, int move, int lane);
+    void Evaluate(NeuralLanes *lanes, int count);
+    float TrainLane(NeuralLanes *lanes, int lane, float target, float learningRate);
+};
+
+/* Features, hidden units and scores of one batch of placements, each evaluator owns its own */
+struct NeuralLanes
+{
+    float Input[NeuralInputs][NeuralMaxLanes];
+    float Hidden[NeuralHidden][NeuralMaxLanes];
+    float Output[NeuralMaxLanes];
+
+    /* The board the placements are made on, so a placement only recounts its own rows and columns */
+    float BoardInput[20];  /* Column heights and holes */
+    Uint8 RowTransitions[BitboardRows];
+    Uint8 ColumnTransitions[BitboardRows];  /* Between row Y and row Y+1 */
+    int BoardRowTransitions;
+    int BoardColumnTransitions;
+};
+
+#endif
@@ -0,0 +1,286 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "logic.h"
+#include "benchmark.h"
+
+#include "perft.h"
+
+extern Logic* logic;
+
+//-------------------------------------------------------------------------------------------------
+Perft::Perft(void)
+{
+    Positions = 0;
+    for (int position = 0; position < PerftMaxPositions; position++)  Position[position] = NULL;
+
+    for (int thread = 0; thread < PerftMaxThreads; thread++)
+        for (int ply = 0; ply < PerftMaxDepth; ply++)  Board[thread][ply] = new Bitboard();
+
+    Threads = 1;
+    Depth = 1;
+    Jobs = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Perft::~Perft(void)
+{
+    for (int thread = 0; thread < PerftMaxThreads; thread++)
+        for (int ply = 0; ply < PerftMaxDepth; ply++)  delete Board[thread][ply];
+
+    for (int position = 0; position < PerftMaxPositions; position++)  delete Position[position];
+}
+
+//-------------------------------------------------------------------------------------------------
+void Perft::SetupPosition(Benchmark *benchmark, int position)
+{
+    /* The A.I. benchmark's fixture board, raised toward the spawn rows with overhangs under the surface */
+    benchmark->SetupAIFixture(position);
+
+    for (int x = 2; x < 12; x++)
+    {
+        int top = ( PerftHighestTop + (benchmark->FixtureRandom() % (24 - PerftHighestTop)) );
+
+        for (int y = top; y < 24; y++)
+        {
+            if (logic->PlayerData[1].Playfield[x][y] == 0 && (benchmark->FixtureRandom() % 4) != 0)
+                logic->PlayerData[1].Playfield[x][y] = ( 11 + (benchmark->FixtureRandom() % 7) );
+        }
+    }
+
+    /* A full row would have been cleared */
+    for (int y = PerftHighestTop; y < 24; y++)
+    {
+        bool full = true;
+        for (int x = 2; x < 12; x++)
+            if (logic->PlayerData[1].Playfield[x][y] == 0)  full = false;
+
+        if (full == true)  logic->PlayerData[1].Playfield[ 2 + (benchmark->FixtureRandom() % 10) ][y] = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint64 Perft::PlacementHash(Uint8 piece, int x, int rotation, int landedY)
+{
+Uint64 hash = ( ( (Uint64)piece << 24 ) | ( (Uint64)x << 16 ) | ( (Uint64)rotation << 8 ) | (Uint64)landedY );
+
+    /* Mixed before it is summed, so different landing rows cannot cancel out */
+    hash = ( (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL );
+    hash = ( (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL );
+    return( hash ^ (hash >> 31) );
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint64 Perft::Count(Bitboard **boards, int ply, int depth, Uint8 bag, Uint64 *checksum)
+{
+Bitboard *board = boards[ply];
+Uint64 nodes = 0;
+
+    if (bag == 0)  bag = PerftFullBag;
+
+    for (Uint8 piece = 1; piece < 8; piece++)
+    {
+        if ( (bag & (1 << piece)) == 0 )  continue;
+
+        int lanes = board->GenerateMoves(piece, MaxRotation[piece], PerftStartX, PerftEndX, StartY[piece]);
+
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            int move = board->LaneMove[lane];
+            if (board->MoveX[move] < (PerftStartX-1))  continue;
+
+            /* The last ply is only counted, the way perft counts leaves in bulk */
+            if (depth == 1)
+            {
+                nodes++;
+                *checksum+=PlacementHash(piece, board->MoveX[move], board->MoveRotation[move], board->MoveLandedY[move]);
+            }
+            else
+            {
+                boards[ply+1]->LoadPlacement(board, piece, move);
+                nodes+=Count( boards, ply+1, depth-1, (Uint8)(bag & ~(1 << piece)), checksum );
+            }
+        }
+    }
+
+    return(nodes);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Perft::RunJob(int thread, int job)
+{
+Bitboard **boards = Board[thread];
+int position = (job / 7);
+Uint8 piece = (Uint8)( 1 + (job % 7) );
+Uint64 nodes = 0;
+Uint64 checksum = 0;
+
+    boards[0]->CopyPlayfield(Position[position]);
+    int lanes = boards[0]->GenerateMoves(piece, MaxRotation[piece], PerftStartX, PerftEndX, StartY[piece]);
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        int move = boards[0]->LaneMove[lane];
+        if (boards[0]->MoveX[move] < (PerftStartX-1))  continue;
+
+        if (Depth == 1)
+        {
+            nodes++;
+            checksum+=PlacementHash(piece, boards[0]->MoveX[move], boards[0]->MoveRotation[move], boards[0]->MoveLandedY[move]);
+        }
+        else
+        {
+            boards[1]->LoadPlacement(boards[0], piece, move);
+            nodes+=Count( boards, 1, Depth-1, (Uint8)(PerftFullBag & ~(1 << piece)), &checksum );
+        }
+    }
+
+    JobNodes[job] = nodes;
+    JobChecksum[job] = checksum;
+}
+
+//-------------------------------------------------------------------------------------------------
+int Perft::WorkerThread(void *data)
+{
+Perft *perft = (Perft*)data;
+int thread = SDL_AtomicAdd(&perft->WorkerIndex, 1);
+int job;
+
+    while ( (job = SDL_AtomicAdd(&perft->NextJob, 1)) < perft->Jobs )  perft->RunJob(thread, job);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+double Perft::RunThreads(int threads)
+{
+SDL_Thread *worker[PerftMaxThreads];
+Uint64 startTicks;
+int job;
+
+    SDL_AtomicSet(&WorkerIndex, 1);
+    SDL_AtomicSet(&NextJob, 0);
+
+    startTicks = SDL_GetPerformanceCounter();
+    for (int thread = 1; thread < threads; thread++)  worker[thread] = SDL_CreateThread(WorkerThread, "Perft", this);
+
+    while ( (job = SDL_AtomicAdd(&NextJob, 1)) < Jobs )  RunJob(0, job);
+
+    for (int thread = 1; thread < threads; thread++)  SDL_WaitThread(worker[thread], NULL);
+
+    return( (double)(SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency() );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Perft::Run(Benchmark *benchmark, int depth, int positions)
+{
+Uint64 reference[PerftMaxPositions * 7];
+Uint64 referenceChecksum[PerftMaxPositions * 7];
+Uint64 total = 0;
+double oneThreadRate = 0.0;
+int mismatches = 0;
+int cpus = SDL_GetCPUCount();
+
+    if (depth < 1)  depth = 1;
+    if (depth > PerftMaxDepth)  depth = PerftMaxDepth;
+    if (positions < 1)  positions = 1;
+    if (positions > PerftMaxPositions)  positions = PerftMaxPositions;
+
+    Depth = depth;
+    Positions = positions;
+    Jobs = (Positions * 7);
+
+    logic->InitializePieceData();
+    for (int piece = 0; piece < 8; piece++)
+    {
+        MaxRotation[piece] = logic->MaxRotationArray[piece];
+        StartY[piece] = logic->PieceDropStartHeight[piece];
+    }
+
+    for (int thread = 0; thread < PerftMaxThreads; thread++)
+        for (int ply = 0; ply < PerftMaxDepth; ply++)  Board[thread][ply]->LoadPieceData(logic->PieceData);
+
+    for (int position = 0; position < Positions; position++)
+    {
+        SetupPosition(benchmark, position);
+
+        if (Position[position] == NULL)  Position[position] = new Bitboard();
+        Position[position]->LoadPlayfield(logic->PlayerData[1].Playfield);
+    }
+
+    printf("Placement perft: depth %i from a fresh 7-bag, %i positions, %i logical CPUs\n", Depth, Positions, cpus);
+
+    /* One thread, then twice as many each time up to every CPU, always at least two so the threaded count is checked */
+    for (int threads = 1; threads <= cpus || threads <= 2; threads*=2)
+    {
+        if (threads > PerftMaxThreads)  break;
+
+        double seconds = RunThreads(threads);
+
+        Uint64 nodes = 0;
+        for (int job = 0; job < Jobs; job++)
+        {
+            nodes+=JobNodes[job];
+
+            if (threads == 1)
+            {
+                reference[job] = JobNodes[job];
+                referenceChecksum[job] = JobChecksum[job];
+            }
+            else if (JobNodes[job] != reference[job] || JobChecksum[job] != referenceChecksum[job])  mismatches++;
+        }
+
+        if (threads == 1)
+        {
+            total = nodes;
+
+            for (int position = 0; position < Positions; position++)
+            {
+                Uint64 positionNodes = 0;
+                Uint64 positionChecksum = 0;
+                for (int piece = 0; piece < 7; piece++)
+                {
+                    positionNodes+=reference[ (position * 7) + piece ];
+                    positionChecksum+=referenceChecksum[ (position * 7) + piece ];
+                }
+
+                printf("  Position %2i: %12llu  checksum %016llx\n", position + 1, (unsigned long long)positionNodes, (unsigned long long)positionChecksum);
+            }
+        }
+
+        double rate = ( (double)nodes / seconds );
+        if (threads == 1)  oneThreadRate = rate;
+
+        printf("  %2i thread%s: %llu placements in %.2f s, %10.0f placements per second (%.2fx)\n", threads, (threads == 1 ? " " : "s")
+               , (unsigned long long)nodes, seconds, rate, rate / oneThreadRate);
+    }
+
+    if (mismatches > 0)  printf("*****ERROR: %i threaded counts or checksums differ from the single threaded ones*****\n", mismatches);
+    else  printf("  Total: %llu placements, the same at every thread count.\n", (unsigned long long)total);
+
+    return(mismatches == 0);
+}
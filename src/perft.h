@@ -0,0 +1,70 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PERFT
+#define PERFT
+
+class Bitboard;
+class Benchmark;
+
+/* Move generator throughput like a chess engine's perft: "tc4-tribute3 --perft [depth] [positions]" */
+/* Counts every resting placement of every piece order a fresh 7-bag can deal, to depth pieces deep */
+class Perft
+{
+public:
+
+    #define PerftMaxDepth       6
+    #define PerftMaxPositions   64
+    #define PerftMaxThreads     16
+    #define PerftStartX         2   /* Same columns the C.P.U. player searches */
+    #define PerftEndX           12
+    #define PerftFullBag        0xFE  /* Bit N = piece N still in the bag */
+    #define PerftHighestTop     6     /* Stacks reach up to here, into the rows pieces spawn in */
+
+    int Positions;
+    Bitboard *Position[PerftMaxPositions];
+    Uint8 MaxRotation[8];
+    Uint8 StartY[8];
+
+    int Threads;
+    Bitboard *Board[PerftMaxThreads][PerftMaxDepth];
+
+    /* One job per position and first piece, so every thread count adds up the same numbers */
+    int Depth;
+    int Jobs;
+    Uint64 JobNodes[PerftMaxPositions * 7];
+    Uint64 JobChecksum[PerftMaxPositions * 7];  /* Of where every counted placement came to rest */
+    SDL_atomic_t NextJob;
+    SDL_atomic_t WorkerIndex;
+
+	Perft(void);
+	virtual ~Perft(void);
+
+    void SetupPosition(Benchmark *benchmark, int position);
+    static Uint64 PlacementHash(Uint8 piece, int x, int rotation, int landedY);
+    Uint64 Count(Bitboard **boards, int ply, int depth, Uint8 bag, Uint64 *checksum);
+    void RunJob(int thread, int job);
+    static int WorkerThread(void *data);
+    double RunThreads(int threads);
+
+    bool Run(Benchmark *benchmark, int depth, int positions);
+};
+
+#endif
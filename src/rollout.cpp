@@ -0,0 +1,303 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
+
+//-------------------------------------------------------------------------------------------------
+Rollout::Rollout(void)
+{
+    Lock = SDL_CreateMutex();
+    WorkReady = SDL_CreateCond();
+    WorkDone = SDL_CreateCond();
+
+    for (int worker = 0; worker < RolloutMaxThreads; worker++)
+    {
+        Worker[worker] = NULL;
+        Board[worker] = new Bitboard();
+        Scratch[worker] = new Bitboard();
+    }
+
+    Job = NULL;
+    JobFirst = 0;
+    JobCount = 0;
+    SDL_AtomicSet(&JobNext, 0);
+
+    /* Run() works alone until StartThreadsIfNeeded(), most games never use Monte Carlo mode */
+    Threads = 1;
+    ThreadsStarted = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+Rollout::~Rollout(void)
+{
+    StopThreads();
+
+    for (int worker = 0; worker < RolloutMaxThreads; worker++)
+    {
+        delete Board[worker];
+        delete Scratch[worker];
+    }
+
+    SDL_DestroyCond(WorkDone);
+    SDL_DestroyCond(WorkReady);
+    SDL_DestroyMutex(Lock);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::StartThreads(int threads)
+{
+    if (threads < 1)  threads = 1;
+    else if (threads > RolloutMaxThreads)  threads = RolloutMaxThreads;
+
+    Threads = threads;
+    ThreadsStarted = true;
+    Batch = 0;
+    WorkersBusy = 0;
+    Quit = false;
+
+    /* Worker 0 is whoever calls Run(), it works instead of waiting */
+    SDL_AtomicSet(&WorkerIndex, 1);
+    for (int worker = 1; worker < Threads; worker++)  Worker[worker] = SDL_CreateThread(WorkerThread, "Rollout", this);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::StopThreads(void)
+{
+    SDL_LockMutex(Lock);
+    Quit = true;
+    SDL_CondBroadcast(WorkReady);
+    SDL_UnlockMutex(Lock);
+
+    for (int worker = 1; worker < Threads; worker++)
+    {
+        SDL_WaitThread(Worker[worker], NULL);
+        Worker[worker] = NULL;
+    }
+
+    Threads = 1;
+    ThreadsStarted = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::StartThreadsIfNeeded(void)
+{
+    if (ThreadsStarted == false)  StartThreads( SDL_GetCPUCount() );
+}
+
+//-------------------------------------------------------------------------------------------------
+int Rollout::WorkerThread(void *data)
+{
+Rollout *pool = (Rollout*)data;
+int worker = SDL_AtomicAdd(&pool->WorkerIndex, 1);
+Uint32 batch = 0;
+
+    SDL_LockMutex(pool->Lock);
+
+    while (true)
+    {
+        while (pool->Quit == false && pool->Batch == batch)  SDL_CondWait(pool->WorkReady, pool->Lock);
+        if (pool->Quit == true)  break;
+
+        batch = pool->Batch;
+        SDL_UnlockMutex(pool->Lock);
+
+        pool->PlayBatch(worker);
+
+        SDL_LockMutex(pool->Lock);
+        pool->WorkersBusy--;
+        if (pool->WorkersBusy == 0)  SDL_CondSignal(pool->WorkDone);
+    }
+
+    SDL_UnlockMutex(pool->Lock);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8])
+{
+    for (int worker = 0; worker < RolloutMaxThreads; worker++)
+    {
+        Board[worker]->LoadPieceData(pieceData);
+        Scratch[worker]->LoadPieceData(pieceData);
+    }
+
+    for (int piece = 0; piece < 8; piece++)  MaxRotation[piece] = maxRotation[piece];
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Rollout::AddAttackLine(Bitboard *board, Uint64 *random)
+{
+    /* Like Logic::AddAnAttackLineToEnemiesPlayfield(): an enemy's completed line, minus the piece that completed it */
+    if ( (board->Box[5] & 0x0FFC) != 0 )  return(false);
+
+    for (int y = 5; y < 23; y++)
+    {
+        board->Box[y] = board->Box[y+1];
+        board->Empty[y] = board->Empty[y+1];
+    }
+
+    *random ^= *random << 13;
+    *random ^= *random >> 7;
+    *random ^= *random << 17;
+
+    int holes = ( 1 + (int)( (*random >> 8) % 3 ) );
+    int holeX = ( 2 + (int)( (*random >> 16) % (11 - holes) ) );
+    Uint16 holeMask = ( ( (1 << holes) - 1 ) << holeX );
+
+    board->Box[23] = (0x0FFC & ~holeMask);
+    board->Empty[23] = holeMask;
+
+    board->BoxesChanged();
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+float Rollout::Play(int worker, Uint32 rollout)
+{
+Search *search = Job;
+Bitboard *board = Board[worker];
+Bitboard *scratch = Scratch[worker];
+int candidate = (rollout % search->RolloutCandidates);
+int move = search->RootMove[candidate];
+Uint64 random;
+Uint8 bag[7];
+int bagIndex = 7;
+Uint8 piece = search->NextPiece;
+float lines;
+
+    /* Every candidate of a round sees the same pieces and attack lines, so they are compared fairly */
+    random = search->RolloutSeed + ( (Uint64)(rollout / search->RolloutCandidates) * 0x9E3779B97F4A7C15ULL );
+    random = (random ^ (random >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    random = (random ^ (random >> 27)) * 0x94D049BB133111EBULL;
+    random = (random ^ (random >> 31)) | 1;
+
+    board->Kernel = search->Board[0]->Kernel;
+    scratch->Kernel = search->Board[0]->Kernel;
+
+    board->LoadPlacement(search->Board[0], search->Piece, move);
+    lines = search->Board[0]->MoveCompletedLines[move];
+
+    for (int pieces = 0; pieces < RolloutPieces; pieces++)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+
+        if (pieces > 0)
+        {
+            if (bagIndex == 7)
+            {
+                for (int index = 0; index < 7; index++)  bag[index] = (index + 1);
+
+                for (int index = 6; index > 0; index--)
+                {
+                    int swap = (int)( (random >> (index * 4)) % (index+1) );
+                    Uint8 temp = bag[index];
+                    bag[index] = bag[swap];
+                    bag[swap] = temp;
+                }
+
+                bagIndex = 0;
+            }
+
+            piece = bag[bagIndex];
+            bagIndex++;
+        }
+
+        if ( (random >> 40) % RolloutAttackOneIn == 0 && AddAttackLine(board, &random) == false )  return(lines - RolloutLostCost);
+
+        /* The rollout policy is the plain greedy A.I. */
+        board->ScoreAllMoves(piece, MaxRotation[piece], search->StartX, search->EndX, SearchLookaheadStartY);
+
+        int bestMove = -1;
+        float bestValue = 0.0f;
+        for (int reply = 0; reply < board->MovesCount; reply++)
+        {
+            if (board->MoveCollision[reply] == true || board->MoveX[reply] < (search->StartX-1))  continue;
+
+            float value = Search::GiftOfSightValue(board, reply);
+            if (bestMove == -1 || value <= bestValue)
+            {
+                bestMove = reply;
+                bestValue = value;
+            }
+        }
+
+        if (bestMove == -1)  return(lines - RolloutLostCost);
+
+        lines+=board->MoveCompletedLines[bestMove];
+        scratch->LoadPlacement(board, piece, bestMove);
+        board->CopyPlayfield(scratch);
+    }
+
+    for (int y = 5; y < 24; y++)
+        if ( (board->Box[y] & 0x0FFC) != 0 )  return( lines - (RolloutHeightCost * (24 - y)) );
+
+    return(lines);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::PlayBatch(int worker)
+{
+int index;
+
+    while ( (index = SDL_AtomicAdd(&JobNext, 1)) < JobCount )  Result[index] = Play(worker, JobFirst + index);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Rollout::Run(Search *search, Uint32 first, int count)
+{
+    if (count > RolloutMaxBatch)  count = RolloutMaxBatch;
+
+    Job = search;
+    JobFirst = first;
+    JobCount = count;
+    SDL_AtomicSet(&JobNext, 0);
+
+    /* Each result has its own slot and its own random numbers, so the thread count never changes the answer */
+    if (Threads > 1)
+    {
+        SDL_LockMutex(Lock);
+        Batch++;
+        WorkersBusy = (Threads - 1);
+        SDL_CondBroadcast(WorkReady);
+        SDL_UnlockMutex(Lock);
+    }
+
+    PlayBatch(0);
+
+    if (Threads > 1)
+    {
+        SDL_LockMutex(Lock);
+        while (WorkersBusy > 0)  SDL_CondWait(WorkDone, Lock);
+        SDL_UnlockMutex(Lock);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ROLLOUT
+#define ROLLOUT
+
+class Bitboard;
+class Search;
+
+/* Thread pool for the Monte Carlo A.I.: plays short random futures of a search's best placements */
+class Rollout
+{
+public:
+
+    #define RolloutMaxThreads           16
+    #define RolloutMaxBatch             1024
+    #define RolloutMaxCandidates        4       /* Only the greedy A.I.'s best few placements are played out */
+    #define RolloutsPerMove             512
+    #define RolloutPieces               6       /* Pieces played after the placement, the first is the known next piece */
+    #define RolloutAttackOneIn          6       /* A Crisis mode attack line arrives about this often per piece */
+    #define RolloutLostCost             50.0f
+    #define RolloutHeightCost           0.25f   /* Per row of stack left at the end, so surviving low beats surviving high */
+    #define RolloutConfidence           1.0f    /* Standard errors a gain over the greedy move must clear... */
+    #define RolloutMinimumRounds        4       /* ...after at least this many rounds */
+    #define RolloutNominalMicroseconds  18      /* Charged per rollout instead of the clock when a search has NodeBudget set */
+
+    int Threads;  /* Including the thread that calls Run() */
+    bool ThreadsStarted;  /* Only once Monte Carlo mode is first used */
+    SDL_Thread *Worker[RolloutMaxThreads];
+    SDL_atomic_t WorkerIndex;
+    Bitboard *Board[RolloutMaxThreads];
+    Bitboard *Scratch[RolloutMaxThreads];
+    Uint8 MaxRotation[8];
+
+    SDL_mutex *Lock;
+    SDL_cond *WorkReady;
+    SDL_cond *WorkDone;
+    Uint32 Batch;
+    int WorkersBusy;
+    bool Quit;
+
+    Search *Job;
+    Uint32 JobFirst;
+    int JobCount;
+    SDL_atomic_t JobNext;
+    float Result[RolloutMaxBatch];
+
+	Rollout(void);
+	virtual ~Rollout(void);
+
+    void StartThreads(int threads);
+    void StopThreads(void);
+    void StartThreadsIfNeeded(void);
+    static int WorkerThread(void *data);
+
+    void LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8]);
+
+    bool AddAttackLine(Bitboard *board, Uint64 *random);
+    float Play(int worker, Uint32 rollout);
+    void PlayBatch(int worker);
+    void Run(Search *search, Uint32 first, int count);
+};
+
+#endif
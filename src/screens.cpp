@@ -35,6 +35,11 @@
 #include "interface.h"
 #include "data.h"
 #include "logic.h"
+#include "transposition.h"
+#include "bitboard.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
 #include "audio.h"
 
 extern Input* input;
@@ -51,6 +56,10 @@ Screens::Screens(void)
 
     ScreenToDisplay = CNETScreen;
 
+    AssetsScreen = -1;
+    AssetSpritesCount = 0;
+    PrefetchSpritesCount = 0;
+
     ScreenFadeTransparency = 255;
     ScreenTransitionStatus = FadeAll;
 }
@@ -61,6 +70,152 @@ Screens::~Screens(void)
 
 }
 
+//-------------------------------------------------------------------------------------------------
+int Screens::GetScreenSprites(int screen, int sprites[MaxScreenSprites])
+{
+int count = 0;
+
+    /* Only sprites Visuals::SpriteLoadsOnDemand() covers, everything else is always loaded */
+    switch(screen)
+    {
+        case TitleScreen:
+            sprites[count++] = 3;
+            break;
+
+        case HowToPlayScreen:
+            sprites[count++] = 4;
+            break;
+
+        case AboutScreen:
+            sprites[count++] = 11;
+            sprites[count++] = 13;
+            sprites[count++] = 14;
+            sprites[count++] = 15;
+            sprites[count++] = 17;
+            sprites[count++] = 75;
+            break;
+
+        case NewGameOptionsScreen:
+            sprites[count++] = 100+logic->SelectedBackground;
+            sprites[count++] = 108;
+            break;
+
+        case PlayingGameScreen:
+            sprites[count++] = 100+logic->SelectedBackground;
+            break;
+
+        case PlayingStoryGameScreen:
+            sprites[count++] = 108;
+            break;
+
+        case ShowStoryScreen:
+            sprites[count++] = 70;
+            sprites[count++] = 71;
+            sprites[count++] = 72;
+            sprites[count++] = 73;
+            sprites[count++] = 75;
+            break;
+
+        case FlyingFromEarthScreen:
+            sprites[count++] = 39;
+            sprites[count++] = 42;
+            sprites[count++] = 43;
+            break;
+
+        case FlyingToMarsScreen:
+            sprites[count++] = 39;
+            sprites[count++] = 40;
+            sprites[count++] = 41;
+            break;
+
+        case FlyingToBaseScreen:
+            sprites[count++] = 41;
+            sprites[count++] = 73;
+            break;
+
+        case MarsExplodingScreen:
+            sprites[count++] = 39;
+            sprites[count++] = 40;
+            sprites[count++] = 43;
+            sprites[count++] = 44;
+            break;
+
+        default:
+            break;
+    }
+
+    return(count);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Screens::LikelyNextScreen(int screen)
+{
+    switch(screen)
+    {
+        case CNETScreen:
+            return(SDLLogoScreen);
+
+        case TitleScreen:
+            return(NewGameOptionsScreen);
+
+        case NewGameOptionsScreen:
+            if (logic->GameMode == StoryMode)  return(ShowStoryScreen);
+            return(PlayingGameScreen);
+
+        case PlayingGameScreen:
+            return(HighScoresScreen);
+
+        case ShowStoryScreen:
+        case FlyingToMarsScreen:
+        case FlyingToBaseScreen:
+            return(PlayingStoryGameScreen);
+
+        case PlayingStoryGameScreen:
+        case MarsExplodingScreen:
+            return(ShowStoryScreen);
+
+        case FlyingFromEarthScreen:
+            return(FlyingToMarsScreen);
+
+        default:
+            break;
+    }
+
+    return(TitleScreen);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Screens::SwitchScreenAssets(int screen)
+{
+int sprites[MaxScreenSprites];
+int prefetch[MaxScreenSprites];
+int count;
+int prefetchCount;
+int imagesQueued = visuals->ImagesCached;
+
+    /* The new references are taken before the old ones are dropped, so sprites both screens use never unload */
+    count = GetScreenSprites(screen, sprites);
+    for (int index = 0; index < count; index++)  visuals->AcquireSprite(sprites[index]);
+
+    prefetchCount = GetScreenSprites(LikelyNextScreen(screen), prefetch);
+    for (int index = 0; index < prefetchCount; index++)  visuals->PrefetchSprite(prefetch[index]);
+    if (visuals->ImagesCached > imagesQueued)  visuals->StartImageDecoding();
+
+    for (int index = 0; index < AssetSpritesCount; index++)  visuals->ReleaseSprite(AssetSprites[index]);
+    for (int index = 0; index < PrefetchSpritesCount; index++)  visuals->ReleaseSprite(PrefetchSprites[index]);
+
+    for (int index = 0; index < count; index++)  AssetSprites[index] = sprites[index];
+    for (int index = 0; index < prefetchCount; index++)  PrefetchSprites[index] = prefetch[index];
+    AssetSpritesCount = count;
+    PrefetchSpritesCount = prefetchCount;
+    AssetsScreen = screen;
+
+    visuals->EvictSprites();
+
+    /* Only the playing screens draw through the static layer, the others give its full screen target back */
+    if (screen != PlayingGameScreen && screen != PlayingStoryGameScreen)  visuals->InvalidateStaticLayer();
+}
+
 //-------------------------------------------------------------------------------------------------
 void Screens::ApplyScreenFadeTransition(void)
 {
@@ -115,6 +270,15 @@ int windowHeight;
 
     if (input->DEBUG > 0)  ScreenIsDirty = 2;
 
+    /* Only the logo screens show while sprites and audio still stream in, the rest waits for all of it */
+    if (ScreenToDisplay != CNETScreen && ScreenToDisplay != SDLLogoScreen && ScreenToDisplay != SixteenBitSoftScreen)
+    {
+        visuals->FinishLoadingSprites();
+        audio->FinishLoadingAudio();
+    }
+
+    if (ScreenToDisplay != AssetsScreen)  SwitchScreenAssets(ScreenToDisplay);
+
     if (input->LastEventWasWindowResize > 0)
     {
         ScreenIsDirty = 2;
@@ -294,6 +458,14 @@ int windowHeight;
         SDL_snprintf (visuals->VariableText, sizeof visuals->VariableText, "%d", visuals->AverageFPS);
         visuals->DrawTextOntoScreenBuffer(visuals->VariableText, visuals->Font[7], 3, 460
                                           , JustifyLeft, 255, 255, 255, 0, 0, 0);
+
+        /* The counts change every frame, so they are drawn as digits from the glyph atlas under a label that never changes */
+        visuals->DrawTextOntoScreenBuffer("Text cache hits:misses", visuals->Font[7], 3, 420
+                                          , JustifyLeft, 255, 255, 255, 0, 0, 0);
+
+        SDL_snprintf (visuals->VariableText, sizeof visuals->VariableText, "%u:%u", visuals->TextCacheHits, visuals->TextCacheMisses);
+        visuals->DrawTextOntoScreenBuffer(visuals->VariableText, visuals->Font[7], 3, 440
+                                          , JustifyLeft, 255, 255, 255, 0, 0, 0);
     }
 
     if (ScreenIsDirty > 0)
@@ -302,6 +474,13 @@ int windowHeight;
         else  SDL_RenderSetLogicalSize(visuals->Renderer, 900, 480);
 
         SDL_RenderPresent(visuals->Renderer);
+        if (visuals->FirstFramePresented == false)
+        {
+            visuals->FirstFramePresented = true;
+            printf( "First frame presented %.0f ms after launch.\n"
+                   , (double)(SDL_GetPerformanceCounter() - visuals->LaunchTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency() );
+        }
+
         if (ScreenTransitionStatus != FadeIn && ScreenTransitionStatus != FadeOut)
         {
             if (ScreenIsDirty > 0)  ScreenIsDirty--;
@@ -2422,29 +2601,52 @@ void Screens::DisplayAboutScreen(void)
 }
 
 //-------------------------------------------------------------------------------------------------
-void Screens::DisplayPlayingGameScreen(void)
+void Screens::ReaddPiecesAndUpdateHints(void)
 {
-const char* keyName;
-
-    if (ScreenTransitionStatus == FadeAll)
+    for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
     {
-        visuals->FrameLock = logic->PlayingGameFrameLock;
+        if (logic->PlayerData[logic->Player].PlayerStatus != FlashingCompletedLines
+            && logic->PlayerData[logic->Player].PlayerStatus != ClearingCompletedLines)
+        {
+            logic->DeletePieceFromPlayfieldMemory(Current);
+        }
+    }
 
-        ScreenTransitionStatus = FadeIn;
+    if (input->ShiftKeyPressed == true && input->KeyOnKeyboardPressedByUser == SDLK_h)
+    {
+        logic->DisplayHints = !logic->DisplayHints;
+        input->DelayAllUserInput = 20;
     }
 
-    logic->RunTetriGameEngine();
+    /* Hints are asked for while the falling pieces are out of the playfields, so only the locked stacks get solved */
+    logic->UpdateHints();
 
     for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
     {
         if (logic->PlayerData[logic->Player].PlayerStatus != FlashingCompletedLines
             && logic->PlayerData[logic->Player].PlayerStatus != ClearingCompletedLines)
         {
-            logic->DeletePieceFromPlayfieldMemory(Current);
             logic->AddPieceToPlayfieldMemory(DropShadow);
             logic->AddPieceToPlayfieldMemory(Current);
         }
     }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Screens::DisplayPlayingGameScreen(void)
+{
+const char* keyName;
+
+    if (ScreenTransitionStatus == FadeAll)
+    {
+        visuals->FrameLock = logic->PlayingGameFrameLock;
+
+        ScreenTransitionStatus = FadeIn;
+    }
+
+    logic->RunTetriGameEngine();
+
+    ReaddPiecesAndUpdateHints();
 
     if (logic->PlayersCanJoin == true)
     {
@@ -2478,53 +2680,66 @@ const char* keyName;
 
     if (ScreenIsDirty > 0)
     {
-        visuals->Sprites[100+logic->SelectedBackground].ScreenX = 320;
-        visuals->Sprites[100+logic->SelectedBackground].ScreenY = 240;
-        visuals->DrawSpriteOntoScreenBuffer(100+logic->SelectedBackground);
-
-        if (logic->PlayerData[0].PlayerStatus != GameOver)
+        /* Background and the playing boards' frames only change when a player joins or leaves, or the window changes */
+        Uint32 staticLayerKey = (Uint32)(ScreenToDisplay << 16) | (Uint32)(logic->SelectedBackground << 8);
+        for (int player = 0; player < NumberOfPlayers; player++)
         {
-            visuals->Sprites[31].ScreenX = logic->PlayerData[0].PlayersPlayfieldScreenX;
-            visuals->Sprites[31].ScreenY = logic->PlayerData[0].PlayersPlayfieldScreenY;
-            visuals->Sprites[31].Transparency = 150;
-            visuals->Sprites[31].RedHue = 255;
-            visuals->Sprites[31].GreenHue = 0;
-            visuals->Sprites[31].BlueHue = 0;
-            visuals->DrawSpriteOntoScreenBuffer(31);
+            if (logic->PlayerData[player].PlayerStatus != GameOver)  staticLayerKey |= (1 << player);
         }
 
-        if (logic->PlayerData[1].PlayerStatus != GameOver)
+        if (visuals->BeginStaticLayer(staticLayerKey) == true)
         {
-            visuals->Sprites[31].ScreenX = logic->PlayerData[1].PlayersPlayfieldScreenX;
-            visuals->Sprites[31].ScreenY = logic->PlayerData[1].PlayersPlayfieldScreenY;
-            visuals->Sprites[31].Transparency = 150;
-            visuals->Sprites[31].RedHue = 255;
-            visuals->Sprites[31].GreenHue = 255;
-            visuals->Sprites[31].BlueHue = 0;
-            visuals->DrawSpriteOntoScreenBuffer(31);
-        }
+            visuals->Sprites[100+logic->SelectedBackground].ScreenX = 320;
+            visuals->Sprites[100+logic->SelectedBackground].ScreenY = 240;
+            visuals->DrawSpriteOntoScreenBuffer(100+logic->SelectedBackground);
 
-        if (logic->PlayerData[2].PlayerStatus != GameOver)
-        {
-            visuals->Sprites[31].ScreenX = logic->PlayerData[2].PlayersPlayfieldScreenX;
-            visuals->Sprites[31].ScreenY = logic->PlayerData[2].PlayersPlayfieldScreenY;
-            visuals->Sprites[31].Transparency = 150;
-            visuals->Sprites[31].RedHue = 0;
-            visuals->Sprites[31].GreenHue = 255;
-            visuals->Sprites[31].BlueHue = 0;
-            visuals->DrawSpriteOntoScreenBuffer(31);
-        }
+            if (logic->PlayerData[0].PlayerStatus != GameOver)
+            {
+                visuals->Sprites[31].ScreenX = logic->PlayerData[0].PlayersPlayfieldScreenX;
+                visuals->Sprites[31].ScreenY = logic->PlayerData[0].PlayersPlayfieldScreenY;
+                visuals->Sprites[31].Transparency = 150;
+                visuals->Sprites[31].RedHue = 255;
+                visuals->Sprites[31].GreenHue = 0;
+                visuals->Sprites[31].BlueHue = 0;
+                visuals->DrawSpriteOntoScreenBuffer(31);
+            }
 
-        if (logic->PlayerData[3].PlayerStatus != GameOver)
-        {
-            visuals->Sprites[31].ScreenX = logic->PlayerData[3].PlayersPlayfieldScreenX;
-            visuals->Sprites[31].ScreenY = logic->PlayerData[3].PlayersPlayfieldScreenY;
-            visuals->Sprites[31].Transparency = 150;
-            visuals->Sprites[31].RedHue = 0;
-            visuals->Sprites[31].GreenHue = 0;
-            visuals->Sprites[31].BlueHue = 255;
-            visuals->DrawSpriteOntoScreenBuffer(31);
+            if (logic->PlayerData[1].PlayerStatus != GameOver)
+            {
+                visuals->Sprites[31].ScreenX = logic->PlayerData[1].PlayersPlayfieldScreenX;
+                visuals->Sprites[31].ScreenY = logic->PlayerData[1].PlayersPlayfieldScreenY;
+                visuals->Sprites[31].Transparency = 150;
+                visuals->Sprites[31].RedHue = 255;
+                visuals->Sprites[31].GreenHue = 255;
+                visuals->Sprites[31].BlueHue = 0;
+                visuals->DrawSpriteOntoScreenBuffer(31);
+            }
+
+            if (logic->PlayerData[2].PlayerStatus != GameOver)
+            {
+                visuals->Sprites[31].ScreenX = logic->PlayerData[2].PlayersPlayfieldScreenX;
+                visuals->Sprites[31].ScreenY = logic->PlayerData[2].PlayersPlayfieldScreenY;
+                visuals->Sprites[31].Transparency = 150;
+                visuals->Sprites[31].RedHue = 0;
+                visuals->Sprites[31].GreenHue = 255;
+                visuals->Sprites[31].BlueHue = 0;
+                visuals->DrawSpriteOntoScreenBuffer(31);
+            }
+
+            if (logic->PlayerData[3].PlayerStatus != GameOver)
+            {
+                visuals->Sprites[31].ScreenX = logic->PlayerData[3].PlayersPlayfieldScreenX;
+                visuals->Sprites[31].ScreenY = logic->PlayerData[3].PlayersPlayfieldScreenY;
+                visuals->Sprites[31].Transparency = 150;
+                visuals->Sprites[31].RedHue = 0;
+                visuals->Sprites[31].GreenHue = 0;
+                visuals->Sprites[31].BlueHue = 255;
+                visuals->DrawSpriteOntoScreenBuffer(31);
+            }
+
+            visuals->EndStaticLayer();
         }
+        visuals->DrawStaticLayer();
 
         float mouseScreenX = -999;
         float mouseScreenY = -999;
@@ -2533,36 +2748,46 @@ const char* keyName;
         {
             float boxScreenX = logic->PlayerData[player].PlayersPlayfieldScreenX-57-(2*13);
             float boxScreenY = logic->PlayerData[player].PlayersPlayfieldScreenY-212;
+            bool boardTexture = visuals->BeginBoard(player);
 
             for (int y = 0; y < 26; y++)
             {
                 for (int x = 0; x < 12; x++)
                 {
+                    int boxIndex = -1;
+                    Uint8 boxTransparency = 255;
+
                     if (logic->PlayerData[player].Playfield[x][y] == 1)
                     {
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
-                        visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 70;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        boxIndex = 201 + (10*logic->TileSet);
+                        boxTransparency = 70;
+                    }
+                    else if (logic->PlayerData[player].Playfield[x][y] == 0 && logic->HintCoversBox(player, x, y) == true)
+                    {
+                        boxIndex = 201 + (10*logic->TileSet);
+                        boxTransparency = 35;
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 10
                              && logic->PlayerData[player].Playfield[x][y] < 20)
                     {
                         int spriteIndex = 200 + (10*logic->TileSet);
 
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenX = boxScreenX;
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenY = boxScreenY;
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(spriteIndex-9+logic->PlayerData[player].Playfield[x][y]);
-
+                        boxIndex = spriteIndex-9+logic->PlayerData[player].Playfield[x][y];
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 20
                              && logic->PlayerData[player].Playfield[x][y] < 30)
                     {
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
-                        visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        boxIndex = 201 + (10*logic->TileSet);
+                    }
+
+                    /* The board's texture only redraws the cells that changed */
+                    if (boardTexture == true)  visuals->SetBoardCell(player, x, y, boxIndex, boxTransparency);
+                    else if (boxIndex != -1)
+                    {
+                        visuals->Sprites[boxIndex].ScreenX = boxScreenX;
+                        visuals->Sprites[boxIndex].ScreenY = boxScreenY;
+                        visuals->Sprites[boxIndex].Transparency = boxTransparency;
+                        visuals->BatchSpriteOntoScreenBuffer(boxIndex);
                     }
 
                     if (logic->PlayerData[player].PlayerInput == Mouse && logic->PlayerData[player].PlayerStatus == PieceFalling)
@@ -2583,6 +2808,15 @@ const char* keyName;
                 boxScreenY+=18;
             }
 
+            if (boardTexture == true)
+                visuals->DrawBoard(player, logic->PlayerData[player].PlayersPlayfieldScreenX-57-(2*13), logic->PlayerData[player].PlayersPlayfieldScreenY-212);
+        }
+
+        /* Every batched board's boxes go out in one draw call, then what is drawn over them */
+        visuals->DrawSpriteBatch();
+
+        for (int player = 0; player < NumberOfPlayers; player++)
+        {
             if (logic->PlayerData[player].PlayerStatus != GameOver)
             {
                 if (logic->BlockAttackTransparency[player] > 0)
@@ -3648,33 +3882,33 @@ const char* keyName;
 
     logic->RunTetriGameEngine();
 
-    for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
-    {
-        if (logic->PlayerData[logic->Player].PlayerStatus != FlashingCompletedLines
-            && logic->PlayerData[logic->Player].PlayerStatus != ClearingCompletedLines)
-        {
-            logic->DeletePieceFromPlayfieldMemory(Current);
-            logic->AddPieceToPlayfieldMemory(DropShadow);
-            logic->AddPieceToPlayfieldMemory(Current);
-        }
-    }
+    ReaddPiecesAndUpdateHints();
 
     if (ScreenIsDirty > 0)
     {
-        visuals->Sprites[108].ScreenX = 320;
-        visuals->Sprites[108].ScreenY = 240;
-        visuals->DrawSpriteOntoScreenBuffer(108);
+        Uint32 staticLayerKey = (Uint32)(ScreenToDisplay << 16);
+        if (logic->PlayerData[1].PlayerStatus != GameOver)  staticLayerKey |= (1 << 1);
 
-        if (logic->PlayerData[1].PlayerStatus != GameOver)
+        if (visuals->BeginStaticLayer(staticLayerKey) == true)
         {
-            visuals->Sprites[31].ScreenX = logic->PlayerData[1].PlayersPlayfieldScreenX;
-            visuals->Sprites[31].ScreenY = logic->PlayerData[1].PlayersPlayfieldScreenY;
-            visuals->Sprites[31].Transparency = 150;
-            visuals->Sprites[31].RedHue = 255;
-            visuals->Sprites[31].GreenHue = 255;
-            visuals->Sprites[31].BlueHue = 255;
-            visuals->DrawSpriteOntoScreenBuffer(31);
+            visuals->Sprites[108].ScreenX = 320;
+            visuals->Sprites[108].ScreenY = 240;
+            visuals->DrawSpriteOntoScreenBuffer(108);
+
+            if (logic->PlayerData[1].PlayerStatus != GameOver)
+            {
+                visuals->Sprites[31].ScreenX = logic->PlayerData[1].PlayersPlayfieldScreenX;
+                visuals->Sprites[31].ScreenY = logic->PlayerData[1].PlayersPlayfieldScreenY;
+                visuals->Sprites[31].Transparency = 150;
+                visuals->Sprites[31].RedHue = 255;
+                visuals->Sprites[31].GreenHue = 255;
+                visuals->Sprites[31].BlueHue = 255;
+                visuals->DrawSpriteOntoScreenBuffer(31);
+            }
+
+            visuals->EndStaticLayer();
         }
+        visuals->DrawStaticLayer();
 
         float mouseScreenX = -999;
         float mouseScreenY = -999;
@@ -3683,38 +3917,46 @@ const char* keyName;
         {
             float boxScreenX = 237;
             float boxScreenY = logic->PlayerData[player].PlayersPlayfieldScreenY-212;
+            bool boardTexture = visuals->BeginBoard(player);
 
             for (int y = 0; y < 26; y++)
             {
                 for (int x = 0; x < 12; x++)
                 {
+                    int boxIndex = -1;
+                    Uint8 boxTransparency = 255;
+
                     if (logic->PlayerData[player].Playfield[x][y] == 1)
                     {
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScaleX = 1.0f;
-                        visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 70;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        boxIndex = 201 + (10*logic->TileSet);
+                        boxTransparency = 70;
+                    }
+                    else if (logic->PlayerData[player].Playfield[x][y] == 0 && logic->HintCoversBox(player, x, y) == true)
+                    {
+                        boxIndex = 201 + (10*logic->TileSet);
+                        boxTransparency = 35;
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 10
                              && logic->PlayerData[player].Playfield[x][y] < 20)
                     {
                         int spriteIndex = 200;
 
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenX = boxScreenX;
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenY = boxScreenY;
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScaleX = 1.0f;
-                        visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(spriteIndex-9+logic->PlayerData[player].Playfield[x][y]);
+                        boxIndex = spriteIndex-9+logic->PlayerData[player].Playfield[x][y];
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 20
                              && logic->PlayerData[player].Playfield[x][y] < 30)
                     {
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
-                        visuals->Sprites[201 + (10*logic->TileSet)].ScaleX = 1.0f;
-                        visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        boxIndex = 201 + (10*logic->TileSet);
+                    }
+
+                    if (boardTexture == true)  visuals->SetBoardCell(player, x, y, boxIndex, boxTransparency);
+                    else if (boxIndex != -1)
+                    {
+                        visuals->Sprites[boxIndex].ScreenX = boxScreenX;
+                        visuals->Sprites[boxIndex].ScreenY = boxScreenY;
+                        visuals->Sprites[boxIndex].ScaleX = 1.0f;
+                        visuals->Sprites[boxIndex].Transparency = boxTransparency;
+                        visuals->BatchSpriteOntoScreenBuffer(boxIndex);
                     }
 
                     if (logic->PlayerData[player].PlayerInput == Mouse && logic->PlayerData[player].PlayerStatus == PieceFalling)
@@ -3734,8 +3976,13 @@ const char* keyName;
                 boxScreenX = 237;
                 boxScreenY+=18;
             }
+
+            if (boardTexture == true)
+                visuals->DrawBoard(player, 237, logic->PlayerData[player].PlayersPlayfieldScreenY-212);
         }
 
+        visuals->DrawSpriteBatch();
+
         for (int player = 1; player < 2; player++)
         {
             if (logic->PlayerData[player].PlayerInput == Mouse && logic->PlayerData[player].PlayerStatus == PieceFalling)
@@ -4653,6 +4900,32 @@ void Screens::DisplayTestComputerSkillScreen(void)
         if (visuals->FrameLock == 16)  visuals->FrameLock = 0;
         else  visuals->FrameLock = 16;
     }
+    else if ( (input->KeyOnKeyboardPressedByUser == SDLK_n && logic->AINeural->Loaded == true)
+           || input->KeyOnKeyboardPressedByUser == SDLK_m )
+    {
+        if (input->KeyOnKeyboardPressedByUser == SDLK_m)
+        {
+            bool rollouts = !logic->PlayerData[0].AIRollouts;
+            for (int player = 0; player < NumberOfPlayers; player++)  logic->PlayerData[player].AIRollouts = rollouts;
+            if (rollouts == true)  logic->AIRollout->StartThreadsIfNeeded();
+        }
+        else
+        {
+            int evaluator = ( logic->PlayerData[0].AIEvaluator == SearchNeural ? SearchGiftOfSight : SearchNeural );
+            for (int player = 0; player < NumberOfPlayers; player++)  logic->PlayerData[player].AIEvaluator = evaluator;
+        }
+
+        logic->SetupForNewGame();
+
+        logic->TotalCPUPlayerLines = 0;
+        logic->NumberofCPUGames = 4;
+        logic->TotalOneLines = 0;
+        logic->TotalTwoLines = 0;
+        logic->TotalThreeLines = 0;
+        logic->TotalFourLines = 0;
+
+        input->DelayAllUserInput = 20;
+    }
     else if (input->KeyOnKeyboardPressedByUser == SDLK_MINUS)
     {
         if (logic->Multiplier > -10)  logic->Multiplier-=0.025f;
@@ -4760,7 +5033,7 @@ void Screens::DisplayTestComputerSkillScreen(void)
                         visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
                         visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
                         visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 70;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        visuals->BatchSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 10
                              && logic->PlayerData[player].Playfield[x][y] < 20)
@@ -4770,7 +5043,7 @@ void Screens::DisplayTestComputerSkillScreen(void)
                         visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenX = boxScreenX;
                         visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].ScreenY = boxScreenY;
                         visuals->Sprites[spriteIndex-9+logic->PlayerData[player].Playfield[x][y]].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(spriteIndex-9+logic->PlayerData[player].Playfield[x][y]);
+                        visuals->BatchSpriteOntoScreenBuffer(spriteIndex-9+logic->PlayerData[player].Playfield[x][y]);
 
                     }
                     else if (logic->PlayerData[player].Playfield[x][y] > 20
@@ -4779,14 +5052,14 @@ void Screens::DisplayTestComputerSkillScreen(void)
                         visuals->Sprites[201 + (10*logic->TileSet)].ScreenX = boxScreenX;
                         visuals->Sprites[201 + (10*logic->TileSet)].ScreenY = boxScreenY;
                         visuals->Sprites[201 + (10*logic->TileSet)].Transparency = 255;
-                        visuals->DrawSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
+                        visuals->BatchSpriteOntoScreenBuffer(201 + (10*logic->TileSet));
                     }
 
                     if (logic->PlayerData[player].PlayfieldAI[x][y] == 999)
                     {
                         visuals->Sprites[200 + (10*logic->TileSet)].ScreenX = boxScreenX;
                         visuals->Sprites[200 + (10*logic->TileSet)].ScreenY = boxScreenY;
-                        visuals->DrawSpriteOntoScreenBuffer(200 + (10*logic->TileSet));
+                        visuals->BatchSpriteOntoScreenBuffer(200 + (10*logic->TileSet));
                     }
 
                     boxScreenX+=13;
@@ -4795,7 +5068,12 @@ void Screens::DisplayTestComputerSkillScreen(void)
                 boxScreenX = logic->PlayerData[player].PlayersPlayfieldScreenX-57;
                 boxScreenY+=18;
             }
+        }
+
+        visuals->DrawSpriteBatch();
 
+        for (int player = 0; player < NumberOfPlayers; player++)
+        {
             if (logic->GameMode == TimeAttack30Mode || logic->GameMode == TimeAttack60Mode || logic->GameMode == TimeAttack120Mode)
             {
                 Uint32 taTimer = logic->TimeAttackTimer / 200;
@@ -4902,6 +5180,12 @@ void Screens::DisplayTestComputerSkillScreen(void)
         visuals->DrawTextOntoScreenBuffer("Press [T] On Keyboard To Toggle Speed!", visuals->Font[7]
                                           , 0, 195+25, JustifyCenter, 255, 255, 255, 0, 0, 0);
 
+        SDL_snprintf (visuals->VariableText, sizeof visuals->VariableText, "A.I. Cache Hits: %.1f%% (%u KB) - [N] Evaluator: %s - [M] Monte Carlo: %s"
+                      , logic->AITransposition->HitRate(), logic->AITransposition->MemoryUsed() / 1024
+                      , (logic->PlayerData[0].AIEvaluator == SearchNeural ? "Neural" : "Gift Of Sight"), (logic->PlayerData[0].AIRollouts == true ? "On" : "Off") );
+        visuals->DrawTextOntoScreenBuffer(visuals->VariableText, visuals->Font[7], 0, 195+50
+                                          , JustifyCenter, 255, 255, 255, 0, 0, 0);
+
         logic->TotalCPUPlayerLines = ( logic->TotalOneLines+(2*logic->TotalTwoLines)+(3*logic->TotalThreeLines)+(4*logic->TotalFourLines) );
 
         int averageLinesPerGame = logic->TotalCPUPlayerLines / logic->NumberofCPUGames;
@@ -4928,54 +5212,7 @@ void Screens::DisplayTestComputerSkillScreen(void)
 
     for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
     {
-        if (logic->PlayerData[logic->Player].PlayerStatus == GameOver)
-        {
-            logic->NumberofCPUGames++;
-
-            for (int y = 0; y < 26; y++)
-                for (int x = 0; x < 15; x++)
-                    logic->PlayerData[logic->Player].Playfield[x][y] = 255; /* Collision detection value */
-
-            for (int y = 2; y < 5; y++)
-                for (int x = 5; x < 9; x++)
-                    logic->PlayerData[logic->Player].Playfield[x][y] = 0;
-
-            for (int y = 5; y < 24; y++)
-                for (int x = 2; x < 12; x++)
-                    logic->PlayerData[logic->Player].Playfield[x][y] = 0;
-
-            logic->PlayerData[logic->Player].PiecePlayfieldX = 5;
-            logic->PlayerData[logic->Player].PiecePlayfieldY = 0;
-
-            logic->FillPieceBag(logic->Player);
-            logic->PlayerData[logic->Player].Piece = logic->PlayerData[logic->Player].PieceBag[0][logic->PlayerData[logic->Player].PieceBagIndex];
-            logic->PlayerData[logic->Player].PieceBagIndex = 1;
-            logic->PlayerData[logic->Player].NextPiece = logic->PlayerData[logic->Player].PieceBag[0][logic->PlayerData[logic->Player].PieceBagIndex];
-
-            logic->PlayerData[logic->Player].Piece = logic->PlayerData[logic->Player].NextPiece;
-            logic->PlayerData[logic->Player].PieceBagIndex = 2;
-            logic->PlayerData[logic->Player].NextPiece = logic->PlayerData[logic->Player].PieceBag[0][logic->PlayerData[logic->Player].PieceBagIndex];
-
-            logic->PlayerData[logic->Player].PieceMovementDelay = 0;
-            logic->PlayerData[logic->Player].PieceRotation = 1;
-
-            logic->PlayerData[logic->Player].PlayerStatus = NewPieceDropping;
-
-            logic->PlayerData[logic->Player].PieceDropTimer = 0;
-            logic->PlayerData[logic->Player].TimeToDropPiece = 47;
-
-            logic->PlayerData[logic->Player].PieceRotated1 = false;
-            logic->PlayerData[logic->Player].PieceRotated2 = false;
-
-            logic->PlayerData[logic->Player].FlashCompletedLinesTimer = 0;
-            logic->PlayerData[logic->Player].ClearCompletedLinesTimer = 0;
-
-            logic->PlayerData[logic->Player].Score = 0;
-            logic->PlayerData[logic->Player].DropBonus = 0;
-            logic->PlayerData[logic->Player].Level = 0;
-            logic->PlayerData[logic->Player].Lines = 0;
-
-        }
+        if (logic->PlayerData[logic->Player].PlayerStatus == GameOver)  logic->RestartComputerSkillTestPlayer();
     }
 
     if (ScreenTransitionStatus == FadeOut && ScreenFadeTransparency == 255)
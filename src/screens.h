@@ -71,6 +71,18 @@ public:
 
     bool SkipEntireStoryCutsceneAndPlay = false;
 
+    /* Each screen holds the on demand sprites it draws, plus the likely next screen's as a prefetch */
+    #define MaxScreenSprites    8
+    int AssetsScreen;
+    int AssetSprites[MaxScreenSprites];
+    int AssetSpritesCount;
+    int PrefetchSprites[MaxScreenSprites];
+    int PrefetchSpritesCount;
+
+    int GetScreenSprites(int screen, int sprites[MaxScreenSprites]);
+    int LikelyNextScreen(int screen);
+    void SwitchScreenAssets(int screen);
+
     void ApplyScreenFadeTransition(void);
 
     void ProcessScreenToDisplay(void);
@@ -95,6 +107,7 @@ public:
     float ReviewScale;
     void DisplayAboutScreen(void);
 
+    void ReaddPiecesAndUpdateHints(void);
     void DisplayPlayingGameScreen(void);
 
     void DisplayShowStoryScreen(void);
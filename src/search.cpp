@@ -0,0 +1,489 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cfloat>
+#include <cmath>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
+
+//-------------------------------------------------------------------------------------------------
+Search::Search(void)
+{
+    for (int depth = 0; depth < SearchMaxDepth; depth++)  Board[depth] = new Bitboard();
+    Scratch = new Bitboard();
+    Lanes = new NeuralLanes();  /* Zeroed, so the lanes a wide kernel pads with stay finite */
+
+    Evaluator = SearchGiftOfSight;
+    Network = NULL;
+
+    RootCount = 0;
+    MaxDepth = SearchMaxDepth;
+    Depth = 0;
+    CompletedDepth = 0;
+    Index = 0;
+    DepthBestIndex = 0;
+    Done = true;
+
+    BestMoveX = -1;
+    BestRotation = -1;
+    BestValue = FLT_MAX;
+
+    NodeBudget = false;
+    Nodes = 0;
+    MicrosecondsUsed = 0;
+    MicrosecondsPerNode = SearchNominalNodeMicroseconds;
+
+    RolloutCandidates = 0;
+    RolloutsDone = 0;
+    RolloutSeed = 0;
+    MicrosecondsPerRollout = RolloutNominalMicroseconds;
+}
+
+//-------------------------------------------------------------------------------------------------
+Search::~Search(void)
+{
+    for (int depth = 0; depth < SearchMaxDepth; depth++)  delete Board[depth];
+    delete Lanes;
+    delete Scratch;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8])
+{
+    for (int depth = 0; depth < SearchMaxDepth; depth++)  Board[depth]->LoadPieceData(pieceData);
+    Scratch->LoadPieceData(pieceData);
+
+    for (int piece = 0; piece < 8; piece++)  MaxRotation[piece] = maxRotation[piece];
+}
+
+//-------------------------------------------------------------------------------------------------
+float Search::GiftOfSightValue(Bitboard *board, int move)
+{
+    /* -- JeZxLee's ["Gift Of Sight" Tetri A.I. Algorithm ~691,000+]--------------------------------------- */
+    return( (3.0f*board->MoveTrappedHoles[move])
+           +(1.0f*board->MoveOneBlockCavernHoles[move])
+           +(1.0f*board->MoveBoxEdges[move])
+           -(1.0f*(board->MoveHeight[move] + board->MoveCompletedLines[move])) );
+    /* --------------------------------------- JeZxLee's ["Gift Of Sight" Tetri A.I. Algorithm ~691,000+]-- */
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::ScoreMoves(int depth, Uint8 piece, int startY)
+{
+Bitboard *board = Board[depth];
+int laneMove[BitboardMaxMoves];
+int lanes = 0;
+
+    board->ScoreAllMoves(piece, MaxRotation[piece], StartX, EndX, startY);
+    Nodes++;
+
+    if (Evaluator == SearchNeural && Network != NULL)
+    {
+        /* The network scores the playfield each placement leaves behind, all placements in one batch */
+        Network->LoadBoard(Lanes, board);
+        for (int move = 0; move < board->MovesCount; move++)
+        {
+            Value[depth][move] = SearchLostValue;
+            Step[depth][move] = -(float)board->MoveCompletedLines[move];
+
+            if (board->MoveCollision[move] == true || board->MoveX[move] < (StartX-1))  continue;
+
+            /* Completed lines move every row above them, only those placements are played out on a copy */
+            if (board->MoveCompletedLines[move] > 0)
+            {
+                Scratch->LoadPlacement(board, piece, move);
+                Network->ExtractFeatures(Lanes, Scratch, board->MoveLandedY[move], board->MoveCompletedLines[move], lanes);
+            }
+            else  Network->ExtractMoveFeatures(Lanes, board, piece, move, lanes);
+
+            laneMove[lanes] = move;
+            lanes++;
+        }
+
+        Network->Evaluate(Lanes, lanes);
+
+        for (int lane = 0; lane < lanes; lane++)  Value[depth][ laneMove[lane] ] = Step[depth][ laneMove[lane] ] + Lanes->Output[lane];
+
+        return;
+    }
+
+    for (int move = 0; move < board->MovesCount; move++)
+    {
+        Value[depth][move] = GiftOfSightValue(board, move);
+        Step[depth][move] = Value[depth][move];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+float Search::BestReplyValue(int depth, Uint8 piece, int startY)
+{
+float bestValue = SearchLostValue;
+
+    ScoreMoves(depth, piece, startY);
+
+    for (int move = 0; move < Board[depth]->MovesCount; move++)
+    {
+        if (Board[depth]->MoveCollision[move] == true || Board[depth]->MoveX[move] < (StartX-1))  continue;
+
+        if (Value[depth][move] < bestValue)  bestValue = Value[depth][move];
+    }
+
+    return(bestValue);
+}
+
+//-------------------------------------------------------------------------------------------------
+float Search::SearchRootMove(int root, int depth)
+{
+int beamMove[SearchBeamWidth];
+float beamValue[SearchBeamWidth];
+int beamCount = 0;
+float bestValue = SearchLostValue;
+float rootStep = Step[0][root];
+
+    /* A line of play is worth the steps of its placements plus the value of the last one */
+    Board[1]->LoadPlacement(Board[0], Piece, root);
+
+    if (depth == 2)  return( rootStep + BestReplyValue(1, NextPiece, SearchLookaheadStartY) );
+
+    /* Depth 3: best few placements of the next piece, then every possible piece after that, averaged */
+    ScoreMoves(1, NextPiece, SearchLookaheadStartY);
+
+    for (int move = 0; move < Board[1]->MovesCount; move++)
+    {
+        if (Board[1]->MoveCollision[move] == true || Board[1]->MoveX[move] < (StartX-1))  continue;
+
+        float value = Value[1][move];
+        int slot = beamCount;
+        if (beamCount < SearchBeamWidth)  beamCount++;
+        else if (value >= beamValue[SearchBeamWidth-1])  continue;
+        else  slot = SearchBeamWidth-1;
+
+        while (slot > 0 && beamValue[slot-1] > value)
+        {
+            beamMove[slot] = beamMove[slot-1];
+            beamValue[slot] = beamValue[slot-1];
+            slot--;
+        }
+
+        beamMove[slot] = move;
+        beamValue[slot] = value;
+    }
+
+    for (int beam = 0; beam < beamCount; beam++)
+    {
+        float total = 0.0f;
+
+        Board[2]->LoadPlacement(Board[1], NextPiece, beamMove[beam]);
+        for (Uint8 piece = 1; piece < 8; piece++)  total+=BestReplyValue(2, piece, SearchLookaheadStartY);
+
+        float value = Step[1][ beamMove[beam] ] + (total / 7.0f);
+        if (value < bestValue)  bestValue = value;
+    }
+
+    return(rootStep + bestValue);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::SortRootMoves(void)
+{
+    /* Best first; equal values keep the later move first, as the original "<=" selection did */
+    for (int root = 1; root < RootCount; root++)
+    {
+        int move = RootMove[root];
+        float value = RootValue[root];
+        int slot = root;
+
+        while ( slot > 0 && (RootValue[slot-1] > value || (RootValue[slot-1] == value && RootMove[slot-1] < move)) )
+        {
+            RootMove[slot] = RootMove[slot-1];
+            RootValue[slot] = RootValue[slot-1];
+            slot--;
+        }
+
+        RootMove[slot] = move;
+        RootValue[slot] = value;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Search::MicrosecondsSince(Uint64 startTicks, Uint32 startNodes)
+{
+    if (NodeBudget == true)  return( (Nodes - startNodes) * SearchNominalNodeMicroseconds );
+
+    return( (Uint32)( (SDL_GetPerformanceCounter() - startTicks) * 1000000 / SDL_GetPerformanceFrequency() ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::Start(Bitboard *root, Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY)
+{
+Uint64 startTicks = SDL_GetPerformanceCounter();
+
+    Piece = piece;
+    NextPiece = nextPiece;
+    StartX = startX;
+    EndX = endX;
+
+    for (int depth = 0; depth < SearchMaxDepth; depth++)  Board[depth]->Kernel = root->Kernel;
+
+    Nodes = 0;
+    Board[0]->CopyPlayfield(root);
+    ScoreMoves(0, Piece, startY);
+
+    /* Depth 1 is the original greedy A.I., so there is always a move to play */
+    RootCount = 0;
+    BestMoveX = -1;
+    BestRotation = -1;
+    BestValue = FLT_MAX;
+    for (int move = 0; move < Board[0]->MovesCount; move++)
+    {
+        if (Board[0]->MoveCollision[move] == true || Board[0]->MoveX[move] < (StartX-1))  continue;
+
+        RootMove[RootCount] = move;
+        RootValue[RootCount] = Value[0][move];
+
+        if (RootValue[RootCount] <= BestValue)
+        {
+            BestValue = RootValue[RootCount];
+            BestMoveX = Board[0]->MoveX[move];
+            BestRotation = Board[0]->MoveRotation[move];
+        }
+
+        RootCount++;
+    }
+
+    SortRootMoves();
+
+    CompletedDepth = 1;
+    Depth = 2;
+    Index = 0;
+    DepthBestIndex = 0;
+    Done = (RootCount < 2);
+
+    MicrosecondsUsed = MicrosecondsSince(startTicks, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::Replan(Bitboard *root, Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY)
+{
+Uint64 startTicks = SDL_GetPerformanceCounter();
+int candidate[BitboardMaxMoves];
+int candidates = RootCount;
+
+    /* A depth 1 plan must still pick from every move, and root moves of another piece mean nothing here */
+    if (MaxDepth < 2 || candidates == 0 || piece != Piece || nextPiece != NextPiece || startX != StartX || endX != EndX)
+    {
+        Start(root, piece, nextPiece, startX, endX, startY);
+        return;
+    }
+
+    /* Same piece and columns, so move numbers still mean the same placements, only where they land changed */
+    for (int index = 0; index < candidates; index++)  candidate[index] = RootMove[index];
+
+    Nodes = 0;
+    Board[0]->CopyPlayfield(root);
+    ScoreMoves(0, Piece, startY);
+
+    /* The old search's best few root moves, still best first, are all the new one looks deeper at */
+    RootCount = 0;
+    BestMoveX = -1;
+    BestRotation = -1;
+    BestValue = FLT_MAX;
+    for (int index = 0; index < candidates && RootCount < SearchReplanCandidates; index++)
+    {
+        int move = candidate[index];
+        if (Board[0]->MoveCollision[move] == true)  continue;
+
+        RootMove[RootCount] = move;
+        RootValue[RootCount] = Value[0][move];
+
+        if (RootValue[RootCount] <= BestValue)
+        {
+            BestValue = RootValue[RootCount];
+            BestMoveX = Board[0]->MoveX[move];
+            BestRotation = Board[0]->MoveRotation[move];
+        }
+
+        RootCount++;
+    }
+
+    /* The attack line blocked every one of them, so plan from scratch */
+    if (RootCount == 0)
+    {
+        Start(root, piece, nextPiece, startX, endX, startY);
+        return;
+    }
+
+    SortRootMoves();
+
+    CompletedDepth = 1;
+    Depth = 2;
+    Index = 0;
+    DepthBestIndex = 0;
+    Done = (RootCount < 2);
+
+    MicrosecondsUsed = MicrosecondsSince(startTicks, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Search::Continue(Uint32 microseconds)
+{
+Uint64 startTicks = SDL_GetPerformanceCounter();
+Uint32 startNodes = Nodes;
+Uint32 spent = 0;
+
+    while (Done == false)
+    {
+        /* Depth 1 alone is the original greedy A.I., Start() already searched it */
+        if (Depth > MaxDepth)
+        {
+            Done = true;
+            break;
+        }
+
+        if (Index == RootCount)
+        {
+            for (int root = 0; root < RootCount; root++)  RootValue[root] = DeeperValue[root];
+            SortRootMoves();
+
+            CompletedDepth = Depth;
+            Index = 0;
+
+            if (Depth >= MaxDepth)  Done = true;
+            else  Depth++;
+
+            continue;
+        }
+
+        /* Only start a root move that should still fit in this slice, so a frame is never overrun */
+        Uint32 nodesPerRootMove = ( Depth == 2 ? 1 : 1 + (SearchBeamWidth*7) );
+        if ( spent + (Uint32)(nodesPerRootMove * MicrosecondsPerNode) > microseconds )  break;
+
+        DeeperValue[Index] = SearchRootMove(RootMove[Index], Depth);
+        if (Index == 0 || DeeperValue[Index] < DeeperValue[DepthBestIndex])  DepthBestIndex = Index;
+        Index++;
+
+        spent = MicrosecondsSince(startTicks, startNodes);
+    }
+
+    if (Nodes > startNodes && NodeBudget == false)
+        MicrosecondsPerNode = ( (MicrosecondsPerNode * 3.0f) + ( (float)spent / (float)(Nodes - startNodes) ) ) / 4.0f;
+
+    /* Best so far: a partly searched depth always includes the previous depth's best, it is searched first */
+    int best = ( Index > 0 ? DepthBestIndex : 0 );
+    BestValue = ( Index > 0 ? DeeperValue[best] : RootValue[best] );
+
+    if (RootCount > 0)
+    {
+        BestMoveX = Board[0]->MoveX[ RootMove[best] ];
+        BestRotation = Board[0]->MoveRotation[ RootMove[best] ];
+    }
+
+    MicrosecondsUsed+=spent;
+    return(spent);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Search::StartRollouts(Uint64 seed)
+{
+    /* Start() already sorted the root moves, so the candidates are the greedy A.I.'s favourites */
+    RolloutCandidates = ( RootCount < RolloutMaxCandidates ? RootCount : RolloutMaxCandidates );
+    RolloutsDone = 0;
+    RolloutSeed = seed;
+
+    for (int candidate = 0; candidate < RolloutMaxCandidates; candidate++)
+    {
+        RolloutTotal[candidate] = 0.0f;
+        RolloutSquares[candidate] = 0.0f;
+    }
+
+    CompletedDepth = 1;
+    Done = (RolloutCandidates < 2);
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Search::ContinueRollouts(Rollout *pool, Uint32 microseconds)
+{
+Uint64 startTicks = SDL_GetPerformanceCounter();
+Uint32 spent;
+int count;
+int best = 0;
+float bestBound = 0.0f;
+
+    if (Done == true)  return(0);
+
+    /* Whole rounds only, as many as should fit in this slice with every thread of the pool playing them */
+    count = (int)( (float)microseconds / (NodeBudget == true ? (float)RolloutNominalMicroseconds : MicrosecondsPerRollout) );
+    if (count > RolloutMaxBatch)  count = RolloutMaxBatch;
+    if (count > (int)(RolloutsPerMove - RolloutsDone))  count = (int)(RolloutsPerMove - RolloutsDone);
+    count-=(count % RolloutCandidates);
+    if (count < 1)  return(0);
+
+    pool->Run(this, RolloutsDone, count);
+
+    /* Every candidate of a round saw the same future, so each is scored by how much better it did than the greedy move */
+    for (int round = 0; round < count; round+=RolloutCandidates)
+        for (int candidate = 1; candidate < RolloutCandidates; candidate++)
+        {
+            float gain = ( pool->Result[round + candidate] - pool->Result[round] );
+
+            RolloutTotal[candidate]+=gain;
+            RolloutSquares[candidate]+=(gain * gain);
+        }
+
+    RolloutsDone+=count;
+    Nodes+=count;
+
+    /* A few noisy rollouts must not talk the A.I. out of the greedy move, so only a confident gain counts */
+    float rounds = (float)(RolloutsDone / RolloutCandidates);
+    for (int candidate = 1; candidate < RolloutCandidates; candidate++)
+    {
+        float mean = ( RolloutTotal[candidate] / rounds );
+        float variance = ( (RolloutSquares[candidate] / rounds) - (mean * mean) );
+        float bound = ( mean - ( RolloutConfidence * sqrtf( (variance > 0.0f ? variance : 0.0f) / rounds ) ) );
+
+        if (bound > bestBound && rounds >= RolloutMinimumRounds)
+        {
+            best = candidate;
+            bestBound = bound;
+        }
+    }
+
+    BestMoveX = Board[0]->MoveX[ RootMove[best] ];
+    BestRotation = Board[0]->MoveRotation[ RootMove[best] ];
+    BestValue = -bestBound;
+
+    Done = (RolloutsDone >= RolloutsPerMove);
+
+    if (NodeBudget == true)  spent = (count * RolloutNominalMicroseconds);
+    else
+    {
+        spent = MicrosecondsSince(startTicks, 0);
+        MicrosecondsPerRollout = ( (MicrosecondsPerRollout * 3.0f) + ( (float)spent / (float)count ) ) / 4.0f;
+    }
+
+    MicrosecondsUsed+=spent;
+    return(spent);
+}
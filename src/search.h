@@ -0,0 +1,110 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SEARCH
+#define SEARCH
+
+class Neural;
+struct NeuralLanes;
+class Rollout;
+
+/* Anytime, iteratively deepened computer player A.I. search that can be resumed frame after frame */
+class Search
+{
+public:
+
+    #define SearchMaxDepth                  3
+    #define SearchBeamWidth                 4   /* Depth 3 only follows the best few placements of the next piece */
+    #define SearchReplanCandidates          6   /* Root moves a re-plan keeps from the search it replaces */
+    #define SearchLostValue                 1000000.0f
+    #define SearchLookaheadStartY           5   /* Pieces not yet in play are tried from below the spawn gate */
+    #define SearchNominalNodeMicroseconds   4   /* Charged per node instead of the clock when NodeBudget is set */
+
+    #define SearchGiftOfSight               0
+    #define SearchNeural                    1
+    int Evaluator;
+    Neural *Network;
+    NeuralLanes *Lanes;
+
+    Bitboard *Board[SearchMaxDepth];
+    Bitboard *Scratch;
+
+    /* Value is what a placement is worth when it ends a line of play, Step what it adds when it does not */
+    float Value[SearchMaxDepth][BitboardMaxMoves];
+    float Step[SearchMaxDepth][BitboardMaxMoves];
+
+    Uint8 MaxRotation[8];
+
+    Uint8 Piece;
+    Uint8 NextPiece;
+    int StartX;
+    int EndX;
+
+    int RootCount;
+    int RootMove[BitboardMaxMoves];
+    float RootValue[BitboardMaxMoves];
+    float DeeperValue[BitboardMaxMoves];
+
+    int MaxDepth;  /* 1 to SearchMaxDepth, 1 is the original greedy A.I. */
+    int Depth;
+    int CompletedDepth;
+    int Index;
+    int DepthBestIndex;
+    bool Done;
+
+    int BestMoveX;
+    int BestRotation;
+    float BestValue;
+
+    bool NodeBudget;
+    Uint32 Nodes;
+    Uint32 MicrosecondsUsed;
+    float MicrosecondsPerNode;
+
+    /* Monte Carlo A.I.: rollout N plays out root move N % RolloutCandidates, totals are gains over root move 0 */
+    int RolloutCandidates;
+    Uint32 RolloutsDone;
+    Uint64 RolloutSeed;
+    float RolloutTotal[BitboardMaxMoves];
+    float RolloutSquares[BitboardMaxMoves];
+    float MicrosecondsPerRollout;
+
+	Search(void);
+	virtual ~Search(void);
+
+    void LoadPieceData(Uint8 pieceData[8][5][17], Uint8 maxRotation[8]);
+
+    static float GiftOfSightValue(Bitboard *board, int move);
+    void ScoreMoves(int depth, Uint8 piece, int startY);
+    float BestReplyValue(int depth, Uint8 piece, int startY);
+    float SearchRootMove(int root, int depth);
+    void SortRootMoves(void);
+
+    Uint32 MicrosecondsSince(Uint64 startTicks, Uint32 startNodes);
+
+    void Start(Bitboard *root, Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY);
+    void Replan(Bitboard *root, Uint8 piece, Uint8 nextPiece, int startX, int endX, int startY);
+    Uint32 Continue(Uint32 microseconds);
+
+    void StartRollouts(Uint64 seed);
+    Uint32 ContinueRollouts(Rollout *pool, Uint32 microseconds);
+};
+
+#endif
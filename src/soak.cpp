@@ -0,0 +1,427 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(__linux__)
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#endif
+
+#include "SDL.h"
+#include "SDL_ttf.h"
+
+#include "visuals.h"
+#include "input.h"
+#include "screens.h"
+#include "bitboard.h"
+#include "logic.h"
+#include "transposition.h"
+#include "search.h"
+
+#include "soak.h"
+
+extern Visuals* visuals;
+extern Screens* screens;
+extern Logic* logic;
+
+static const char *SoakModeName[SoakModes] = { "Original", "Time Attack 30", "Time Attack 60", "Time Attack 120"
+                                             , "Twenty Line Challenge", "Crisis", "Story" };
+
+//-------------------------------------------------------------------------------------------------
+Soak::Soak(void)
+{
+    Seed = 1;
+
+    Pieces = 0;
+    Frames = 0;
+    Games = 0;
+    GamesCutShort = 0;
+    StoryTransitions = 0;
+    for (int mode = 0; mode < SoakModes; mode++)  ModeGames[mode] = 0;
+
+    Violations = 0;
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        LastScore[player] = 0;
+        LastStatus[player] = GameOver;
+    }
+
+    Samples = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Soak::~Soak(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Soak::ResidentMemoryKB(void)
+{
+#if defined(__linux__)
+    FILE *file = fopen("/proc/self/statm", "r");
+    long size = 0;
+    long resident = 0;
+
+    if (file == NULL)  return(0);
+    if (fscanf(file, "%ld %ld", &size, &resident) != 2)  resident = 0;
+    fclose(file);
+
+    return( (Uint32)(resident * (sysconf(_SC_PAGESIZE) / 1024)) );
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)  return(0);
+    return( (Uint32)(counters.WorkingSetSize / 1024) );
+#else
+    return(0);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+int Soak::CachedTextures(void)
+{
+int textures = 0;
+
+    if (visuals == NULL)  return(0);
+
+    for (int index = 0; index < NumberOfTextsCached; index++)
+    {
+        if (visuals->TextTexture[index] != NULL)  textures++;
+    }
+
+    return(textures);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::Report(int player, const char *invariant, int x, int y, int value)
+{
+    Violations++;
+    if (Violations > SoakMaxReports)  return;
+
+    printf("*****ERROR: %s game %u, frame %llu, player %i: %s (x=%i y=%i value=%i)*****\n", SoakModeName[logic->GameMode], Games
+           , (unsigned long long)Frames, player+1, invariant, x, y, value);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::CheckInvariants(void)
+{
+Logic::PlayData *playData;
+int playersAlive = 0;
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        if (logic->PlayerData[player].PlayerStatus != GameOver)  playersAlive++;
+    }
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        playData = &logic->PlayerData[player];
+
+        for (int y = 0; y < 26; y++)
+        {
+            for (int x = 0; x < 15; x++)
+            {
+                int value = playData->Playfield[x][y];
+                bool box = (value > 9 && value < 30);  /* 20 and up while the line flashes */
+
+                /* The play area holds nothing, the drop shadow (1) or boxes, the spawn area above it can also show the next piece */
+                if (x > 1 && x < 12 && y > 4 && y < 24)
+                {
+                    if (value != 0 && value != 1 && box == false)  Report(player, "unknown value in the play area", x, y, value);
+                }
+                else if (x > 4 && x < 9 && y < 5)
+                {
+                    if (value != 0 && value != 255 && box == false)  Report(player, "unknown value in the spawn area", x, y, value);
+                }
+                else if (value != 255)
+                {
+                    if (box == true)  Report(player, "box outside columns 2 to 11", x, y, value);
+                    else  Report(player, "wall broken", x, y, value);
+                }
+            }
+        }
+
+        int bagPieces = 0;
+        for (int index = 1; index < 8; index++)
+        {
+            int piece = playData->PieceBag[0][index];
+
+            if ( piece < 1 || piece > 7 || (bagPieces & (1 << piece)) != 0 )  Report(player, "piece bag does not hold each piece once", index, 0, piece);
+            else  bagPieces |= (1 << piece);
+        }
+        if (playData->PieceBagIndex < 1 || playData->PieceBagIndex > 7)  Report(player, "piece bag index out of range", 0, 0, playData->PieceBagIndex);
+
+        /* Crisis mode only keeps a score once one player is left, until then it is zeroed after every move */
+        if (logic->GameMode == CrisisMode && playersAlive > 1)  LastScore[player] = 0;
+        else if (playData->Score < LastScore[player])  Report(player, "score went down", 0, 0, (int)(LastScore[player] - playData->Score));
+        LastScore[player] = playData->Score;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::SetupGame(void)
+{
+int mode = (Games % SoakModes);
+
+    logic->GameMode = mode;
+    logic->CPUPlayerEnabled = SoakSkill;
+
+    /* Every game gets its own seed, so a reported frame can be played again from the game number alone */
+    logic->RandomState = ( (Seed * 2654435761u) ^ ((Games + 1) * 2246822519u) );
+    if (logic->RandomState == 0)  logic->RandomState = 1;
+    srand(logic->RandomState);
+
+    logic->SetupForNewGame();
+
+    /* The story screen sets up the first level itself once it has faded in */
+    if (mode == StoryMode)
+    {
+        logic->SetupForNewLevelStory();
+        logic->PlayersCanJoin = false;
+    }
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        logic->AISearch[player]->NodeBudget = true;
+
+        LastScore[player] = logic->PlayerData[player].Score;
+        LastStatus[player] = logic->PlayerData[player].PlayerStatus;
+    }
+
+    ModeGames[mode]++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::RunFrame(void)
+{
+    /* Same order as the playing screens: run the engine, put the pieces in, draw, take the pieces out again */
+    logic->RunTetriGameEngine();
+
+    for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
+    {
+        if (logic->PlayerData[logic->Player].PlayerStatus != FlashingCompletedLines
+            && logic->PlayerData[logic->Player].PlayerStatus != ClearingCompletedLines)
+        {
+            logic->DeletePieceFromPlayfieldMemory(Current);
+            logic->AddPieceToPlayfieldMemory(DropShadow);
+            logic->AddPieceToPlayfieldMemory(Current);
+        }
+    }
+
+    CheckInvariants();
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        if (logic->PlayerData[player].PlayerStatus == NewPieceDropping && LastStatus[player] != NewPieceDropping)  Pieces++;
+        LastStatus[player] = logic->PlayerData[player].PlayerStatus;
+    }
+
+    if (visuals != NULL)  DrawHUD();
+
+    for (logic->Player = 0; logic->Player < NumberOfPlayers; logic->Player++)
+    {
+        if (logic->PlayerData[logic->Player].PlayerStatus != FlashingCompletedLines
+            && logic->PlayerData[logic->Player].PlayerStatus != ClearingCompletedLines)
+        {
+            logic->DeletePieceFromPlayfieldMemory(Current);
+            logic->DeletePieceFromPlayfieldMemory(DropShadow);
+        }
+    }
+
+    if (logic->GameMode == StoryMode && logic->PlayerData[1].PlayerStatus != GameOver)
+    {
+        int level = logic->PlayerData[1].Level;
+
+        if ( (level == 3 || level == 6 || level == 9) && logic->StoryShown[level] == 0 )
+        {
+            logic->StoryShown[level] = 1;
+            logic->SetupForNewLevelStory();
+            logic->PlayersCanJoin = false;
+
+            LastStatus[1] = logic->PlayerData[1].PlayerStatus;
+            StoryTransitions++;
+        }
+    }
+
+    Frames++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::DrawHUD(void)
+{
+char text[64];
+
+    visuals->ClearScreenBufferWithColor(0, 0, 0, 255);
+
+    for (int player = 0; player < NumberOfPlayers; player++)
+    {
+        float screenX = logic->PlayerData[player].PlayersPlayfieldScreenX;
+
+        if (logic->PlayerData[player].PlayerStatus == GameOver)  continue;
+
+        snprintf(text, sizeof(text), "%llu", (unsigned long long)logic->PlayerData[player].Score);
+        visuals->DrawTextOntoScreenBuffer(text, visuals->Font[1], screenX, 440, JustifyCenterOnPoint, 255, 255, 255, 1, 1, 1);
+
+        snprintf(text, sizeof(text), "%u", logic->PlayerData[player].Lines);
+        visuals->DrawTextOntoScreenBuffer(text, visuals->Font[1], screenX, 460, JustifyCenterOnPoint, 255, 255, 255, 1, 1, 1);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Soak::TakeSample(double seconds)
+{
+    if (Samples > SoakSamples)  return;
+
+    SamplePieces[Samples] = Pieces;
+    SampleSeconds[Samples] = seconds;
+    SampleMemoryKB[Samples] = ResidentMemoryKB();
+    SampleTextures[Samples] = CachedTextures();
+
+    double rate = 0.0;
+    if (Samples > 0 && seconds > SampleSeconds[Samples-1])
+        rate = ( (double)(Pieces - SamplePieces[Samples-1]) / (seconds - SampleSeconds[Samples-1]) );
+
+    if (Samples % 10 == 0)
+        printf("  %12llu pieces %9.1f s %9.0f pieces/s %8u KB resident %4i text textures\n", (unsigned long long)Pieces, seconds, rate
+               , SampleMemoryKB[Samples], SampleTextures[Samples]);
+
+    Samples++;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Soak::WriteCSV(const char *filename)
+{
+FILE *file = fopen(filename, "w");
+
+    if (file == NULL)
+    {
+        printf("*****ERROR: Could not write \"%s\"*****\n", filename);
+        return(false);
+    }
+
+    fprintf(file, "pieces,seconds,pieces_per_second,resident_kb,text_textures\n");
+    for (int sample = 0; sample < Samples; sample++)
+    {
+        double rate = 0.0;
+        if (sample > 0 && SampleSeconds[sample] > SampleSeconds[sample-1])
+            rate = ( (double)(SamplePieces[sample] - SamplePieces[sample-1]) / (SampleSeconds[sample] - SampleSeconds[sample-1]) );
+
+        fprintf(file, "%llu,%.3f,%.0f,%u,%i\n", (unsigned long long)SamplePieces[sample], SampleSeconds[sample], rate
+                , SampleMemoryKB[sample], SampleTextures[sample]);
+    }
+
+    fclose(file);
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Soak::Run(Uint64 pieces, Uint32 seed, const char *filename)
+{
+Uint64 sampleEvery = ( pieces / SoakSamples );
+Uint64 nextSample;
+Uint32 gameFrames = 0;
+Uint64 startTicks;
+bool passed;
+
+    if (sampleEvery < 1)  sampleEvery = 1;
+
+    Seed = seed;
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+
+    logic->VerifyPlayfieldHash = true;
+    logic->PlayfieldHashMismatches = 0;
+    logic->AITransposition->Clear();
+
+    printf("Soak test: %llu pieces through every game mode, seed %u, C.P.U. players at skill %i%s\n", (unsigned long long)pieces, Seed
+           , SoakSkill, (visuals == NULL ? ", no window so no text textures" : ""));
+
+    startTicks = SDL_GetPerformanceCounter();
+
+    SetupGame();
+    TakeSample(0.0);
+    nextSample = sampleEvery;
+
+    while (Pieces < pieces)
+    {
+        RunFrame();
+        gameFrames++;
+
+        bool gameOver = true;
+        for (int player = 0; player < NumberOfPlayers; player++)
+        {
+            if (logic->PlayerData[player].PlayerStatus != GameOver)  gameOver = false;
+        }
+
+        if (gameOver == true || gameFrames >= SoakMaxGameFrames)
+        {
+            if (gameOver == false)  GamesCutShort++;
+
+            Games++;
+            gameFrames = 0;
+            SetupGame();
+        }
+
+        if (Pieces >= nextSample)
+        {
+            TakeSample( (double)(SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency() );
+            nextSample+=sampleEvery;
+        }
+    }
+
+    printf("  Games: %u (%u cut short at %u frames), %llu frames, %u story level transitions\n", Games, GamesCutShort, SoakMaxGameFrames
+           , (unsigned long long)Frames, StoryTransitions);
+    for (int mode = 0; mode < SoakModes; mode++)  printf("    %-22s %u\n", SoakModeName[mode], ModeGames[mode]);
+
+    /* The first sample is taken before the caches have been touched, so growth is measured from the second */
+    Sint64 memoryDrift = 0;
+    if (Samples > 2)  memoryDrift = ( (Sint64)SampleMemoryKB[Samples-1] - (Sint64)SampleMemoryKB[1] );
+
+    /* Speed of the first tenth of the run against the last tenth */
+    if (Samples > 2)
+    {
+        int window = ( Samples / 10 > 0 ? Samples / 10 : 1 );
+        double firstRate = ( (double)(SamplePieces[window] - SamplePieces[0]) / (SampleSeconds[window] - SampleSeconds[0]) );
+        double lastRate = ( (double)(SamplePieces[Samples-1] - SamplePieces[Samples-1-window])
+                           / (SampleSeconds[Samples-1] - SampleSeconds[Samples-1-window]) );
+
+        printf("  Resident memory %+lld KB since the first interval, last tenth ran at %.0f%% of the first tenth's speed\n"
+               , (long long)memoryDrift, (firstRate > 0.0 ? 100.0 * lastRate / firstRate : 0.0));
+    }
+
+    if (Violations > 0)  printf("*****ERROR: %llu invariant violations*****\n", (unsigned long long)Violations);
+    if (logic->PlayfieldHashMismatches > 0)  printf("*****ERROR: %u stale playfield hashes*****\n", logic->PlayfieldHashMismatches);
+    if (memoryDrift > SoakMemoryDriftKB)  printf("*****ERROR: Resident memory grew by %lld KB*****\n", (long long)memoryDrift);
+
+    passed = (Violations == 0 && logic->PlayfieldHashMismatches == 0 && memoryDrift <= SoakMemoryDriftKB);
+    if (passed == true)  printf("  No invariant violations.\n");
+
+    if (filename != NULL)  WriteCSV(filename);
+
+    logic->VerifyPlayfieldHash = false;
+    for (int player = 0; player < NumberOfPlayers; player++)  logic->AISearch[player]->NodeBudget = false;
+
+    return(passed);
+}
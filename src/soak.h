@@ -0,0 +1,75 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SOAK
+#define SOAK
+
+/* Long-run soak test: "tc4-tribute3 --soak [pieces] [seed] [CSV file]" */
+/* Seeded C.P.U. players go through every game mode in turn while the engine's invariants are checked every frame */
+/* Memory and cached texture counts are sampled as it goes, so drift over a long session shows up in the CSV */
+class Soak
+{
+public:
+
+    #define SoakModes               7
+    #define SoakSkill               1
+    #define SoakMaxGameFrames       5000000  /* A game still going after this many frames is ended and the next mode starts */
+    #define SoakSamples             100
+    #define SoakMaxReports          10
+    #define SoakMemoryDriftKB       4096     /* Resident memory allowed to grow after the first sample */
+
+    Uint32 Seed;
+
+    Uint64 Pieces;
+    Uint64 Frames;
+    Uint32 Games;
+    Uint32 GamesCutShort;
+    Uint32 StoryTransitions;
+    Uint32 ModeGames[SoakModes];
+
+    Uint64 Violations;
+    Uint64 LastScore[NumberOfPlayers];
+    Sint16 LastStatus[NumberOfPlayers];
+
+    int Samples;
+    Uint64 SamplePieces[SoakSamples+1];
+    double SampleSeconds[SoakSamples+1];
+    Uint32 SampleMemoryKB[SoakSamples+1];
+    int SampleTextures[SoakSamples+1];
+
+	Soak(void);
+	virtual ~Soak(void);
+
+    static Uint32 ResidentMemoryKB(void);
+    int CachedTextures(void);
+
+    void Report(int player, const char *invariant, int x, int y, int value);
+    void CheckInvariants(void);
+
+    void SetupGame(void);
+    void RunFrame(void);
+    void DrawHUD(void);
+    void TakeSample(double seconds);
+
+    bool WriteCSV(const char *filename);
+    bool Run(Uint64 pieces, Uint32 seed, const char *filename);
+};
+
+#endif
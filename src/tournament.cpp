@@ -0,0 +1,295 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "SDL.h"
+
+#include "bitboard.h"
+#include "transposition.h"
+#include "neural.h"
+#include "rollout.h"
+#include "search.h"
+#include "logic.h"
+#include "screens.h"
+
+#include "tournament.h"
+
+extern Screens* screens;
+extern Logic* logic;
+
+//-------------------------------------------------------------------------------------------------
+Tournament::Tournament(void)
+{
+    Configs = 0;
+    Matches = 0;
+    MaxFrames = 0;
+    Threads = 0;
+
+    AddConfig("Greedy", SearchGiftOfSight, 1, 1000, false);
+    AddConfig("Search 250 us", SearchGiftOfSight, SearchMaxDepth, 250, false);
+    AddConfig("Search 1000 us", SearchGiftOfSight, SearchMaxDepth, 1000, false);
+    AddConfig("Neural 1000 us", SearchNeural, SearchMaxDepth, 1000, false);
+    AddConfig("Monte Carlo 1000 us", SearchGiftOfSight, SearchMaxDepth, 1000, true);
+}
+
+//-------------------------------------------------------------------------------------------------
+Tournament::~Tournament(void)
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+void Tournament::AddConfig(const char *name, int evaluator, int maxDepth, Uint32 moveBudget, bool rollouts)
+{
+    if (Configs == TournamentMaxConfigs)  return;
+
+    ConfigName[Configs] = name;
+    ConfigEvaluator[Configs] = evaluator;
+    ConfigMaxDepth[Configs] = maxDepth;
+    ConfigMoveBudget[Configs] = moveBudget;
+    ConfigRollouts[Configs] = rollouts;
+    Elo[Configs] = TournamentEloStart;
+
+    Configs++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Tournament::ScheduleMatches(int rounds)
+{
+    Matches = 0;
+
+    /* Every line-up of four different configurations, in every seat rotation, since the seats are not equal */
+    for (int round = 0; round < rounds; round++)
+        for (int a = 0; a < Configs; a++)
+            for (int b = a+1; b < Configs; b++)
+                for (int c = b+1; c < Configs; c++)
+                    for (int d = c+1; d < Configs; d++)
+                    {
+                        int lineUp[4] = { a, b, c, d };
+
+                        for (int rotation = 0; rotation < 4 && Matches < TournamentMaxMatches; rotation++)
+                        {
+                            for (int seat = 0; seat < 4; seat++)  MatchSeat[Matches][seat] = lineUp[ (seat + rotation) % 4 ];
+
+                            /* A rotation replays the same pieces, so only the seating differs, every other line-up gets its own */
+                            Uint32 lineUpIndex = (Uint32)( ( ( (round * TournamentMaxConfigs + a) * TournamentMaxConfigs + b ) * TournamentMaxConfigs + c )
+                                                           * TournamentMaxConfigs + d );
+                            MatchSeed[Matches] = ( TournamentSeed + lineUpIndex ) * 2654435761U;
+                            if (MatchSeed[Matches] == 0)  MatchSeed[Matches] = 1;
+
+                            Matches++;
+                        }
+                    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Tournament::PlayMatch(Logic *game, int match)
+{
+Uint32 frames = 0;
+int playing = 4;
+
+    game->GameMode = CrisisMode;
+    game->CPUPlayerEnabled = TournamentSkill;
+    game->RandomState = MatchSeed[match];
+    game->AITransposition->Clear();
+    game->SetupForNewGame();
+    game->PlayersCanJoin = false;
+
+    for (int seat = 0; seat < 4; seat++)
+    {
+        int config = MatchSeat[match][seat];
+
+        game->PlayerData[seat].AIEvaluator = ConfigEvaluator[config];
+        game->PlayerData[seat].AIMaxDepth = ConfigMaxDepth[config];
+        game->PlayerData[seat].AIMoveBudget = ConfigMoveBudget[config];
+        game->PlayerData[seat].AIRollouts = ConfigRollouts[config];
+        game->PlayerData[seat].AIMoves = 0;
+        game->PlayerData[seat].AIMicroseconds = 0;
+
+        /* Budgets in nodes rather than from the clock, so a match plays the same on any machine and any thread count */
+        game->AISearch[seat]->NodeBudget = true;
+
+        MatchKnockedOut[match][seat] = 0;
+    }
+
+    while (playing > 1 && frames < MaxFrames)
+    {
+        game->RunTetriGameEngine();
+        frames++;
+
+        for (int seat = 0; seat < 4; seat++)
+        {
+            game->PlayerData[seat].TimeToDropPiece = 47;
+
+            if (game->PlayerData[seat].PlayerStatus == GameOver && MatchKnockedOut[match][seat] == 0)
+            {
+                MatchKnockedOut[match][seat] = frames;
+                playing--;
+            }
+        }
+    }
+
+    MatchFrames[match] = frames;
+    for (int seat = 0; seat < 4; seat++)
+    {
+        MatchLines[match][seat] = game->PlayerData[seat].Lines;
+        MatchMoves[match][seat] = game->PlayerData[seat].AIMoves;
+        MatchMicroseconds[match][seat] = game->PlayerData[seat].AIMicroseconds;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+int Tournament::WorkerThread(void *data)
+{
+Tournament *tournament = (Tournament*)data;
+Logic *game = tournament->Game[ SDL_AtomicAdd(&tournament->WorkerIndex, 1) ];
+int match;
+
+    while ( (match = SDL_AtomicAdd(&tournament->NextMatch, 1)) < tournament->Matches )  tournament->PlayMatch(game, match);
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+float Tournament::SeatScore(int match, int seat, int otherSeat)
+{
+Uint32 out = MatchKnockedOut[match][seat];
+Uint32 otherOut = MatchKnockedOut[match][otherSeat];
+
+    /* Lasting longer wins, seats still playing at the end all draw */
+    if (out == otherOut)  return(0.5f);
+    if (out == 0)  return(1.0f);
+    if (otherOut == 0)  return(0.0f);
+
+    return(out > otherOut ? 1.0f : 0.0f);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Tournament::RateConfigs(void)
+{
+    for (int config = 0; config < Configs; config++)  Elo[config] = TournamentEloStart;
+
+    /* A four player match counts as six head to head games, in match order so the ratings never depend on the threads */
+    for (int match = 0; match < Matches; match++)
+    {
+        float change[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (int seat = 0; seat < 4; seat++)
+            for (int otherSeat = 0; otherSeat < 4; otherSeat++)
+            {
+                if (otherSeat == seat)  continue;
+
+                float expected = 1.0f / ( 1.0f + powf( 10.0f, (Elo[ MatchSeat[match][otherSeat] ] - Elo[ MatchSeat[match][seat] ]) / 400.0f ) );
+                change[seat]+=( (TournamentEloK / 3.0f) * (SeatScore(match, seat, otherSeat) - expected) );
+            }
+
+        for (int seat = 0; seat < 4; seat++)  Elo[ MatchSeat[match][seat] ]+=change[seat];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Tournament::Run(int rounds, Uint32 maxFrames)
+{
+SDL_Thread *worker[TournamentMaxThreads];
+Uint64 startTicks;
+double seconds;
+Uint64 totalFrames = 0;
+
+    if (rounds < 1)  rounds = 1;
+    MaxFrames = maxFrames;
+    ScheduleMatches(rounds);
+
+    Threads = SDL_GetCPUCount();
+    if (Threads > TournamentMaxThreads)  Threads = TournamentMaxThreads;
+    if (Threads > Matches)  Threads = Matches;
+    if (Threads < 1)  Threads = 1;
+
+    printf("A.I. tournament: %i configurations, %i four player Crisis mode matches, at most %u frames each, %i thread%s\n"
+           , Configs, Matches, MaxFrames, Threads, (Threads == 1 ? "" : "s"));
+
+    /* Same setup as the "A.I. TEST" screen, every seat is a C.P.U. player */
+    screens->ScreenToDisplay = TestComputerSkillScreen;
+
+    /* One game per thread, matches already keep every core busy so the rollout pools are never started */
+    for (int thread = 0; thread < Threads; thread++)
+    {
+        Game[thread] = new Logic();
+        Game[thread]->AITrace = logic->AITrace;
+    }
+
+    SDL_AtomicSet(&WorkerIndex, 1);
+    SDL_AtomicSet(&NextMatch, 0);
+
+    startTicks = SDL_GetPerformanceCounter();
+    for (int thread = 1; thread < Threads; thread++)  worker[thread] = SDL_CreateThread(WorkerThread, "Tournament", this);
+
+    int match;
+    while ( (match = SDL_AtomicAdd(&NextMatch, 1)) < Matches )  PlayMatch(Game[0], match);
+
+    for (int thread = 1; thread < Threads; thread++)  SDL_WaitThread(worker[thread], NULL);
+    seconds = ( (double)(SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency() );
+
+    for (int thread = 0; thread < Threads; thread++)  delete Game[thread];
+
+    for (match = 0; match < Matches; match++)  totalFrames+=MatchFrames[match];
+    printf("  %i matches in %.1f s (%.1f matches per second, %.0f frames per second)\n", Matches, seconds
+           , Matches / seconds, totalFrames / seconds);
+
+    RateConfigs();
+
+    printf("   Elo  Wins  Place  Lines  Moves  A.I. us/move  Configuration\n");
+    for (int config = 0; config < Configs; config++)
+    {
+        int played = 0;
+        int wins = 0;
+        float place = 0.0f;
+        Uint32 lines = 0;
+        Uint32 moves = 0;
+        Uint64 microseconds = 0;
+
+        for (match = 0; match < Matches; match++)
+            for (int seat = 0; seat < 4; seat++)
+            {
+                if (MatchSeat[match][seat] != config)  continue;
+
+                float beaten = 0.0f;
+                for (int otherSeat = 0; otherSeat < 4; otherSeat++)
+                    if (otherSeat != seat)  beaten+=SeatScore(match, seat, otherSeat);
+
+                played++;
+                if (beaten == 3.0f)  wins++;
+                place+=(4.0f - beaten);
+                lines+=MatchLines[match][seat];
+                moves+=MatchMoves[match][seat];
+                microseconds+=MatchMicroseconds[match][seat];
+            }
+
+        if (played == 0)  continue;
+
+        printf("  %4.0f  %3.0f%%  %5.2f  %5.1f  %5.0f  %12.0f  %s\n", Elo[config], 100.0f * wins / played, place / played
+               , (float)lines / played, (float)moves / played, (moves > 0 ? (float)microseconds / moves : 0.0f), ConfigName[config]);
+    }
+
+    return(true);
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef TOURNAMENT
+#define TOURNAMENT
+
+class Logic;
+
+/* Headless round-robin of A.I. configurations in four player Crisis mode matches: "tc4-tribute3 --tournament [rounds] [frames]" */
+class Tournament
+{
+public:
+
+    #define TournamentMaxConfigs    8
+    #define TournamentMaxMatches    2048
+    #define TournamentMaxThreads    16
+    #define TournamentSeed          0x7014A
+    #define TournamentSkill         3       /* Drop speed and rules of the skill 3 C.P.U. player, the configurations change its A.I. */
+    #define TournamentEloStart      1500.0f
+    #define TournamentEloK          16.0f
+
+    int Configs;
+    const char *ConfigName[TournamentMaxConfigs];
+    int ConfigEvaluator[TournamentMaxConfigs];
+    int ConfigMaxDepth[TournamentMaxConfigs];
+    Uint32 ConfigMoveBudget[TournamentMaxConfigs];
+    bool ConfigRollouts[TournamentMaxConfigs];
+
+    int Matches;
+    Uint32 MaxFrames;
+    int MatchSeat[TournamentMaxMatches][4];  /* Configuration playing in each seat */
+    Uint32 MatchSeed[TournamentMaxMatches];
+    Uint32 MatchFrames[TournamentMaxMatches];
+    Uint32 MatchKnockedOut[TournamentMaxMatches][4];  /* Frame the seat lost on, 0 if it was still playing at the end */
+    Uint32 MatchLines[TournamentMaxMatches][4];
+    Uint32 MatchMoves[TournamentMaxMatches][4];
+    Uint64 MatchMicroseconds[TournamentMaxMatches][4];
+
+    int Threads;
+    Logic *Game[TournamentMaxThreads];
+    SDL_atomic_t WorkerIndex;
+    SDL_atomic_t NextMatch;
+
+    float Elo[TournamentMaxConfigs];
+
+	Tournament(void);
+	virtual ~Tournament(void);
+
+    void AddConfig(const char *name, int evaluator, int maxDepth, Uint32 moveBudget, bool rollouts);
+    void ScheduleMatches(int rounds);
+
+    void PlayMatch(Logic *game, int match);
+    static int WorkerThread(void *data);
+
+    float SeatScore(int match, int seat, int otherSeat);
+    void RateConfigs(void);
+
+    bool Run(int rounds, Uint32 maxFrames);
+};
+
+#endif
@@ -0,0 +1,202 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "trace.h"
+
+//-------------------------------------------------------------------------------------------------
+Trace::Trace(void)
+{
+    for (int lane = 0; lane < TraceMaxLanes; lane++)  Lane[lane] = NULL;
+    Lanes = 0;
+    LaneLock = 0;
+
+    File = NULL;
+    Writer = NULL;
+    BlocksReady = NULL;
+    Quit = false;
+
+    RecordsWritten = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Trace::~Trace(void)
+{
+    Close();
+
+    for (int lane = 0; lane < TraceMaxLanes; lane++)  delete Lane[lane];
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Trace::Open(const char *filename)
+{
+TraceHeader header;
+
+    File = fopen(filename, "wb");
+    if (File == NULL)
+    {
+        printf("*****ERROR: Could not create A.I. decision trace \"%s\"*****\n", filename);
+        return(false);
+    }
+
+    header.Magic = TraceMagic;
+    header.Version = TraceVersion;
+    header.RecordSize = sizeof(TraceRecord);
+    fwrite(&header, sizeof(header), 1, File);
+
+    BlocksReady = SDL_CreateSemaphore(0);
+    Quit = false;
+    Writer = SDL_CreateThread(WriterThread, "Trace", this);
+
+    printf("A.I. decision trace: writing %i byte records to \"%s\"\n", (int)sizeof(TraceRecord), filename);
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Trace::Close(void)
+{
+Uint32 stalls = 0;
+
+    if (File == NULL)  return;
+
+    /* Games must have stopped: the writer saves what is full, then the partly filled blocks go out here */
+    Quit = true;
+    SDL_SemPost(BlocksReady);
+    SDL_WaitThread(Writer, NULL);
+    Writer = NULL;
+
+    WriteBlocks();
+    for (int lane = 0; lane < Lanes; lane++)
+    {
+        TraceLane *traceLane = Lane[lane];
+
+        fwrite( traceLane->Block[traceLane->Filled % TraceBlocks], sizeof(TraceRecord), traceLane->Count, File );
+        RecordsWritten+=traceLane->Count;
+        traceLane->Count = 0;
+
+        stalls+=traceLane->Stalls;
+    }
+
+    fclose(File);
+    File = NULL;
+    SDL_DestroySemaphore(BlocksReady);
+    BlocksReady = NULL;
+
+    printf( "A.I. decision trace: %llu records (%.1f MB) from %i lane%s, the game waited for the writer %u time%s\n"
+           , (unsigned long long)RecordsWritten, (RecordsWritten * sizeof(TraceRecord)) / 1048576.0, (int)Lanes, (Lanes == 1 ? "" : "s")
+           , stalls, (stalls == 1 ? "" : "s") );
+}
+
+//-------------------------------------------------------------------------------------------------
+int Trace::OpenLane(void)
+{
+int lane = -1;
+
+    SDL_AtomicLock(&LaneLock);
+
+    if (Lanes < TraceMaxLanes)
+    {
+        lane = Lanes;
+
+        if (Lane[lane] == NULL)  Lane[lane] = new TraceLane();
+        Lane[lane]->Count = 0;
+        Lane[lane]->Filled = 0;
+        Lane[lane]->Flushed = 0;
+        Lane[lane]->Stalls = 0;
+
+        /* Published last, so the writer never sees a lane that is not ready */
+        Lanes = (lane + 1);
+    }
+
+    SDL_AtomicUnlock(&LaneLock);
+
+    if (lane == -1)  printf("*****ERROR: A.I. decision trace is out of lanes*****\n");
+    return(lane);
+}
+
+//-------------------------------------------------------------------------------------------------
+Trace::TraceRecord *Trace::NextRecord(int lane)
+{
+TraceLane *traceLane = Lane[lane];
+
+    /* Only the lane's own thread gets here, the writer only ever moves Flushed forward */
+    if (traceLane->Count == 0)
+    {
+        while ( (traceLane->Filled - traceLane->Flushed.load(std::memory_order_acquire)) >= TraceBlocks )
+        {
+            traceLane->Stalls++;
+            SDL_SemPost(BlocksReady);
+            SDL_Delay(1);
+        }
+    }
+
+    return( &traceLane->Block[ traceLane->Filled % TraceBlocks ][ traceLane->Count ] );
+}
+
+//-------------------------------------------------------------------------------------------------
+void Trace::CommitRecord(int lane)
+{
+TraceLane *traceLane = Lane[lane];
+
+    traceLane->Count++;
+    if (traceLane->Count < TraceBlockRecords)  return;
+
+    traceLane->Count = 0;
+    traceLane->Filled.fetch_add(1, std::memory_order_release);
+    SDL_SemPost(BlocksReady);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Trace::WriterThread(void *data)
+{
+Trace *trace = (Trace*)data;
+
+    while (trace->Quit == false)
+    {
+        SDL_SemWait(trace->BlocksReady);
+        trace->WriteBlocks();
+    }
+
+    return(0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Trace::WriteBlocks(void)
+{
+    for (int lane = 0; lane < Lanes; lane++)
+    {
+        TraceLane *traceLane = Lane[lane];
+        Uint32 filled = traceLane->Filled.load(std::memory_order_acquire);
+        Uint32 flushed = traceLane->Flushed;
+
+        for (; flushed != filled; flushed++)
+        {
+            fwrite(traceLane->Block[flushed % TraceBlocks], sizeof(TraceRecord), TraceBlockRecords, File);
+            RecordsWritten+=TraceBlockRecords;
+
+            traceLane->Flushed.store(flushed + 1, std::memory_order_release);
+        }
+    }
+}
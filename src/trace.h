@@ -0,0 +1,107 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef TRACE
+#define TRACE
+
+#include <atomic>
+
+/* Opt-in binary log of every C.P.U. placement for offline analysis: "tc4-tribute3 --trace [file] ..." */
+/* File = TraceHeader, then fixed size TraceRecords in host byte order, in the order lanes fill their blocks */
+class Trace
+{
+public:
+
+    #define TraceMagic          0x54344354  /* "TC4T" */
+    #define TraceVersion        1
+    #define TraceCandidates     44          /* 11 columns * 4 rotations, the most a piece can have */
+    #define TraceNoChoice       255
+    #define TraceMaxLanes       16
+    #define TraceBlocks         4           /* Per lane, so the game can fill one while the writer saves the others */
+    #define TraceBlockRecords   128
+
+    struct TraceHeader
+    {
+        Uint32 Magic;
+        Uint16 Version;
+        Uint16 RecordSize;
+    };
+
+    /* Features of one legal placement, as the Gift Of Sight A.I. sees them */
+    struct TraceCandidate
+    {
+        Uint8 X;
+        Uint8 Rotation;
+        Uint8 TrappedHoles;
+        Uint8 OneBlockCavernHoles;
+        Uint16 PlayfieldBoxEdges;
+        Uint8 PieceHeight;
+        Uint8 CompletedLines;
+    };
+
+    struct TraceRecord
+    {
+        Uint64 BoardHash;  /* Playfield Zobrist hash the decision was made on */
+        Uint8 Lane;
+        Uint8 Player;
+        Uint8 Piece;
+        Uint8 NextPiece;
+        Uint8 Candidates;
+        Uint8 Chosen;  /* Index into Candidate[], TraceNoChoice if the A.I. had no move */
+        Uint8 ChosenX;
+        Uint8 ChosenRotation;
+        TraceCandidate Candidate[TraceCandidates];
+    };
+
+    /* One per game thread: only that thread fills blocks, only the writer thread empties them */
+    struct TraceLane
+    {
+        TraceRecord Block[TraceBlocks][TraceBlockRecords];
+        int Count;  /* Records in the block being filled */
+        std::atomic<Uint32> Filled;
+        std::atomic<Uint32> Flushed;
+        Uint32 Stalls;
+    } *Lane[TraceMaxLanes];
+
+    std::atomic<int> Lanes;
+    SDL_SpinLock LaneLock;
+
+    FILE *File;
+    SDL_Thread *Writer;
+    SDL_sem *BlocksReady;
+    std::atomic<bool> Quit;
+
+    Uint64 RecordsWritten;
+
+	Trace(void);
+	virtual ~Trace(void);
+
+    bool Open(const char *filename);
+    void Close(void);
+
+    int OpenLane(void);
+    TraceRecord *NextRecord(int lane);
+    void CommitRecord(int lane);
+
+    static int WriterThread(void *data);
+    void WriteBlocks(void);
+};
+
+#endif
@@ -0,0 +1,332 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "trainer.h"
+
+#include "bitboard.h"
+#include "neural.h"
+#include "search.h"
+#include "logic.h"
+
+extern Logic* logic;
+
+//-------------------------------------------------------------------------------------------------
+Trainer::Trainer(void)
+{
+    Seed = 0x7C4A1;
+    BagIndex = 7;
+
+    Board = new Bitboard();
+    EmptyBoard = new Bitboard();
+    Lanes = new NeuralLanes();
+
+    SampleInput = new float[TrainerGamesPerGeneration * TrainerMaxPieces * NeuralInputs];
+    SampleTarget = new float[TrainerGamesPerGeneration * TrainerMaxPieces];
+    SampleCount = 0;
+
+    GamesLost = 0;
+    PiecesPlayed = 0;
+    LinesCleared = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Trainer::~Trainer(void)
+{
+    delete [] SampleTarget;
+    delete [] SampleInput;
+
+    delete Lanes;
+    delete EmptyBoard;
+    delete Board;
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Trainer::Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+
+    return(Seed);
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint8 Trainer::DrawPiece(void)
+{
+    /* Pieces come from a shuffled bag of all seven */
+    if (BagIndex == 7)
+    {
+        for (int index = 0; index < 7; index++)  Bag[index] = (index + 1);
+
+        for (int index = 6; index > 0; index--)
+        {
+            int swap = ( Random() % (index+1) );
+            Uint8 temp = Bag[index];
+            Bag[index] = Bag[swap];
+            Bag[swap] = temp;
+        }
+
+        BagIndex = 0;
+    }
+
+    BagIndex++;
+
+    return(Bag[BagIndex-1]);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Trainer::AddGarbageLine(void)
+{
+    if ( (Board->Box[5] & 0x0FFC) != 0 )  return(false);
+
+    for (int y = 5; y < 23; y++)
+    {
+        Board->Box[y] = Board->Box[y+1];
+        Board->Empty[y] = Board->Empty[y+1];
+    }
+
+    Uint16 hole = ( 1 << (2 + (Random() % 10)) );
+    Board->Box[23] = (0x0FFC & ~hole);
+    Board->Empty[23] = hole;
+
+    Board->BoxesChanged();
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Trainer::PlayGame(bool explore, bool record)
+{
+Search *search = logic->AISearch[0];
+Neural *network = logic->AINeural;
+Uint8 piece;
+Uint8 nextPiece;
+int firstSample = SampleCount;
+float target = 0.0f;
+
+    Board->CopyPlayfield(EmptyBoard);
+
+    BagIndex = 7;
+    nextPiece = DrawPiece();
+
+    for (int pieces = 0; pieces <= TrainerMaxPieces; pieces++)
+    {
+        piece = nextPiece;
+        nextPiece = DrawPiece();
+
+        if (pieces == TrainerMaxPieces)
+        {
+            /* Unfinished games are valued by what the network already thinks of the last playfield */
+            if (record == true && SampleCount > firstSample)
+            {
+                for (int input = 0; input < NeuralInputs; input++)
+                    Lanes->Input[input][0] = SampleInput[ ( (SampleCount-1) * NeuralInputs ) + input ];
+
+                network->Evaluate(Lanes, 1);
+                target = Lanes->Output[0];
+            }
+
+            break;
+        }
+
+        if ( (pieces % TrainerGarbageInterval) == (TrainerGarbageInterval-1) && AddGarbageLine() == false )
+        {
+            GamesLost++;
+            target = TrainerGameOverCost;
+            break;
+        }
+
+        search->Start( Board, piece, nextPiece, 2, 12, logic->PieceDropStartHeight[piece] );
+        if (search->RootCount == 0)
+        {
+            GamesLost++;
+            target = TrainerGameOverCost;
+            break;
+        }
+
+        int move = search->RootMove[0];
+        if (explore == true && (Random() % TrainerExploreOneIn) == 0)  move = search->RootMove[ Random() % search->RootCount ];
+
+        Bitboard *moves = search->Board[0];
+        int lines = moves->MoveCompletedLines[move];
+
+        search->Scratch->LoadPlacement(moves, piece, move);
+        Board->CopyPlayfield(search->Scratch);
+
+        PiecesPlayed++;
+        LinesCleared += lines;
+
+        if (record == true)
+        {
+            /* The lines of a placement are credited to the playfield before it, the network only learns what comes after */
+            if (SampleCount > firstSample)  SampleTarget[SampleCount-1] = -(float)lines;
+
+            network->ExtractFeatures(Lanes, Board, moves->MoveLandedY[move], lines, 0);
+            for (int input = 0; input < NeuralInputs; input++)
+                SampleInput[ (SampleCount * NeuralInputs) + input ] = Lanes->Input[input][0];
+
+            SampleTarget[SampleCount] = 0.0f;
+            SampleCount++;
+        }
+    }
+
+    /* Discounted cost of everything after each playfield, worked back from the end of the game */
+    for (int sample = (SampleCount-1); sample >= firstSample; sample--)
+    {
+        target = ( SampleTarget[sample] + (TrainerDiscount * target) );
+        SampleTarget[sample] = target;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Trainer::PlayGeneration(int evaluator, bool explore, bool record)
+{
+    logic->AISearch[0]->Evaluator = evaluator;
+    logic->AISearch[0]->Network = logic->AINeural;
+
+    SampleCount = 0;
+    GamesLost = 0;
+    PiecesPlayed = 0;
+    LinesCleared = 0;
+
+    for (int game = 0; game < TrainerGamesPerGeneration; game++)  PlayGame(explore, record);
+}
+
+//-------------------------------------------------------------------------------------------------
+float Trainer::FitNetwork(void)
+{
+Neural *network = logic->AINeural;
+int *order = new int[SampleCount];
+double error = 0.0;
+
+    for (int sample = 0; sample < SampleCount; sample++)  order[sample] = sample;
+
+    for (int pass = 0; pass < TrainerPasses; pass++)
+    {
+        for (int sample = (SampleCount-1); sample > 0; sample--)
+        {
+            int swap = ( Random() % (sample+1) );
+            int temp = order[sample];
+            order[sample] = order[swap];
+            order[swap] = temp;
+        }
+
+        error = 0.0;
+        for (int index = 0; index < SampleCount; index++)
+        {
+            int sample = order[index];
+
+            for (int input = 0; input < NeuralInputs; input++)
+                Lanes->Input[input][0] = SampleInput[ (sample * NeuralInputs) + input ];
+
+            network->Evaluate(Lanes, 1);
+            error += network->TrainLane(Lanes, 0, SampleTarget[sample], TrainerLearningRate);
+        }
+    }
+
+    delete [] order;
+
+    return( SampleCount > 0 ? (float)(error / SampleCount) : 0.0f );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Trainer::Run(int generations, const char *filename)
+{
+Neural *network = logic->AINeural;
+Neural *best = new Neural();
+Uint32 bestLines = 0;
+Uint32 trainingSeed;
+Uint32 giftPieces;
+Uint32 giftLines;
+Uint32 giftLost;
+
+    printf("Neural evaluator training: %i generations of %i self-play games, at most %i pieces each\n", generations
+           , TrainerGamesPerGeneration, TrainerMaxPieces);
+
+    logic->InitializePieceData();
+    logic->ClearPlayfieldsWithCollisionDetection();
+    EmptyBoard->LoadPlayfield(logic->PlayerData[0].Playfield);
+    Board->LoadPieceData(logic->PieceData);
+    Board->Kernel = Board->BestKernel();
+
+    network->RandomizeWeights(Seed);
+    network->Loaded = false;
+    *best = *network;
+
+    /* The first half learns what the hand written evaluator's playfields are worth, the second half plays itself */
+    for (int generation = 0; generation < generations; generation++)
+    {
+        PlayGeneration( (generation < (generations / 2) ? SearchGiftOfSight : SearchNeural), true, true );
+
+        float error = FitNetwork();
+
+        printf("  Generation %3i: %5u pieces %5u lines %2u of %i games lost, mean squared error %.3f", generation
+               , PiecesPlayed, LinesCleared, GamesLost, TrainerGamesPerGeneration, error);
+
+        /* Gradient steps are noisy, so the weights that play best on a fixed set of games are the ones kept */
+        trainingSeed = Seed;
+        Seed = TrainerValidationSeed;
+        PlayGeneration(SearchNeural, false, false);
+        Seed = trainingSeed;
+
+        printf(", plays %5u lines\n", LinesCleared);
+
+        if (LinesCleared > bestLines)
+        {
+            bestLines = LinesCleared;
+            *best = *network;
+        }
+    }
+
+    *network = *best;
+    delete best;
+
+    /* Both evaluators play the same fresh pieces without exploring */
+    Seed = TrainerEvaluationSeed;
+    PlayGeneration(SearchGiftOfSight, false, false);
+    giftPieces = PiecesPlayed;
+    giftLines = LinesCleared;
+    giftLost = GamesLost;
+
+    Seed = TrainerEvaluationSeed;
+    PlayGeneration(SearchNeural, false, false);
+
+    printf("  Gift Of Sight: %5u pieces %5u lines %2u games lost\n", giftPieces, giftLines, giftLost);
+    printf("  Neural:        %5u pieces %5u lines %2u games lost\n", PiecesPlayed, LinesCleared, GamesLost);
+
+    logic->AISearch[0]->Evaluator = SearchGiftOfSight;
+
+    if (network->SaveWeights(filename) == false)
+    {
+        printf("*****ERROR: could not write %s*****\n", filename);
+        return(false);
+    }
+
+    network->Loaded = true;
+    printf("  Weights written to %s\n", filename);
+
+    return(true);
+}
@@ -0,0 +1,72 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef TRAINER
+#define TRAINER
+
+class Bitboard;
+struct NeuralLanes;
+
+/* Offline self-play trainer for the neural A.I. evaluator: "tc4-tribute3 --train [generations] [file]" */
+class Trainer
+{
+public:
+
+    #define TrainerGamesPerGeneration   32
+    #define TrainerMaxPieces            500     /* A self-play game is stopped here */
+    #define TrainerGarbageInterval      10      /* Pieces between garbage lines, so that games can be lost */
+    #define TrainerExploreOneIn         64      /* Every so often a random placement, to see more positions */
+    #define TrainerDiscount             0.95f
+    #define TrainerGameOverCost         20.0f
+    #define TrainerPasses               8
+    #define TrainerLearningRate         0.0005f
+    #define TrainerValidationSeed       0x7A11D
+    #define TrainerEvaluationSeed       0x5EED
+
+    Uint32 Seed;
+    Uint8 Bag[7];
+    int BagIndex;
+
+    Bitboard *Board;
+    Bitboard *EmptyBoard;
+    NeuralLanes *Lanes;
+
+    float *SampleInput;
+    float *SampleTarget;
+    int SampleCount;
+
+    Uint32 GamesLost;
+    Uint32 PiecesPlayed;
+    Uint32 LinesCleared;
+
+	Trainer(void);
+	virtual ~Trainer(void);
+
+    Uint32 Random(void);
+    Uint8 DrawPiece(void);
+    bool AddGarbageLine(void);
+    void PlayGame(bool explore, bool record);
+    void PlayGeneration(int evaluator, bool explore, bool record);
+    float FitNetwork(void);
+
+    bool Run(int generations, const char *filename);
+};
+
+#endif
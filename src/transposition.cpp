@@ -0,0 +1,106 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <cstring>
+
+#include "SDL.h"
+
+#include "transposition.h"
+
+#define TranspositionValid      0x8000000000000000ULL
+
+//-------------------------------------------------------------------------------------------------
+Transposition::Transposition(void)
+{
+    Table = new TranspositionEntry[TranspositionEntries];
+
+    Clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+Transposition::~Transposition(void)
+{
+    delete [] Table;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Transposition::Clear(void)
+{
+    for (int index = 0; index < TranspositionEntries; index++)
+    {
+        Table[index].Check.store(0, std::memory_order_relaxed);
+        Table[index].Data.store(0, std::memory_order_relaxed);
+    }
+
+    Probes.store(0, std::memory_order_relaxed);
+    Hits.store(0, std::memory_order_relaxed);
+    Stores.store(0, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Transposition::Probe(Uint64 key, int *bestMoveX, int *bestRotation, int *bestValue)
+{
+TranspositionEntry *entry = &Table[ key & (TranspositionEntries-1) ];
+
+    Probes.fetch_add(1, std::memory_order_relaxed);
+
+    Uint64 data = entry->Data.load(std::memory_order_relaxed);
+    Uint64 check = entry->Check.load(std::memory_order_relaxed);
+
+    if ( (data & TranspositionValid) == 0 || (check ^ data) != key )  return(false);
+
+    *bestMoveX = (Sint8)(data & 0xFF);
+    *bestRotation = (Sint8)( (data >> 8) & 0xFF );
+    *bestValue = (Sint32)( (data >> 16) & 0xFFFFFFFF );
+
+    Hits.fetch_add(1, std::memory_order_relaxed);
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Transposition::Store(Uint64 key, int bestMoveX, int bestRotation, int bestValue)
+{
+TranspositionEntry *entry = &Table[ key & (TranspositionEntries-1) ];
+Uint64 data;
+
+    data = TranspositionValid | ( (Uint64)(Uint32)bestValue << 16 ) | ( (Uint64)(Uint8)bestRotation << 8 ) | (Uint64)(Uint8)bestMoveX;
+
+    entry->Data.store(data, std::memory_order_relaxed);
+    entry->Check.store(key ^ data, std::memory_order_relaxed);
+
+    Stores.fetch_add(1, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------
+float Transposition::HitRate(void)
+{
+Uint64 probes = Probes.load(std::memory_order_relaxed);
+
+    if (probes == 0)  return(0.0f);
+
+    return( 100.0f * (float)Hits.load(std::memory_order_relaxed) / (float)probes );
+}
+
+//-------------------------------------------------------------------------------------------------
+Uint32 Transposition::MemoryUsed(void)
+{
+    return( (Uint32)(sizeof(TranspositionEntry) * TranspositionEntries) );
+}
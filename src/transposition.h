@@ -0,0 +1,55 @@
+/*
+    Copyright 2025 Team 16BitSoft
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+    AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+    WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef TRANSPOSITION
+#define TRANSPOSITION
+
+#include <atomic>
+
+/* Fixed-size, lock-free cache of A.I. decisions keyed by (playfield hash, piece, piece row) */
+class Transposition
+{
+public:
+
+    #define TranspositionEntries        (1 << 17)
+
+    struct TranspositionEntry
+    {
+        std::atomic<Uint64> Check;  /* Key ^ Data, so a torn write never looks like a hit */
+        std::atomic<Uint64> Data;
+    } *Table;
+
+    std::atomic<Uint64> Probes;
+    std::atomic<Uint64> Hits;
+    std::atomic<Uint64> Stores;
+
+	Transposition(void);
+	virtual ~Transposition(void);
+
+    void Clear(void);
+
+    bool Probe(Uint64 key, int *bestMoveX, int *bestRotation, int *bestValue);
+    void Store(Uint64 key, int bestMoveX, int bestRotation, int bestValue);
+
+    float HitRate(void);
+    Uint32 MemoryUsed(void);
+};
+
+#endif
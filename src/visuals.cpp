@@ -29,14 +29,72 @@
 #include "visuals.h"
 
 #include "screens.h"
+#include "assetpack.h"
 
 extern Screens* screens;
+extern AssetPack* assetPack;
 
 //-------------------------------------------------------------------------------------------------
 Visuals::Visuals(void)
 {
     CoreFailure = false;
 
+    Window = NULL;
+    Renderer = NULL;
+
+    for (int index = 0; index < NumberOfFonts; index++)  Font[index] = NULL;
+    for (int index = 0; index < NumberOfSprites; index++)
+    {
+        Sprites[index].Texture = NULL;
+        Sprites[index].References = 0;
+        Sprites[index].ReleasedTicks = 0;
+    }
+
+    TextureBudgetKB = DefaultTextureBudgetKB;
+    OnDemandTextureKB = 0;
+    OnDemandTexturePeakKB = 0;
+
+    ImagesCached = 0;
+    for (int index = 0; index < NumberOfImagesCached; index++)  ImageCachedSurface[index] = NULL;
+    SDL_AtomicSet(&ImageDecodedKB, 0);
+    SDL_AtomicSet(&ImageDecodeStopping, 0);
+    ImageDecodeThreads = 0;
+    ImageDecodeJobs = 0;
+    SpritesLoading = false;
+    SpritesNextToLoad = 0;
+    LaunchTicks = SDL_GetPerformanceCounter();
+    LoadingTicks = LaunchTicks;
+    FirstFramePresented = false;
+
+    BoxAtlas = NULL;
+    BatchedSprites = 0;
+    StaticLayer = NULL;
+    StaticLayerKey = 0;
+    StaticLayerWidth = 0;
+    StaticLayerHeight = 0;
+    StaticLayerDrawing = false;
+    StaticLayerFailed = false;
+    for (int board = 0; board < MaxBoards; board++)
+    {
+        BoardTexture[board] = NULL;
+        BoardDirtyCells[board] = 0;
+    }
+    BoardTexturesFailed = false;
+    for (int font = 0; font < NumberOfFonts; font++)
+    {
+        GlyphAtlas[font] = NULL;
+        GlyphAtlasTried[font] = false;
+    }
+    for (int sprite = 0; sprite < MaxBatchedSprites; sprite++)
+    {
+        BatchIndices[(sprite * 6) + 0] = (sprite * 4) + 0;
+        BatchIndices[(sprite * 6) + 1] = (sprite * 4) + 1;
+        BatchIndices[(sprite * 6) + 2] = (sprite * 4) + 2;
+        BatchIndices[(sprite * 6) + 3] = (sprite * 4) + 2;
+        BatchIndices[(sprite * 6) + 4] = (sprite * 4) + 1;
+        BatchIndices[(sprite * 6) + 5] = (sprite * 4) + 3;
+    }
+
     ForceAspectRatio = true;
 
     FullScreenMode = 0;
@@ -58,12 +116,12 @@ Visuals::Visuals(void)
 
     TotalNumberOfLoadedStaffTexts = 0;
 
-    TextCacheCurrentIndex = 0;
+    TextCacheHits = 0;
+    TextCacheMisses = 0;
 
 	for (int index = 0; index < NumberOfTextsCached; index++)
 	{
 		TextTexture[index] = NULL;
-		TextOutlineTexture[index] = NULL;
 	}
     ClearTextCache();
 
@@ -78,6 +136,8 @@ Visuals::Visuals(void)
 Visuals::~Visuals(void)
 {
     ClearTextCache();
+    ClearGlyphAtlases();
+    ClearImageCache();
 
     UnloadFontsFromMemory();
 
@@ -90,7 +150,10 @@ Visuals::~Visuals(void)
             SDL_DestroyTexture(Sprites[index].Texture);
         }
     }
-    printf("Unloaded all sprite images from memory.\n");
+    if (BoxAtlas != NULL)  SDL_DestroyTexture(BoxAtlas);
+    if (StaticLayer != NULL)  SDL_DestroyTexture(StaticLayer);
+    InvalidateBoards();
+    printf("Unloaded all sprite images from memory, on demand textures peaked at %u KB of a %u KB budget.\n", OnDemandTexturePeakKB, TextureBudgetKB);
 
     SDL_DestroyRenderer(Renderer);
     printf("SDL2 renderer destroyed.\n");
@@ -182,351 +245,1302 @@ void Visuals::ClearScreenBufferWithColor(Uint8 red, Uint8 green, Uint8 blue, Uin
 }
 
 //-------------------------------------------------------------------------------------------------
-bool Visuals::LoadSpritesAndInitialize(void)
+void Visuals::QueueImage(const char *filePath)
 {
-char filePath[256];
-SDL_Surface *tempSurface = NULL;
-Uint32 textureFormat;
-int textureAccess;
-int textureWidth;
-int textureHeight;
+    for (int index = 0; index < ImagesCached; index++)
+    {
+        if (strcmp(ImageCachedPath[index], filePath) == 0)
+        {
+            ImageCachedUses[index]++;
+            return;
+        }
+    }
 
-    for (int index = 0; index < NumberOfSprites; index++)
+    if (ImagesCached == NumberOfImagesCached)
     {
-        Sprites[index].Texture = NULL;
+        printf("*****ERROR: Image cache full, raise NumberOfImagesCached*****\n");
+        return;
     }
 
-    for (int index = 0; index < NumberOfSprites; index++)
+    SDL_strlcpy(ImageCachedPath[ImagesCached], filePath, sizeof ImageCachedPath[ImagesCached]);
+    ImageCachedSurface[ImagesCached] = NULL;
+    ImageCachedUses[ImagesCached] = 1;
+    SDL_AtomicSet(&ImageDecodeState[ImagesCached], ImageQueued);
+    ImagesCached++;
+}
+
+//-------------------------------------------------------------------------------------------------
+int Visuals::ImageDecodeWorker(void *data)
+{
+Visuals *visuals = (Visuals*)data;
+int job;
+int decodedKB;
+
+    while ( (job = SDL_AtomicAdd(&visuals->ImageDecodeNext, 1)) < visuals->ImageDecodeJobs )
     {
-        SDL_strlcpy(filePath, "~", sizeof filePath);
+        /* Room is reserved before the image is claimed, so the render thread can still decode it itself instead of waiting here too */
+        while (true)
+        {
+            decodedKB = SDL_AtomicGet(&visuals->ImageDecodedKB);
+            if (decodedKB > ImageDecodeAheadKB && SDL_AtomicGet(&visuals->ImageDecodeStopping) == 0)
+            {
+                SDL_Delay(1);
+                continue;
+            }
+
+            if (SDL_AtomicCAS(&visuals->ImageDecodedKB, decodedKB, decodedKB + ImageDecodeReserveKB) == SDL_TRUE)  break;
+        }
 
-        switch(index)
+        /* The render thread may have needed this image first and decoded it itself */
+        if (SDL_AtomicCAS(&visuals->ImageDecodeState[job], ImageQueued, ImageDecoding) == SDL_FALSE)
         {
-            case 0:
-                SDL_strlcpy(filePath, "data/visuals/Screen-Fade-Black-Box.png", sizeof filePath);
-                break;
+            SDL_AtomicAdd(&visuals->ImageDecodedKB, -ImageDecodeReserveKB);
+            continue;
+        }
 
-            case 1:
-                SDL_strlcpy(filePath, "data/visuals/16BitSoft-Logo.png", sizeof filePath);
-                break;
+        visuals->ImageCachedSurface[job] = IMG_Load(visuals->ImageCachedPath[job]);
+        if (!visuals->ImageCachedSurface[job])  printf( "Image decoding failed: %s %s\n", visuals->ImageCachedPath[job], IMG_GetError() );
 
-            case 2:
-                SDL_strlcpy(filePath, "data/visuals/BG-SaintBasilsCathedral.png", sizeof filePath);
-                break;
+        decodedKB = ( visuals->ImageCachedSurface[job] != NULL ? (visuals->ImageCachedSurface[job]->h * visuals->ImageCachedSurface[job]->pitch) / 1024 : 0 );
+        SDL_AtomicAdd(&visuals->ImageDecodedKB, decodedKB - ImageDecodeReserveKB);
 
-            case 3:
-                SDL_strlcpy(filePath, "data/visuals/T-C-4-Logo.png", sizeof filePath);
-                break;
+        SDL_AtomicSet(&visuals->ImageDecodeState[job], ImageDecoded);
+    }
 
-            case 4:
-                SDL_strlcpy(filePath, "data/visuals/Keyboard-Controls.png", sizeof filePath);
-                break;
+    return(0);
+}
 
-            case 5:
-                SDL_strlcpy(filePath, "data/visuals/MIT-Warning.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+void Visuals::StartImageDecoding(void)
+{
+    StopImageDecoding();
 
-            case 6:
-                SDL_strlcpy(filePath, "data/visuals/JLPPortfolio.png", sizeof filePath);
-                break;
+    /* Loads the PNG decoder once here, so the worker threads never race to do it */
+    IMG_Init(IMG_INIT_PNG);
 
-            case 7:
-                SDL_strlcpy(filePath, "data/visuals/Line.png", sizeof filePath);
-                break;
+    ImageDecodeJobs = ImagesCached;
+    SDL_AtomicSet(&ImageDecodeNext, 0);
 
-            case 9:
-                SDL_strlcpy(filePath, "data/visuals/SDL-Logo.png", sizeof filePath);
-                break;
+    ImageDecodeThreads = SDL_GetCPUCount();
+    if (ImageDecodeThreads < 1)  ImageDecodeThreads = 1;
+    if (ImageDecodeThreads > MaxImageDecodeThreads)  ImageDecodeThreads = MaxImageDecodeThreads;
+    if (ImageDecodeThreads > ImageDecodeJobs)  ImageDecodeThreads = ImageDecodeJobs;
 
-            case 11:
-                SDL_strlcpy(filePath, "data/visuals/1of1.png", sizeof filePath);
-                break;
+    for (int thread = 0; thread < ImageDecodeThreads; thread++)
+    {
+        ImageDecodeThread[thread] = SDL_CreateThread(ImageDecodeWorker, "ImageDecode", this);
+        if (ImageDecodeThread[thread] == NULL)
+        {
+            ImageDecodeThreads = thread;
+            break;
+        }
+    }
+}
 
-            case 13:
-                SDL_strlcpy(filePath, "data/visuals/TC1Palm-Title.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+void Visuals::StopImageDecoding(void)
+{
+    /* Whatever is left queued gets decoded by LoadImage() on the render thread */
+    SDL_AtomicSet(&ImageDecodeNext, ImageDecodeJobs);
+    SDL_AtomicSet(&ImageDecodeStopping, 1);
 
-            case 14:
-                SDL_strlcpy(filePath, "data/visuals/TC1Palm-InGame.png", sizeof filePath);
-                break;
+    for (int thread = 0; thread < ImageDecodeThreads; thread++)  SDL_WaitThread(ImageDecodeThread[thread], NULL);
 
-            case 15:
-                SDL_strlcpy(filePath, "data/visuals/Review.png", sizeof filePath);
-                break;
+    ImageDecodeThreads = 0;
+    SDL_AtomicSet(&ImageDecodeStopping, 0);
+}
 
-            case 17:
-                SDL_strlcpy(filePath, "data/visuals/T-Crisis_PromoCover.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+bool Visuals::ImageDecodedYet(const char *filePath)
+{
+    for (int index = 0; index < ImagesCached; index++)
+    {
+        /* A released image is decoded again by LoadImage() itself */
+        if (strcmp(ImageCachedPath[index], filePath) == 0)  return( SDL_AtomicGet(&ImageDecodeState[index]) >= ImageDecoded );
+    }
 
-            case 19:
-                SDL_strlcpy(filePath, "data/visuals/EscKey.png", sizeof filePath);
-                break;
+    return(false);
+}
 
-            case 31:
-                SDL_strlcpy(filePath, "data/visuals/Playfield.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+SDL_Surface* Visuals::LoadImage(const char *filePath)
+{
+SDL_Surface *surface = NULL;
 
-            case 32:
-                SDL_strlcpy(filePath, "data/visuals/Playfield-Block-Attack.png", sizeof filePath);
-                break;
+    for (int index = 0; index < ImagesCached; index++)
+    {
+        if (strcmp(ImageCachedPath[index], filePath) == 0)
+        {
+            if ( SDL_AtomicCAS(&ImageDecodeState[index], ImageQueued, ImageDecoding) == SDL_TRUE
+              || SDL_AtomicCAS(&ImageDecodeState[index], ImageReleased, ImageDecoding) == SDL_TRUE )
+            {
+                ImageCachedSurface[index] = IMG_Load(filePath);
+                if (ImageCachedSurface[index] != NULL)  SDL_AtomicAdd( &ImageDecodedKB, (ImageCachedSurface[index]->h * ImageCachedSurface[index]->pitch) / 1024 );
+                SDL_AtomicSet(&ImageDecodeState[index], ImageDecoded);
+            }
+            else
+            {
+                while (SDL_AtomicGet(&ImageDecodeState[index]) != ImageDecoded)  SDL_Delay(1);
+            }
 
-            case 39:
-                SDL_strlcpy(filePath, "data/story/BG-Space.png", sizeof filePath);
-                break;
+            return(ImageCachedSurface[index]);
+        }
+    }
 
-            case 40:
-                SDL_strlcpy(filePath, "data/story/Mars.png", sizeof filePath);
-                break;
+    if (ImagesCached == NumberOfImagesCached)
+    {
+        printf("*****ERROR: Image cache full, raise NumberOfImagesCached*****\n");
+        return(NULL);
+    }
 
-            case 41:
-                SDL_strlcpy(filePath, "data/story/ShipAway.png", sizeof filePath);
-                break;
+    surface = IMG_Load(filePath);
+    if (!surface)  return(NULL);
+    SDL_AtomicAdd( &ImageDecodedKB, (surface->h * surface->pitch) / 1024 );
 
-            case 42:
-                SDL_strlcpy(filePath, "data/story/Earth.png", sizeof filePath);
-                break;
+    /* Not queued, so nothing else waits for it and the caller's ReleaseImage() frees it */
+    SDL_strlcpy(ImageCachedPath[ImagesCached], filePath, sizeof ImageCachedPath[ImagesCached]);
+    ImageCachedSurface[ImagesCached] = surface;
+    ImageCachedUses[ImagesCached] = 0;
+    SDL_AtomicSet(&ImageDecodeState[ImagesCached], ImageDecoded);
+    ImagesCached++;
 
-            case 43:
-                SDL_strlcpy(filePath, "data/story/ShipComing.png", sizeof filePath);
-                break;
+    return(surface);
+}
 
-            case 44:
-                SDL_strlcpy(filePath, "data/story/Explosion.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+SDL_Surface* Visuals::LoadImageCopy(const char *filePath)
+{
+SDL_Surface *surface = LoadImage(filePath);
 
-            case 70:
-                SDL_strlcpy(filePath, "data/story/Story1.png", sizeof filePath);
-                break;
+    /* For images that get drawn onto, the caller frees the copy */
+    if (!surface)  return(NULL);
 
-            case 71:
-                SDL_strlcpy(filePath, "data/story/Story2.png", sizeof filePath);
-                break;
+    return( SDL_DuplicateSurface(surface) );
+}
 
-            case 72:
-                SDL_strlcpy(filePath, "data/story/Story3.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+void Visuals::ReleaseImage(const char *filePath)
+{
+    for (int index = 0; index < ImagesCached; index++)
+    {
+        if (strcmp(ImageCachedPath[index], filePath) != 0)  continue;
 
-            case 73:
-                SDL_strlcpy(filePath, "data/story/Story4.png", sizeof filePath);
-                break;
+        if (ImageCachedUses[index] > 0)  ImageCachedUses[index]--;
 
-            case 75:
-                SDL_strlcpy(filePath, "data/story/End1.png", sizeof filePath);
-                break;
+        if (ImageCachedUses[index] == 0 && SDL_AtomicGet(&ImageDecodeState[index]) == ImageDecoded)
+        {
+            if (ImageCachedSurface[index] != NULL)
+            {
+                SDL_AtomicAdd( &ImageDecodedKB, -( (ImageCachedSurface[index]->h * ImageCachedSurface[index]->pitch) / 1024 ) );
+                SDL_FreeSurface(ImageCachedSurface[index]);
+            }
+            ImageCachedSurface[index] = NULL;
+            SDL_AtomicSet(&ImageDecodeState[index], ImageReleased);
+        }
 
-            case 100:
-                SDL_strlcpy(filePath, "data/visuals/BG-SaintBasilsCathedral.png", sizeof filePath);
-                break;
+        return;
+    }
+}
 
-            case 101:
-                SDL_strlcpy(filePath, "data/visuals/BG-MIG31.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+void Visuals::ClearImageCache(void)
+{
+    StopImageDecoding();
 
-            case 102:
-                SDL_strlcpy(filePath, "data/visuals/BG-GT-R.png", sizeof filePath);
-                break;
+    for (int index = 0; index < ImagesCached; index++)
+    {
+        if (ImageCachedSurface[index] != NULL)
+        {
+            SDL_FreeSurface(ImageCachedSurface[index]);
+            ImageCachedSurface[index] = NULL;
+        }
+    }
 
-            case 103:
-                SDL_strlcpy(filePath, "data/visuals/BG-NY.png", sizeof filePath);
-                break;
+    ImagesCached = 0;
+    SDL_AtomicSet(&ImageDecodedKB, 0);
+}
 
-            case 104:
-                SDL_strlcpy(filePath, "data/visuals/BG-Van-Gogh.png", sizeof filePath);
-                break;
+//-------------------------------------------------------------------------------------------------
+void Visuals::GetSpriteFilePath(int index, char *filePath, size_t filePathSize)
+{
+    SDL_strlcpy(filePath, "~", filePathSize);
 
-            case 105:
-                SDL_strlcpy(filePath, "data/visuals/BG-Kittens.png", sizeof filePath);
-                break;
+    switch(index)
+    {
+        case 0:
+            SDL_strlcpy(filePath, "data/visuals/Screen-Fade-Black-Box.png", filePathSize);
+            break;
 
-            case 106:
-                SDL_strlcpy(filePath, "data/visuals/BG-Psycho.png", sizeof filePath);
-                break;
+        case 1:
+            SDL_strlcpy(filePath, "data/visuals/16BitSoft-Logo.png", filePathSize);
+            break;
 
-            case 108:
-                SDL_strlcpy(filePath, "data/visuals/BG-Story.png", sizeof filePath);
-                break;
+        case 2:
+            SDL_strlcpy(filePath, "data/visuals/BG-SaintBasilsCathedral.png", filePathSize);
+            break;
 
-            case 155:
-                SDL_strlcpy(filePath, "data/visuals/Crack.png", sizeof filePath);
-                break;
+        case 3:
+            SDL_strlcpy(filePath, "data/visuals/T-C-4-Logo.png", filePathSize);
+            break;
 
-            default:
-                break;
-        }
+        case 4:
+            SDL_strlcpy(filePath, "data/visuals/Keyboard-Controls.png", filePathSize);
+            break;
 
-        if (filePath[0] != '~')
-        {
-            tempSurface = IMG_Load(filePath);
+        case 5:
+            SDL_strlcpy(filePath, "data/visuals/MIT-Warning.png", filePathSize);
+            break;
 
-            if (!tempSurface)
-            {
-                printf( "Image loading failed: %s\n", IMG_GetError() );
-                CoreFailure = true;
-                return(false);
-            }
-        }
+        case 6:
+            SDL_strlcpy(filePath, "data/visuals/JLPPortfolio.png", filePathSize);
+            break;
 
-        if (filePath[0] != '~')
-        {
-            Sprites[index].Texture = SDL_CreateTextureFromSurface(Renderer, tempSurface);
+        case 7:
+            SDL_strlcpy(filePath, "data/visuals/Line.png", filePathSize);
+            break;
 
-            Sprites[index].ScreenX = 320;
-            Sprites[index].ScreenY = 240;
-            Sprites[index].ScaleX = 1.0;
-            Sprites[index].ScaleY = 1.0;
-            Sprites[index].RotationDegree = 0;
-            Sprites[index].RedHue = 255;
-            Sprites[index].GreenHue = 255;
-            Sprites[index].BlueHue = 255;
-            Sprites[index].Transparency = 255;
-            Sprites[index].Smooth = false;
-            Sprites[index].FlipX = false;
-            Sprites[index].FlipY = false;
+        case 9:
+            SDL_strlcpy(filePath, "data/visuals/SDL-Logo.png", filePathSize);
+            break;
 
-            Sprites[index].AnimationTimer = 0;
+        case 11:
+            SDL_strlcpy(filePath, "data/visuals/1of1.png", filePathSize);
+            break;
 
-            SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
-            Sprites[index].TextureWidthOriginal = textureWidth;
-            Sprites[index].TextureHeightOriginal = textureHeight;
+        case 13:
+            SDL_strlcpy(filePath, "data/visuals/TC1Palm-Title.png", filePathSize);
+            break;
 
-            SDL_FreeSurface(tempSurface);
-        }
-    }
+        case 14:
+            SDL_strlcpy(filePath, "data/visuals/TC1Palm-InGame.png", filePathSize);
+            break;
 
-    if ( LoadBoxSpriteSheetIntoMemory() == false)
-    {
-        CoreFailure = true;
-        return(false);
+        case 15:
+            SDL_strlcpy(filePath, "data/visuals/Review.png", filePathSize);
+            break;
+
+        case 17:
+            SDL_strlcpy(filePath, "data/visuals/T-Crisis_PromoCover.png", filePathSize);
+            break;
+
+        case 19:
+            SDL_strlcpy(filePath, "data/visuals/EscKey.png", filePathSize);
+            break;
+
+        case 31:
+            SDL_strlcpy(filePath, "data/visuals/Playfield.png", filePathSize);
+            break;
+
+        case 32:
+            SDL_strlcpy(filePath, "data/visuals/Playfield-Block-Attack.png", filePathSize);
+            break;
+
+        case 39:
+            SDL_strlcpy(filePath, "data/story/BG-Space.png", filePathSize);
+            break;
+
+        case 40:
+            SDL_strlcpy(filePath, "data/story/Mars.png", filePathSize);
+            break;
+
+        case 41:
+            SDL_strlcpy(filePath, "data/story/ShipAway.png", filePathSize);
+            break;
+
+        case 42:
+            SDL_strlcpy(filePath, "data/story/Earth.png", filePathSize);
+            break;
+
+        case 43:
+            SDL_strlcpy(filePath, "data/story/ShipComing.png", filePathSize);
+            break;
+
+        case 44:
+            SDL_strlcpy(filePath, "data/story/Explosion.png", filePathSize);
+            break;
+
+        case 70:
+            SDL_strlcpy(filePath, "data/story/Story1.png", filePathSize);
+            break;
+
+        case 71:
+            SDL_strlcpy(filePath, "data/story/Story2.png", filePathSize);
+            break;
+
+        case 72:
+            SDL_strlcpy(filePath, "data/story/Story3.png", filePathSize);
+            break;
+
+        case 73:
+            SDL_strlcpy(filePath, "data/story/Story4.png", filePathSize);
+            break;
+
+        case 75:
+            SDL_strlcpy(filePath, "data/story/End1.png", filePathSize);
+            break;
+
+        case 100:
+            SDL_strlcpy(filePath, "data/visuals/BG-SaintBasilsCathedral.png", filePathSize);
+            break;
+
+        case 101:
+            SDL_strlcpy(filePath, "data/visuals/BG-MIG31.png", filePathSize);
+            break;
+
+        case 102:
+            SDL_strlcpy(filePath, "data/visuals/BG-GT-R.png", filePathSize);
+            break;
+
+        case 103:
+            SDL_strlcpy(filePath, "data/visuals/BG-NY.png", filePathSize);
+            break;
+
+        case 104:
+            SDL_strlcpy(filePath, "data/visuals/BG-Van-Gogh.png", filePathSize);
+            break;
+
+        case 105:
+            SDL_strlcpy(filePath, "data/visuals/BG-Kittens.png", filePathSize);
+            break;
+
+        case 106:
+            SDL_strlcpy(filePath, "data/visuals/BG-Psycho.png", filePathSize);
+            break;
+
+        case 108:
+            SDL_strlcpy(filePath, "data/visuals/BG-Story.png", filePathSize);
+            break;
+
+        case 155:
+            SDL_strlcpy(filePath, "data/visuals/Crack.png", filePathSize);
+            break;
+
+        default:
+            break;
     }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::LoadSprite(int index)
+{
+char filePath[256];
+SDL_Surface *tempSurface = NULL;
+Uint32 textureFormat;
+int textureAccess;
+int textureWidth;
+int textureHeight;
+
+    GetSpriteFilePath(index, filePath, sizeof filePath);
+    if (filePath[0] == '~')  return(true);
 
-    if ( LoadInterfaceIntoMemory() == false)
+    if (LoadSpriteFromPack(index) == true)
     {
-        CoreFailure = true;
-        return(false);
+        if (SpriteLoadsOnDemand(index) == true)  OnDemandTextureKB += ( (Sprites[index].TextureWidthOriginal * Sprites[index].TextureHeightOriginal * 4) / 1024 );
+        if (OnDemandTextureKB > OnDemandTexturePeakKB)  OnDemandTexturePeakKB = OnDemandTextureKB;
+        return(true);
     }
 
-    if ( PreloadStaffTextsIntoMemory() == false)
+    tempSurface = LoadImage(filePath);
+
+    if (!tempSurface)
     {
-        CoreFailure = true;
+        printf( "Image loading failed: %s\n", IMG_GetError() );
         return(false);
     }
 
-    printf("Loaded all sprite images into memory.\n");
+    Sprites[index].Texture = CreateSpriteTexture(index, tempSurface);
+    ReleaseImage(filePath);
+
+    Sprites[index].ScreenX = 320;
+    Sprites[index].ScreenY = 240;
+    Sprites[index].ScaleX = 1.0;
+    Sprites[index].ScaleY = 1.0;
+    Sprites[index].RotationDegree = 0;
+    Sprites[index].RedHue = 255;
+    Sprites[index].GreenHue = 255;
+    Sprites[index].BlueHue = 255;
+    Sprites[index].Transparency = 255;
+    Sprites[index].Smooth = false;
+    Sprites[index].FlipX = false;
+    Sprites[index].FlipY = false;
+
+    Sprites[index].AnimationTimer = 0;
+
+    SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
+    Sprites[index].TextureWidthOriginal = textureWidth;
+    Sprites[index].TextureHeightOriginal = textureHeight;
+
+    if (SpriteLoadsOnDemand(index) == true)  OnDemandTextureKB += ( (textureWidth * textureHeight * 4) / 1024 );
+    if (OnDemandTextureKB > OnDemandTexturePeakKB)  OnDemandTexturePeakKB = OnDemandTextureKB;
+
     return(true);
 }
 
 //-------------------------------------------------------------------------------------------------
-bool Visuals::LoadBoxSpriteSheetIntoMemory(void)
+bool Visuals::SpriteLoadsOnDemand(int index)
 {
-Uint32 textureFormat;
-int textureAccess;
-int textureWidth;
-int textureHeight;
+    if (index == 3 || index == 4 || index == 6)  return(true);
+    if (index == 11 || index == 13 || index == 14 || index == 15 || index == 17)  return(true);
+    if (index > 38 && index < 45)  return(true);
+    if (index > 69 && index < 76)  return(true);
+    if (index > 99 && index < 109)  return(true);
 
-    SDL_Surface *spriteSheet = NULL;
-    SDL_Surface *boxTemp = NULL;
-    SDL_Rect dstRect;
-    SDL_Rect srcRect;
-    int x = 1;
-    for (int index = 200; index < 260; index++)
-    {
-        spriteSheet = IMG_Load("data/visuals/Boxes.png");
-        if (!spriteSheet)
-        {
-            printf( "Image loading failed: %s\n", IMG_GetError() );
-            CoreFailure = true;
-            return(false);
-        }
+    return(false);
+}
 
-        boxTemp = IMG_Load("data/visuals/Box.png");
-        if (!boxTemp)
-        {
-            printf( "Image loading failed: %s\n", IMG_GetError() );
-            CoreFailure = true;
-            return(false);
-        }
+//-------------------------------------------------------------------------------------------------
+SDL_Texture* Visuals::CreatePackedTexture(const char *name)
+{
+const AssetPack::AssetPackEntry *entry;
+SDL_Texture *texture;
 
-        dstRect.x = 0;
-        dstRect.y = 0;
-        dstRect.w = 13;
-        dstRect.h = 18;
+    if (assetPack == NULL)  return(NULL);
 
-        srcRect.w = 13;
-        srcRect.h = 18;
+    entry = assetPack->Find(name, AssetPackImage);
+    if (entry == NULL || entry->Size != entry->Width * entry->Height * 4)  return(NULL);
 
-        if (index > 199 && index < 210)
-        {
-            if (index == 200) x = 1;
+    /* Already decoded, the mapped pages go straight to the renderer */
+    texture = SDL_CreateTexture(Renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, (int)entry->Width, (int)entry->Height);
+    if (texture == NULL)  return(NULL);
 
-            srcRect.x = x;
-            srcRect.y = 1;
-        }
-        else if (index > 209 && index < 220)
-        {
-            if (index == 210) x = 1;
+    if (SDL_UpdateTexture(texture, NULL, assetPack->EntryData(entry), (int)entry->Width * 4) != 0)
+    {
+        SDL_DestroyTexture(texture);
+        return(NULL);
+    }
 
-            srcRect.x = x;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return(texture);
+}
+
+//-------------------------------------------------------------------------------------------------
+SDL_Texture* Visuals::CreateSpriteTexture(int index, SDL_Surface *surface)
+{
+char name[AssetPackNameLength];
+
+    /* "--pack" writes every sprite as the surface it is made from */
+    if (assetPack != NULL && assetPack->Writing == true)
+    {
+        SDL_snprintf(name, sizeof name, "sprite/%i", index);
+        assetPack->AddImage(name, surface);
+    }
+
+    return( SDL_CreateTextureFromSurface(Renderer, surface) );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::SpriteInPack(int index)
+{
+char name[AssetPackNameLength];
+
+    if (assetPack == NULL)  return(false);
+
+    SDL_snprintf(name, sizeof name, "sprite/%i", index);
+    return( assetPack->Find(name, AssetPackImage) != NULL );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::LoadSpriteFromPack(int index)
+{
+char name[AssetPackNameLength];
+Uint32 textureFormat;
+int textureAccess;
+int textureWidth;
+int textureHeight;
+
+    SDL_snprintf(name, sizeof name, "sprite/%i", index);
+    Sprites[index].Texture = CreatePackedTexture(name);
+    if (Sprites[index].Texture == NULL)  return(false);
+
+    Sprites[index].ScreenX = 320;
+    Sprites[index].ScreenY = 240;
+    Sprites[index].ScaleX = 1.0;
+    Sprites[index].ScaleY = 1.0;
+    Sprites[index].RotationDegree = 0;
+    Sprites[index].RedHue = 255;
+    Sprites[index].GreenHue = 255;
+    Sprites[index].BlueHue = 255;
+    Sprites[index].Transparency = 255;
+    Sprites[index].Smooth = false;
+    Sprites[index].FlipX = false;
+    Sprites[index].FlipY = false;
+
+    Sprites[index].AnimationTimer = 0;
+
+    SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
+    Sprites[index].TextureWidthOriginal = textureWidth;
+    Sprites[index].TextureHeightOriginal = textureHeight;
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::AcquireSprite(int index)
+{
+    Sprites[index].References++;
+
+    if (Sprites[index].Texture == NULL && SpriteLoadsOnDemand(index) == true && LoadSprite(index) == false)
+    {
+        CoreFailure = true;
+        return(false);
+    }
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::PrefetchSprite(int index)
+{
+char filePath[256];
+
+    /* Held like an acquired sprite, but decoded on the worker threads and uploaded by StreamSpritesIntoMemory() */
+    Sprites[index].References++;
+
+    if (Sprites[index].Texture != NULL || SpriteLoadsOnDemand(index) == false)  return;
+
+    GetSpriteFilePath(index, filePath, sizeof filePath);
+    if (filePath[0] != '~' && SpriteInPack(index) == false)  QueueImage(filePath);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::ReleaseSprite(int index)
+{
+    if (Sprites[index].References > 0)  Sprites[index].References--;
+    Sprites[index].ReleasedTicks = SDL_GetTicks();
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::UnloadSprite(int index)
+{
+    if (Sprites[index].Texture == NULL)  return;
+
+    SDL_DestroyTexture(Sprites[index].Texture);
+    Sprites[index].Texture = NULL;
+
+    OnDemandTextureKB -= ( (Sprites[index].TextureWidthOriginal * Sprites[index].TextureHeightOriginal * 4) / 1024 );
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::EvictSprites(void)
+{
+int oldest;
+
+    /* Unreferenced sprites stay loaded until the budget runs out, then the longest unused go first */
+    while (OnDemandTextureKB > TextureBudgetKB)
+    {
+        oldest = -1;
+        for (int index = 0; index < NumberOfSprites; index++)
+        {
+            if (Sprites[index].Texture == NULL || Sprites[index].References > 0 || SpriteLoadsOnDemand(index) == false)  continue;
+
+            if (oldest == -1 || Sprites[index].ReleasedTicks < Sprites[oldest].ReleasedTicks)  oldest = index;
+        }
+
+        if (oldest == -1)  break;
+
+        UnloadSprite(oldest);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::LoadSpritesAndInitialize(void)
+{
+char filePath[256];
+int firstSprites[5] = { 0, 5, 9, 1, 19 };  /* Fade, MIT warning, SDL logo, 16BitSoft logo and Esc key for the logo screens */
+
+    LoadingTicks = SDL_GetPerformanceCounter();
+
+    for (int index = 0; index < NumberOfSprites; index++)
+    {
+        Sprites[index].Texture = NULL;
+        Sprites[index].References = 0;
+    }
+
+    /* The logo screens' images go first in the queue, so they are decoded first */
+    for (int sprite = 0; sprite < 5; sprite++)
+    {
+        GetSpriteFilePath(firstSprites[sprite], filePath, sizeof filePath);
+        if (SpriteInPack(firstSprites[sprite]) == false)  QueueImage(filePath);
+    }
+
+    for (int index = 0; index < NumberOfSprites; index++)
+    {
+        /* Queued once per sprite, so each image is freed when the last sprite made from it is loaded */
+        bool queued = false;
+        for (int sprite = 0; sprite < 5; sprite++)
+        {
+            if (firstSprites[sprite] == index)  queued = true;
+        }
+
+        GetSpriteFilePath(index, filePath, sizeof filePath);
+        if (filePath[0] != '~' && SpriteLoadsOnDemand(index) == false && SpriteInPack(index) == false && queued == false)  QueueImage(filePath);
+    }
+
+    /* Images in the asset pack are already decoded, only the loose files need the worker threads */
+    if (SpriteInPack(200) == false)
+    {
+        QueueImage("data/visuals/Boxes.png");
+        QueueImage("data/visuals/Box.png");
+    }
+
+    for ( int index = 999; index < (1010+65+10); index++ )
+    {
+        GetInterfaceFilePath(index, filePath, sizeof filePath);
+        if (filePath[0] != '~' && SpriteInPack(index) == false)  QueueImage(filePath);
+    }
+
+    if (SpriteInPack(1100) == false)  QueueImage("data/visuals/Staff-Text-Image.png");
+
+    StartImageDecoding();
+
+    for (int sprite = 0; sprite < 5; sprite++)
+    {
+        if ( LoadSprite(firstSprites[sprite]) == false)
+        {
+            ClearImageCache();
+            CoreFailure = true;
+            return(false);
+        }
+    }
+
+    SpritesLoading = true;
+    SpritesNextToLoad = 0;
+
+    printf( "Loaded logo screen sprites into memory in %.0f ms, decoding the rest on %i thread%s.\n"
+           , (double)(SDL_GetPerformanceCounter() - LoadingTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency()
+           , ImageDecodeThreads, (ImageDecodeThreads == 1 ? "" : "s") );
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::StreamSpritesIntoMemory(Uint32 budgetMS)
+{
+Uint32 startTicks = SDL_GetTicks();
+char filePath[256];
+bool pending = false;
+
+    if (SpritesLoading == false)
+    {
+        if (ImagesCached == 0)  return(true);
+
+        /* Sprites prefetched for the likely next screen, each once its image is decoded */
+        for (int index = 0; index < NumberOfSprites; index++)
+        {
+            if (Sprites[index].References == 0 || Sprites[index].Texture != NULL || SpriteLoadsOnDemand(index) == false)  continue;
+
+            GetSpriteFilePath(index, filePath, sizeof filePath);
+            if ( (budgetMS > 0 && (SDL_GetTicks() - startTicks) >= budgetMS) || (budgetMS > 0 && SpriteInPack(index) == false && ImageDecodedYet(filePath) == false) )
+            {
+                pending = true;
+                continue;
+            }
+
+            if (LoadSprite(index) == false)
+            {
+                CoreFailure = true;
+                return(false);
+            }
+        }
+
+        if (pending == false)  ClearImageCache();
+
+        return(true);
+    }
+
+    /* Images are decoded on the worker threads, here they only become textures, a few each frame */
+    while (SpritesNextToLoad < NumberOfSprites)
+    {
+        if (budgetMS > 0 && (SDL_GetTicks() - startTicks) >= budgetMS)  return(true);
+
+        if (Sprites[SpritesNextToLoad].Texture == NULL && SpriteLoadsOnDemand(SpritesNextToLoad) == false
+            && LoadSprite(SpritesNextToLoad) == false)
+        {
+            SpritesLoading = false;
+            ClearImageCache();
+            CoreFailure = true;
+            return(false);
+        }
+
+        SpritesNextToLoad++;
+    }
+
+    SpritesLoading = false;
+
+    if ( LoadBoxSpriteSheetIntoMemory() == false || LoadInterfaceIntoMemory() == false || PreloadStaffTextsIntoMemory() == false)
+    {
+        ClearImageCache();
+        CoreFailure = true;
+        return(false);
+    }
+
+    ClearImageCache();
+
+    printf( "Loaded all resident sprite images into memory in %.0f ms.\n"
+           , (double)(SDL_GetPerformanceCounter() - LoadingTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency() );
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::FinishLoadingSprites(void)
+{
+    if (SpritesLoading == false)  return(true);
+
+    return( StreamSpritesIntoMemory(0) );
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::LoadBoxSpriteSheetIntoMemory(void)
+{
+Uint32 textureFormat;
+int textureAccess;
+int textureWidth;
+int textureHeight;
+
+    SDL_Surface *spriteSheet = NULL;
+    SDL_Surface *boxTemp = NULL;
+    SDL_Surface *atlas = NULL;
+    SDL_Rect dstRect;
+    SDL_Rect srcRect;
+
+    if (SpriteInPack(BoxAtlasFirstSprite) == true)
+    {
+        int index;
+
+        for (index = 200; index < 260; index++)
+        {
+            if (LoadSpriteFromPack(index) == false)  break;
+        }
+
+        if (index == 260)
+        {
+            BoxAtlas = CreatePackedTexture("atlas/boxes");
+            if (BoxAtlas == NULL)  printf("Box atlas not created, playfields are drawn box by box.\n");
+
+            return(true);
+        }
+
+        /* A partial set of boxes is thrown away and all are cut from the loose sprite sheet */
+        for (index = 200; index < 260; index++)
+        {
+            if (Sprites[index].Texture != NULL)  SDL_DestroyTexture(Sprites[index].Texture);
+            Sprites[index].Texture = NULL;
+        }
+    }
+
+    atlas = SDL_CreateRGBSurfaceWithFormat(0, BoxAtlasColumns*BoxAtlasCellWidth
+                                           , ( (BoxAtlasLastSprite-BoxAtlasFirstSprite+1) / BoxAtlasColumns )*BoxAtlasCellHeight, 32, SDL_PIXELFORMAT_RGBA32);
+
+    spriteSheet = LoadImage("data/visuals/Boxes.png");
+    if (!spriteSheet)
+    {
+        printf( "Image loading failed: %s\n", IMG_GetError() );
+        if (atlas != NULL)  SDL_FreeSurface(atlas);
+        CoreFailure = true;
+        return(false);
+    }
+
+    int x = 1;
+    for (int index = 200; index < 260; index++)
+    {
+        boxTemp = LoadImageCopy("data/visuals/Box.png");
+        if (!boxTemp)
+        {
+            printf( "Image loading failed: %s\n", IMG_GetError() );
+            if (atlas != NULL)  SDL_FreeSurface(atlas);
+            CoreFailure = true;
+            return(false);
+        }
+
+        dstRect.x = 0;
+        dstRect.y = 0;
+        dstRect.w = 13;
+        dstRect.h = 18;
+
+        srcRect.w = 13;
+        srcRect.h = 18;
+
+        if (index > 199 && index < 210)
+        {
+            if (index == 200) x = 1;
+
+            srcRect.x = x;
+            srcRect.y = 1;
+        }
+        else if (index > 209 && index < 220)
+        {
+            if (index == 210) x = 1;
+
+            srcRect.x = x;
             srcRect.y = 1+19*1;
         }
         else if (index > 219 && index < 230)
         {
             if (index == 220) x = 1;
 
-            srcRect.x = x;
-            srcRect.y = 1+19*2;
-        }
-        else if (index > 229 && index < 240)
-        {
-            if (index == 230) x = 1;
+            srcRect.x = x;
+            srcRect.y = 1+19*2;
+        }
+        else if (index > 229 && index < 240)
+        {
+            if (index == 230) x = 1;
+
+            srcRect.x = x;
+            srcRect.y = 1+19*3;
+        }
+        else if (index > 239 && index < 250)
+        {
+            if (index == 240) x = 1;
+
+            srcRect.x = x;
+            srcRect.y = 1+19*4;
+        }
+        else if (index > 249 && index < 260)
+        {
+            if (index == 250) x = 1;
+
+            srcRect.x = x;
+            srcRect.y = 1+19*5;
+        }
+
+        SDL_BlitSurface(spriteSheet, &srcRect, boxTemp, &dstRect);
+        x+=14;
+
+        Sprites[index].Texture = CreateSpriteTexture(index, boxTemp);
+
+        Sprites[index].ScreenX = 320;
+        Sprites[index].ScreenY = 240;
+        Sprites[index].ScaleX = 1.0;
+        Sprites[index].ScaleY = 1.0;
+        Sprites[index].RotationDegree = 0;
+        Sprites[index].RedHue = 255;
+        Sprites[index].GreenHue = 255;
+        Sprites[index].BlueHue = 255;
+        Sprites[index].Transparency = 255;
+        Sprites[index].Smooth = false;
+        Sprites[index].FlipX = false;
+        Sprites[index].FlipY = false;
+
+        Sprites[index].AnimationTimer = 0;
+
+        SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
+        Sprites[index].TextureWidthOriginal = textureWidth;
+        Sprites[index].TextureHeightOriginal = textureHeight;
+
+        if (atlas != NULL)
+        {
+            SDL_Surface *box = SDL_ConvertSurfaceFormat(boxTemp, SDL_PIXELFORMAT_RGBA32, 0);
+
+            if (box != NULL)
+            {
+                int cellX = ( ((index-BoxAtlasFirstSprite) % BoxAtlasColumns) * BoxAtlasCellWidth );
+                int cellY = ( ((index-BoxAtlasFirstSprite) / BoxAtlasColumns) * BoxAtlasCellHeight );
+
+                SDL_LockSurface(box);
+                SDL_LockSurface(atlas);
+                for (int atlasY = 0; atlasY < BoxAtlasCellHeight; atlasY++)
+                {
+                    for (int atlasX = 0; atlasX < BoxAtlasCellWidth; atlasX++)
+                    {
+                        int boxX = ( atlasX < 1 ? 0 : (atlasX > box->w ? box->w-1 : atlasX-1) );
+                        int boxY = ( atlasY < 1 ? 0 : (atlasY > box->h ? box->h-1 : atlasY-1) );
+
+                        ( (Uint32*)((Uint8*)atlas->pixels + (cellY+atlasY)*atlas->pitch) )[cellX+atlasX]
+                            = ( (Uint32*)((Uint8*)box->pixels + boxY*box->pitch) )[boxX];
+                    }
+                }
+                SDL_UnlockSurface(atlas);
+                SDL_UnlockSurface(box);
+
+                SDL_FreeSurface(box);
+            }
+        }
+
+        SDL_FreeSurface(boxTemp);
+    }
+
+    ReleaseImage("data/visuals/Boxes.png");
+    ReleaseImage("data/visuals/Box.png");
+
+    if (atlas != NULL)
+    {
+        if (assetPack != NULL && assetPack->Writing == true)  assetPack->AddImage("atlas/boxes", atlas);
+
+        BoxAtlas = SDL_CreateTextureFromSurface(Renderer, atlas);
+        SDL_FreeSurface(atlas);
+    }
+    if (BoxAtlas == NULL)  printf("Box atlas not created, playfields are drawn box by box.\n");
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::BatchSpriteOntoScreenBuffer(Uint16 index)
+{
+int windowWidth;
+int windowHeight;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (BoxAtlas == NULL || index < BoxAtlasFirstSprite || index > BoxAtlasLastSprite)
+#endif
+    {
+        DrawSpriteBatch();
+        DrawSpriteOntoScreenBuffer(index);
+        return;
+    }
+
+    if (BatchedSprites == MaxBatchedSprites)  DrawSpriteBatch();
+
+    SDL_GetWindowSize(Window, &windowWidth, &windowHeight);
+
+    float winWidthFixed;
+    float winHeightFixed;
+    if (ForceAspectRatio == false)
+    {
+        winWidthFixed = (float)windowWidth / 640;
+        winHeightFixed = (float)windowHeight / 480;
+    }
+    else
+    {
+        winWidthFixed = 1;
+        winHeightFixed = 1;
+    }
+
+    /* Same rectangle, tint and transparency DrawSpriteOntoScreenBuffer() gives a box, boxes are never rotated or flipped */
+    int textureWidth = Sprites[index].TextureWidthOriginal;
+    int textureHeight = Sprites[index].TextureHeightOriginal;
+    float left = (float)(int)(( Sprites[index].ScreenX * (winWidthFixed) )
+                        - (  ( (textureWidth * Sprites[index].ScaleX) * (winWidthFixed) ) / 2  ));
+    float top = (float)(int)(( Sprites[index].ScreenY * (winHeightFixed) )
+                        - (  ( (textureHeight * Sprites[index].ScaleY) * (winHeightFixed) ) / 2  ));
+    float right = left + (float)(int)(textureWidth * Sprites[index].ScaleX * (winWidthFixed));
+    float bottom = top + (float)(int)(textureHeight * Sprites[index].ScaleY * (winHeightFixed));
+
+    int atlasWidth = ( BoxAtlasColumns * BoxAtlasCellWidth );
+    int atlasHeight = ( ((BoxAtlasLastSprite-BoxAtlasFirstSprite+1) / BoxAtlasColumns) * BoxAtlasCellHeight );
+    float u0 = ( (float)( (((index-BoxAtlasFirstSprite) % BoxAtlasColumns) * BoxAtlasCellWidth) + 1 ) / atlasWidth );
+    float v0 = ( (float)( (((index-BoxAtlasFirstSprite) / BoxAtlasColumns) * BoxAtlasCellHeight) + 1 ) / atlasHeight );
+    float u1 = ( u0 + ((float)(BoxAtlasCellWidth-2) / atlasWidth) );
+    float v1 = ( v0 + ((float)(BoxAtlasCellHeight-2) / atlasHeight) );
+
+    SDL_Color color = { Sprites[index].RedHue, Sprites[index].GreenHue, Sprites[index].BlueHue, Sprites[index].Transparency };
+    SDL_Vertex *vertex = &BatchVertices[BatchedSprites * 4];
+
+    vertex[0].position.x = left;   vertex[0].position.y = top;     vertex[0].tex_coord.x = u0;  vertex[0].tex_coord.y = v0;
+    vertex[1].position.x = right;  vertex[1].position.y = top;     vertex[1].tex_coord.x = u1;  vertex[1].tex_coord.y = v0;
+    vertex[2].position.x = left;   vertex[2].position.y = bottom;  vertex[2].tex_coord.x = u0;  vertex[2].tex_coord.y = v1;
+    vertex[3].position.x = right;  vertex[3].position.y = bottom;  vertex[3].tex_coord.x = u1;  vertex[3].tex_coord.y = v1;
+    for (int corner = 0; corner < 4; corner++)  vertex[corner].color = color;
+
+    BatchedSprites++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::DrawSpriteBatch(void)
+{
+    if (BatchedSprites == 0)  return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (SDL_RenderGeometry(Renderer, BoxAtlas, BatchVertices, BatchedSprites * 4, BatchIndices, BatchedSprites * 6) != 0)
+        printf("Box batch not drawn: %s\n", SDL_GetError());
+#endif
+
+    BatchedSprites = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::BeginStaticLayer(Uint32 key)
+{
+int width = 0;
+int height = 0;
+
+    /* Same coordinates the screen is drawn in, so the layer is copied back 1:1 */
+    SDL_RenderGetLogicalSize(Renderer, &width, &height);
+    if (width == 0 || height == 0)  SDL_GetRendererOutputSize(Renderer, &width, &height);
+
+    if (StaticLayer != NULL && StaticLayerKey == key && StaticLayerWidth == width && StaticLayerHeight == height)  return(false);
+
+    /* Without render targets the caller draws its static part straight onto the screen every time */
+    StaticLayerDrawing = false;
+    if (StaticLayerFailed == true || SDL_RenderTargetSupported(Renderer) == SDL_FALSE)  return(true);
+
+    if (StaticLayer == NULL || StaticLayerWidth != width || StaticLayerHeight != height)
+    {
+        if (StaticLayer != NULL)  SDL_DestroyTexture(StaticLayer);
+
+        StaticLayer = SDL_CreateTexture(Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (StaticLayer == NULL)
+        {
+            printf("Static layer not created, screens draw their backgrounds every frame: %s\n", SDL_GetError());
+            StaticLayerWidth = 0;
+            StaticLayerHeight = 0;
+            StaticLayerFailed = true;
+            return(true);
+        }
+
+        /* Copied over whatever the last frame left, so it replaces it completely */
+        SDL_SetTextureBlendMode(StaticLayer, SDL_BLENDMODE_NONE);
+
+        StaticLayerWidth = width;
+        StaticLayerHeight = height;
+    }
+
+    if (SDL_SetRenderTarget(Renderer, StaticLayer) != 0)
+    {
+        printf("Static layer not drawn to, screens draw their backgrounds every frame: %s\n", SDL_GetError());
+        InvalidateStaticLayer();
+        StaticLayerFailed = true;
+        return(true);
+    }
+
+    SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 255);
+    SDL_RenderClear(Renderer);
+
+    StaticLayerKey = key;
+    StaticLayerDrawing = true;
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::EndStaticLayer(void)
+{
+    if (StaticLayerDrawing == false)  return;
+
+    DrawSpriteBatch();
+    SDL_SetRenderTarget(Renderer, NULL);
+
+    StaticLayerDrawing = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::DrawStaticLayer(void)
+{
+    if (StaticLayer == NULL)  return;
+
+    SDL_RenderCopy(Renderer, StaticLayer, NULL, NULL);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::InvalidateStaticLayer(void)
+{
+    /* The renderer lost its targets, or a screen without a layer is showing */
+    if (StaticLayer != NULL)  SDL_DestroyTexture(StaticLayer);
+
+    StaticLayer = NULL;
+    StaticLayerKey = 0;
+    StaticLayerWidth = 0;
+    StaticLayerHeight = 0;
+    StaticLayerDrawing = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::BeginBoard(int board)
+{
+    if (BoardTexture[board] != NULL)  return(true);
+
+    /* Without render targets the boxes are batched every frame instead */
+    if (BoardTexturesFailed == true || SDL_RenderTargetSupported(Renderer) == SDL_FALSE)  return(false);
+
+    BoardTexture[board] = SDL_CreateTexture(Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET
+                                            , BoardColumns*BoardCellWidth, BoardRows*BoardCellHeight);
+
+    if (BoardTexture[board] == NULL || SDL_SetRenderTarget(Renderer, BoardTexture[board]) != 0)
+    {
+        printf("Board texture not created, boards are drawn box by box: %s\n", SDL_GetError());
+        if (BoardTexture[board] != NULL)  SDL_DestroyTexture(BoardTexture[board]);
+        BoardTexture[board] = NULL;
+        BoardTexturesFailed = true;
+        return(false);
+    }
+
+    SDL_SetTextureBlendMode(BoardTexture[board], SDL_BLENDMODE_BLEND);
+
+    /* Starts empty, same as its snapshot */
+    SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 0);
+    SDL_RenderClear(Renderer);
+    SDL_SetRenderTarget(Renderer, NULL);
+
+    for (int y = 0; y < BoardRows; y++)
+    {
+        for (int x = 0; x < BoardColumns; x++)  BoardCell[board][x][y] = 0;
+    }
+    BoardDirtyCells[board] = 0;
+
+    return(true);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::SetBoardCell(int board, int x, int y, int index, Uint8 transparency)
+{
+Uint16 cell = 0;
+
+    if (index >= BoxAtlasFirstSprite && index <= BoxAtlasLastSprite && transparency > 0)
+        cell = (Uint16)( ((index - BoxAtlasFirstSprite + 1) << 8) | transparency );
+
+    if (BoardCell[board][x][y] == cell)  return;
+
+    BoardCell[board][x][y] = cell;
+
+    if (BoardDirtyCells[board] == BoardColumns*BoardRows)  return;
+
+    BoardDirtyX[board][ BoardDirtyCells[board] ] = (Uint8)x;
+    BoardDirtyY[board][ BoardDirtyCells[board] ] = (Uint8)y;
+    BoardDirtyCells[board]++;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::DrawBoard(int board, float firstBoxScreenX, float firstBoxScreenY)
+{
+SDL_Rect cellRect;
+SDL_Rect destinationRect;
+int windowWidth;
+int windowHeight;
+
+    if (BoardTexture[board] == NULL)  return;
+
+    /* Usually only the falling piece and its drop shadow moved */
+    if (BoardDirtyCells[board] > 0)
+    {
+        DrawSpriteBatch();
+
+        if (SDL_SetRenderTarget(Renderer, BoardTexture[board]) != 0)
+        {
+            InvalidateBoards();
+            return;
+        }
+
+        SDL_SetRenderDrawBlendMode(Renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 0);
+
+        for (int dirty = 0; dirty < BoardDirtyCells[board]; dirty++)
+        {
+            int x = BoardDirtyX[board][dirty];
+            int y = BoardDirtyY[board][dirty];
+            Uint16 cell = BoardCell[board][x][y];
+
+            cellRect.x = x * BoardCellWidth;
+            cellRect.y = y * BoardCellHeight;
+            cellRect.w = BoardCellWidth;
+            cellRect.h = BoardCellHeight;
+
+            if (cell == 0)
+            {
+                SDL_RenderFillRect(Renderer, &cellRect);
+                continue;
+            }
+
+            /* Replaces the cell instead of blending, so the texture keeps the box's own colour and transparency */
+            int index = BoxAtlasFirstSprite - 1 + (cell >> 8);
+            SDL_SetTextureBlendMode(Sprites[index].Texture, SDL_BLENDMODE_NONE);
+            SDL_SetTextureColorMod(Sprites[index].Texture, Sprites[index].RedHue, Sprites[index].GreenHue, Sprites[index].BlueHue);
+            SDL_SetTextureAlphaMod(Sprites[index].Texture, (Uint8)(cell & 0xFF));
+            SDL_RenderCopy(Renderer, Sprites[index].Texture, NULL, &cellRect);
+            SDL_SetTextureBlendMode(Sprites[index].Texture, SDL_BLENDMODE_BLEND);
+        }
+
+        SDL_SetRenderTarget(Renderer, NULL);
+        BoardDirtyCells[board] = 0;
+    }
+
+    SDL_GetWindowSize(Window, &windowWidth, &windowHeight);
+
+    float winWidthFixed;
+    float winHeightFixed;
+    if (ForceAspectRatio == false)
+    {
+        winWidthFixed = (float)windowWidth / 640;
+        winHeightFixed = (float)windowHeight / 480;
+    }
+    else
+    {
+        winWidthFixed = 1;
+        winHeightFixed = 1;
+    }
+
+    /* Where DrawSpriteOntoScreenBuffer() puts the board's top left box */
+    destinationRect.x = (int)( (firstBoxScreenX * winWidthFixed) - ((BoardCellWidth * winWidthFixed) / 2) );
+    destinationRect.y = (int)( (firstBoxScreenY * winHeightFixed) - ((BoardCellHeight * winHeightFixed) / 2) );
+    destinationRect.w = (int)(BoardColumns * BoardCellWidth * winWidthFixed);
+    destinationRect.h = (int)(BoardRows * BoardCellHeight * winHeightFixed);
+
+    SDL_RenderCopy(Renderer, BoardTexture[board], NULL, &destinationRect);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::InvalidateBoards(void)
+{
+    for (int board = 0; board < MaxBoards; board++)
+    {
+        if (BoardTexture[board] != NULL)  SDL_DestroyTexture(BoardTexture[board]);
+
+        BoardTexture[board] = NULL;
+        BoardDirtyCells[board] = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::GetInterfaceFilePath(int index, char *filePath, size_t filePathSize)
+{
+    SDL_strlcpy(filePath, "~", filePathSize);
+
+    switch(index)
+    {
+        case 999:
+            SDL_strlcpy(filePath, "data/visuals/Letter-Tile.png", filePathSize);
+            break;
+
+        case 1000:
+            SDL_strlcpy(filePath, "data/visuals/Button-Selector-Left.png", filePathSize);
+            break;
+
+        case 1001:
+            SDL_strlcpy(filePath, "data/visuals/Button-Selector-Right.png", filePathSize);
+            break;
+
+        case 1002:
+            SDL_strlcpy(filePath, "data/visuals/Selector-Line.png", filePathSize);
+            break;
 
-            srcRect.x = x;
-            srcRect.y = 1+19*3;
-        }
-        else if (index > 239 && index < 250)
-        {
-            if (index == 240) x = 1;
+        case 1003:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-            srcRect.x = x;
-            srcRect.y = 1+19*4;
-        }
-        else if (index > 249 && index < 260)
-        {
-            if (index == 250) x = 1;
+        case 1004:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-            srcRect.x = x;
-            srcRect.y = 1+19*5;
-        }
+        case 1005:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        SDL_BlitSurface(spriteSheet, &srcRect, boxTemp, &dstRect);
-        x+=14;
+        case 1006:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        Sprites[index].Texture = SDL_CreateTextureFromSurface(Renderer, boxTemp);
+        case 1007:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        Sprites[index].ScreenX = 320;
-        Sprites[index].ScreenY = 240;
-        Sprites[index].ScaleX = 1.0;
-        Sprites[index].ScaleY = 1.0;
-        Sprites[index].RotationDegree = 0;
-        Sprites[index].RedHue = 255;
-        Sprites[index].GreenHue = 255;
-        Sprites[index].BlueHue = 255;
-        Sprites[index].Transparency = 255;
-        Sprites[index].Smooth = false;
-        Sprites[index].FlipX = false;
-        Sprites[index].FlipY = false;
+        case 1008:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        Sprites[index].AnimationTimer = 0;
+        case 1009:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
-        Sprites[index].TextureWidthOriginal = textureWidth;
-        Sprites[index].TextureHeightOriginal = textureHeight;
+        case 1010:
+            SDL_strlcpy(filePath, "data/visuals/Button.png", filePathSize);
+            break;
 
-        SDL_FreeSurface(boxTemp);
-    }
+        case 1011:
+            SDL_strlcpy(filePath, "data/visuals/SetupGamepad.png", filePathSize);
+            break;
 
-    SDL_FreeSurface(spriteSheet);
+        default:
+            break;
+    }
 
-    return(true);
+    if (index > 1019)  SDL_strlcpy(filePath, "data/visuals/Letter-Tile.png", filePathSize);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -548,71 +1562,16 @@ char temp[256];
 
     for ( int index = 999; index < (1010+65+10); index++ )
     {
-        SDL_strlcpy(filePath, "~", sizeof filePath);
-
-        switch(index)
-        {
-            case 999:
-                SDL_strlcpy(filePath, "data/visuals/Letter-Tile.png", sizeof filePath);
-                break;
-
-            case 1000:
-                SDL_strlcpy(filePath, "data/visuals/Button-Selector-Left.png", sizeof filePath);
-                break;
-
-            case 1001:
-                SDL_strlcpy(filePath, "data/visuals/Button-Selector-Right.png", sizeof filePath);
-                break;
-
-            case 1002:
-                SDL_strlcpy(filePath, "data/visuals/Selector-Line.png", sizeof filePath);
-                break;
-
-            case 1003:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1004:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1005:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1006:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1007:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1008:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
+        GetInterfaceFilePath(index, filePath, sizeof filePath);
 
-            case 1009:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1010:
-                SDL_strlcpy(filePath, "data/visuals/Button.png", sizeof filePath);
-                break;
-
-            case 1011:
-                SDL_strlcpy(filePath, "data/visuals/SetupGamepad.png", sizeof filePath);
-                break;
-
-            default:
-                break;
-        }
-
-        if (index > 1019)  SDL_strlcpy(filePath, "data/visuals/Letter-Tile.png", sizeof filePath);
+        /* Packed buttons and letter tiles already have their text drawn on */
+        if (filePath[0] != '~' && LoadSpriteFromPack(index) == true)  continue;
 
         if (filePath[0] != '~')
         {
-            tempSurface = IMG_Load(filePath);
+            /* Buttons and letter tiles get their text drawn on, so they need their own copy */
+            if ( index > 1002 && index < (1010+65+10) )  tempSurface = LoadImageCopy(filePath);
+            else  tempSurface = LoadImage(filePath);
 
             if (!tempSurface)
             {
@@ -711,7 +1670,7 @@ char temp[256];
 
         if (filePath[0] != '~')
         {
-            Sprites[index].Texture = SDL_CreateTextureFromSurface(Renderer, tempSurface);
+            Sprites[index].Texture = CreateSpriteTexture(index, tempSurface);
 
             Sprites[index].ScreenX = 320;
             Sprites[index].ScreenY = 240;
@@ -732,7 +1691,8 @@ char temp[256];
             Sprites[index].TextureWidthOriginal = textureWidth;
             Sprites[index].TextureHeightOriginal = textureHeight;
 
-            SDL_FreeSurface(tempSurface);
+            if ( index > 1002 && index < (1010+65+10) )  SDL_FreeSurface(tempSurface);
+            ReleaseImage(filePath);
         }
     }
 
@@ -749,13 +1709,21 @@ int textureHeight;
 
     Sprites[1100+TotalNumberOfLoadedStaffTexts].Texture = NULL;
 
+    if (LoadSpriteFromPack(1100+TotalNumberOfLoadedStaffTexts) == true)
+    {
+        Sprites[1100+TotalNumberOfLoadedStaffTexts].BlueHue = textBlue;
+
+        TotalNumberOfLoadedStaffTexts++;
+        return(true);
+    }
+
     SDL_Color textColor = { 255, 255, 255, 255 };
     SDL_Color outlineColor = { 0, 0, 0, 255 };
     SDL_Surface *text;
     SDL_Surface *textOutline;
     SDL_Rect destRect;
 
-    SDL_Surface *tempSurface = IMG_Load("data/visuals/Staff-Text-Image.png");
+    SDL_Surface *tempSurface = LoadImageCopy("data/visuals/Staff-Text-Image.png");
 
     if (!tempSurface)
     {
@@ -786,7 +1754,7 @@ int textureHeight;
     SDL_FreeSurface(text);
     SDL_FreeSurface(textOutline);
 
-    Sprites[1100+TotalNumberOfLoadedStaffTexts].Texture = SDL_CreateTextureFromSurface(Renderer, tempSurface);
+    Sprites[1100+TotalNumberOfLoadedStaffTexts].Texture = CreateSpriteTexture(1100+TotalNumberOfLoadedStaffTexts, tempSurface);
 
     Sprites[1100+TotalNumberOfLoadedStaffTexts].ScreenX = 320;
     Sprites[1100+TotalNumberOfLoadedStaffTexts].ScreenY = 240;
@@ -1049,6 +2017,9 @@ int textureAccess;
 int textureWidth;
 int textureHeight;
 
+    /* A screen drew a sprite its manifest does not list, it stays loaded until evicted */
+    if (Sprites[index].Texture == NULL && SpriteLoadsOnDemand(index) == true && LoadSprite(index) == false)  return;
+
     SDL_GetWindowSize(Window, &windowWidth, &windowHeight);
 
     SDL_QueryTexture(Sprites[index].Texture, &textureFormat, &textureAccess, &textureWidth, &textureHeight);
@@ -1207,148 +2178,306 @@ void Visuals::ClearTextCache(void)
     for (int index = 0; index < NumberOfTextsCached; index++)
     {
         if (TextTexture[index] != NULL)  SDL_DestroyTexture(TextTexture[index]);
-        if (TextOutlineTexture[index] != NULL)  SDL_DestroyTexture(TextOutlineTexture[index]);
 
         TextTexture[index] = NULL;
-        TextOutlineTexture[index] = NULL;
 
         TextCachedText[index][0] = '\0';
-        TextCachedScreenX[index] = 320;
-        TextCachedScreenY[index] = 240;
+        TextCachedFont[index] = NULL;
+        TextCachedKey[index] = 0;
+        TextCacheNext[index] = -1;
+        TextCacheLastUsed[index] = 0;
 
         TextCachedWidth[index] = 0;
         TextCachedHeight[index] = 0;
 
-        TextCacheRed[index] = -1;
-        TextCacheGreen[index] = -1;
-        TextCacheBlue[index] = -1;
+        TextCacheRed[index] = 0;
+        TextCacheGreen[index] = 0;
+        TextCacheBlue[index] = 0;
+        TextCacheOutlineRed[index] = 0;
+        TextCacheOutlineGreen[index] = 0;
+        TextCacheOutlineBlue[index] = 0;
     }
 
-    TextCacheCurrentIndex = 0;
+    for (int bucket = 0; bucket < TextCacheBuckets; bucket++)  TextCacheBucket[bucket] = -1;
+
+    TextCacheUses = 0;
 
     printf("Cleared TTF text cache.\n");
 }
 
 //-------------------------------------------------------------------------------------------------
-void Visuals::DrawTextOntoScreenBuffer(const char *textToDisplay, TTF_Font *font, float posX, float posY
-                                       , Uint8 XJustification, Uint8 textRed, Uint8 textGreen, Uint8 textBlue
-                                       , Uint8 outlineRed, Uint8 outlineGreen, Uint8 outlineBlue)
+Uint32 Visuals::TextCacheKey(const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor)
 {
-SDL_Color textColor = { textRed, textGreen, textBlue, 255 };
-SDL_Color outlineColor = { outlineRed, outlineGreen, outlineBlue, 255 };
-SDL_Surface *text = NULL;
-SDL_Surface *textOutline = NULL;
-SDL_Texture *textTexture = NULL;
-SDL_Texture *textOutlineTexture = NULL;
-SDL_Rect destinationRect;
-SDL_Rect destinationOutlineRect;
-int windowWidth;
-int windowHeight;
-int textCacheCheckIndex = NumberOfTextsCached;
-bool sentenceMatches = true;
-bool sentenceIsInCache = false;
+Uint32 key = 2166136261u;  /* FNV-1a */
+Uint64 fontAddress = (Uint64)(size_t)font;
 
-    if (font != Font[5])  posY-=3;
-    else  posY+=2;
+    for (const char *character = textToDisplay; *character != '\0'; character++)  key = (key ^ (Uint8)*character) * 16777619u;
+
+    for (int byte = 0; byte < 8; byte++)  key = (key ^ (Uint8)(fontAddress >> (byte*8))) * 16777619u;
+
+    key = (key ^ textColor.r) * 16777619u;
+    key = (key ^ textColor.g) * 16777619u;
+    key = (key ^ textColor.b) * 16777619u;
+    key = (key ^ outlineColor.r) * 16777619u;
+    key = (key ^ outlineColor.g) * 16777619u;
+    key = (key ^ outlineColor.b) * 16777619u;
+
+    return(key);
+}
+
+//-------------------------------------------------------------------------------------------------
+int Visuals::FindCachedText(Uint32 key, const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor)
+{
+    for (int index = TextCacheBucket[key & (TextCacheBuckets-1)]; index != -1; index = TextCacheNext[index])
+    {
+        if (TextCachedKey[index] != key || TextCachedFont[index] != font)  continue;
+
+        if (TextCacheRed[index] != textColor.r || TextCacheGreen[index] != textColor.g || TextCacheBlue[index] != textColor.b)  continue;
+        if (TextCacheOutlineRed[index] != outlineColor.r || TextCacheOutlineGreen[index] != outlineColor.g
+         || TextCacheOutlineBlue[index] != outlineColor.b)  continue;
+
+        if (strcmp(TextCachedText[index], textToDisplay) == 0)  return(index);
+    }
+
+    return(-1);
+}
 
-    for (textCacheCheckIndex = 0; textCacheCheckIndex < NumberOfTextsCached; textCacheCheckIndex++)
+//-------------------------------------------------------------------------------------------------
+int Visuals::EvictCachedText(void)
+{
+int oldest = 0;
+int *link;
+
+    /* Unused entries have a use count of 0, so they go before the least recently drawn text */
+    for (int index = 1; index < NumberOfTextsCached; index++)
+    {
+        if (TextCacheLastUsed[index] < TextCacheLastUsed[oldest])  oldest = index;
+    }
+
+    if (TextTexture[oldest] != NULL)
     {
-        sentenceMatches = true;
-        if ( strlen(TextCachedText[textCacheCheckIndex]) == strlen(textToDisplay) )
+        for (link = &TextCacheBucket[TextCachedKey[oldest] & (TextCacheBuckets-1)]; *link != -1; link = &TextCacheNext[*link])
         {
-            for (Uint16 index = 0; index < strlen(textToDisplay); index++)
+            if (*link == oldest)
             {
-                if (TextCachedText[textCacheCheckIndex][index] != textToDisplay[index])  sentenceMatches = false;
+                *link = TextCacheNext[oldest];
+                break;
             }
         }
-        else  sentenceMatches = false;
 
-        if (sentenceMatches == true)
+        SDL_DestroyTexture(TextTexture[oldest]);
+        TextTexture[oldest] = NULL;
+    }
+
+    TextCachedText[oldest][0] = '\0';
+    TextCacheNext[oldest] = -1;
+    TextCacheLastUsed[oldest] = 0;
+
+    return(oldest);
+}
+
+//-------------------------------------------------------------------------------------------------
+SDL_Texture* Visuals::CreateOutlinedTextTexture(const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor
+                                               , int *textWidth, int *textHeight)
+{
+SDL_Surface *text = NULL;
+SDL_Surface *textOutline = NULL;
+SDL_Surface *outlined = NULL;
+SDL_Texture *texture = NULL;
+SDL_Rect destRect;
+Uint32 outlineRGB;
+
+    text = TTF_RenderText_Blended(font, textToDisplay, textColor);
+    textOutline = TTF_RenderText_Blended(font, textToDisplay, outlineColor);
+
+    if (text != NULL && textOutline != NULL)
+    {
+        outlined = SDL_CreateRGBSurfaceWithFormat(0, text->w + (TextOutlineThickness*2), text->h + (TextOutlineThickness*2), 32, SDL_PIXELFORMAT_RGBA32);
+    }
+
+    if (outlined != NULL)
+    {
+        /* Outline stamped once per offset here, instead of every time the text is drawn */
+        for (int posY = 0; posY <= (TextOutlineThickness*2); posY++)
         {
-            if (TextCachedScreenX[textCacheCheckIndex] == posX && TextCachedScreenY[textCacheCheckIndex] == posY)
+            for (int posX = 0; posX <= (TextOutlineThickness*2); posX++)
             {
-                sentenceIsInCache = true;
+                destRect.x = posX;
+                destRect.y = posY;
 
-                if (TextCacheRed[textCacheCheckIndex] != textRed)  sentenceIsInCache = false;
-                if (TextCacheGreen[textCacheCheckIndex] != textGreen)  sentenceIsInCache = false;
-                if (TextCacheBlue[textCacheCheckIndex] != textBlue)  sentenceIsInCache = false;
-
-                if (sentenceIsInCache == true)  break;
+                SDL_BlitSurface(textOutline, NULL, outlined, &destRect);
             }
         }
-    }
 
-    if (sentenceIsInCache == false)
-    {
-        if (TextTexture[TextCacheCurrentIndex] != NULL)  SDL_DestroyTexture(TextTexture[TextCacheCurrentIndex]);
-        if (TextOutlineTexture[TextCacheCurrentIndex] != NULL)  SDL_DestroyTexture(TextOutlineTexture[TextCacheCurrentIndex]);
-        TextTexture[TextCacheCurrentIndex] = NULL;
-        TextOutlineTexture[TextCacheCurrentIndex] = NULL;
-        TextCachedText[TextCacheCurrentIndex][0] = '\0';
-        TextCachedScreenX[TextCacheCurrentIndex] = 320;
-        TextCachedScreenY[TextCacheCurrentIndex] = 240;
-        TextCachedWidth[TextCacheCurrentIndex] = 0;
-        TextCachedHeight[TextCacheCurrentIndex] = 0;
-        TextCacheRed[TextCacheCurrentIndex] = textRed;
-        TextCacheGreen[TextCacheCurrentIndex] = textGreen;
-        TextCacheBlue[TextCacheCurrentIndex] = textBlue;
+        /* Blending onto the clear surface darkened the outline's soft edges, only its coverage is kept */
+        outlineRGB = SDL_MapRGBA(outlined->format, outlineColor.r, outlineColor.g, outlineColor.b, 0);
+        SDL_LockSurface(outlined);
+        for (int posY = 0; posY < outlined->h; posY++)
+        {
+            Uint32 *pixel = (Uint32*)((Uint8*)outlined->pixels + posY*outlined->pitch);
 
-        text = TTF_RenderText_Blended(font, textToDisplay, textColor);
-        textOutline = TTF_RenderText_Blended(font, textToDisplay, outlineColor);
+            for (int posX = 0; posX < outlined->w; posX++)  pixel[posX] = (pixel[posX] & outlined->format->Amask) | outlineRGB;
+        }
+        SDL_UnlockSurface(outlined);
 
-        SDL_strlcpy(TextCachedText[TextCacheCurrentIndex], textToDisplay, sizeof TextCachedText[TextCacheCurrentIndex]);
+        destRect.x = TextOutlineThickness;
+        destRect.y = TextOutlineThickness;
+        SDL_BlitSurface(text, NULL, outlined, &destRect);
 
-        TextCachedScreenX[TextCacheCurrentIndex] = posX;
-        TextCachedScreenY[TextCacheCurrentIndex] = posY;
+        texture = SDL_CreateTextureFromSurface(Renderer, outlined);
 
-        TextCachedWidth[TextCacheCurrentIndex] = text->w;
-        TextCachedHeight[TextCacheCurrentIndex] = text->h;
+        *textWidth = text->w;
+        *textHeight = text->h;
+    }
 
-        textTexture = SDL_CreateTextureFromSurface(Renderer, text);
-        TextTexture[TextCacheCurrentIndex] = SDL_CreateTextureFromSurface(Renderer, text);
+    if (outlined != NULL)  SDL_FreeSurface(outlined);
+    if (textOutline != NULL)  SDL_FreeSurface(textOutline);
+    if (text != NULL)  SDL_FreeSurface(text);
 
-        textOutlineTexture = SDL_CreateTextureFromSurface(Renderer, textOutline);
-        TextOutlineTexture[TextCacheCurrentIndex] = SDL_CreateTextureFromSurface(Renderer, textOutline);
+    return(texture);
+}
 
-        if (XJustification == JustifyLeft)
-        {
-            posX = posX + (text->w / 2);
-        }
-        else if (XJustification == JustifyCenter)
-        {
-            posX = (640 / 2);
-        }
-        else if (XJustification == JustifyRight)
-        {
-            posX = (640 - posX) - (text->w / 2);
-        }
-        else if (XJustification == JustifyCenterOnPoint)
+//-------------------------------------------------------------------------------------------------
+bool Visuals::BuildGlyphAtlas(int font)
+{
+SDL_Color white = { 255, 255, 255, 255 };
+SDL_Surface *glyph[GlyphAtlasGlyphs];
+SDL_Surface *atlas = NULL;
+SDL_Rect destRect;
+char character[2];
+int atlasX = 0;
+bool rendered = true;
+
+    GlyphAtlasTried[font] = true;
+    GlyphHeight[font] = 0;
+
+    for (int index = 0; index < GlyphAtlasGlyphs; index++)
+    {
+        character[0] = GlyphAtlasCharacters[index];
+        character[1] = '\0';
+
+        glyph[index] = TTF_RenderText_Blended(Font[font], character, white);
+        if (glyph[index] == NULL)
         {
-            posX = posX;
+            rendered = false;
+            continue;
         }
 
-        if ( TextCacheCurrentIndex < (NumberOfTextsCached-1) )  TextCacheCurrentIndex++;
-        else  TextCacheCurrentIndex = 0;
+        /* Each cell holds the glyph and its outline, with a clear pixel around it so filtering never bleeds */
+        GlyphX[font][index] = atlasX;
+        GlyphWidth[font][index] = glyph[index]->w;
+        atlasX += ( glyph[index]->w + (TextOutlineThickness*2) + 2 );
+
+        if (glyph[index]->h > GlyphHeight[font])  GlyphHeight[font] = glyph[index]->h;
     }
-    else
+
+    GlyphAtlasWidth[font] = atlasX;
+    GlyphAtlasRowHeight[font] = ( GlyphHeight[font] + (TextOutlineThickness*2) + 2 );
+
+    /* Outlines on the top row, glyphs on the bottom row */
+    if (rendered == true)  atlas = SDL_CreateRGBSurfaceWithFormat(0, GlyphAtlasWidth[font], GlyphAtlasRowHeight[font]*2, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (atlas != NULL)
     {
-        if (XJustification == JustifyLeft)
-        {
-            posX = posX + (TextCachedWidth[textCacheCheckIndex] / 2);
-        }
-        else if (XJustification == JustifyCenter)
-        {
-            posX = (640 / 2);
-        }
-        else if (XJustification == JustifyRight)
+        for (int index = 0; index < GlyphAtlasGlyphs; index++)
         {
-            posX = (640 - posX) - (TextCachedWidth[textCacheCheckIndex] / 2);
+            for (int posY = 0; posY <= (TextOutlineThickness*2); posY++)
+            {
+                for (int posX = 0; posX <= (TextOutlineThickness*2); posX++)
+                {
+                    destRect.x = GlyphX[font][index] + 1 + posX;
+                    destRect.y = 1 + posY;
+
+                    SDL_BlitSurface(glyph[index], NULL, atlas, &destRect);
+                }
+            }
+
+            destRect.x = GlyphX[font][index] + 1 + TextOutlineThickness;
+            destRect.y = GlyphAtlasRowHeight[font] + 1 + TextOutlineThickness;
+            SDL_BlitSurface(glyph[index], NULL, atlas, &destRect);
         }
-        else if (XJustification == JustifyCenterOnPoint)
+
+        /* Only the coverage is kept, the colour comes from the vertices */
+        Uint32 whiteRGB = SDL_MapRGBA(atlas->format, 255, 255, 255, 0);
+        SDL_LockSurface(atlas);
+        for (int posY = 0; posY < atlas->h; posY++)
         {
-            posX = posX;
+            Uint32 *pixel = (Uint32*)((Uint8*)atlas->pixels + posY*atlas->pitch);
+
+            for (int posX = 0; posX < atlas->w; posX++)  pixel[posX] = (pixel[posX] & atlas->format->Amask) | whiteRGB;
         }
+        SDL_UnlockSurface(atlas);
+
+        GlyphAtlas[font] = SDL_CreateTextureFromSurface(Renderer, atlas);
+        if (GlyphAtlas[font] != NULL)  SDL_SetTextureBlendMode(GlyphAtlas[font], SDL_BLENDMODE_BLEND);
+
+        SDL_FreeSurface(atlas);
+    }
+
+    for (int index = 0; index < GlyphAtlasGlyphs; index++)
+    {
+        if (glyph[index] != NULL)  SDL_FreeSurface(glyph[index]);
+    }
+
+    if (GlyphAtlas[font] == NULL)  printf("Glyph atlas for font %i not created, its numbers are drawn from the text cache.\n", font);
+
+    return(GlyphAtlas[font] != NULL);
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::ClearGlyphAtlases(void)
+{
+    for (int font = 0; font < NumberOfFonts; font++)
+    {
+        if (GlyphAtlas[font] != NULL)  SDL_DestroyTexture(GlyphAtlas[font]);
+
+        GlyphAtlas[font] = NULL;
+        GlyphAtlasTried[font] = false;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+bool Visuals::DrawGlyphTextOntoScreenBuffer(const char *textToDisplay, TTF_Font *font, float posX, float posY
+                                            , Uint8 XJustification, Uint8 textRed, Uint8 textGreen, Uint8 textBlue
+                                            , Uint8 outlineRed, Uint8 outlineGreen, Uint8 outlineBlue)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+int fontIndex = -1;
+int glyphs[64];
+int length = 0;
+int textWidth = 0;
+int windowWidth;
+int windowHeight;
+
+    for (int index = 0; index < NumberOfFonts; index++)
+    {
+        if (Font[index] == font)  fontIndex = index;
     }
+    if (fontIndex == -1 || font == NULL)  return(false);
+
+    for (length = 0; textToDisplay[length] != '\0'; length++)
+    {
+        if (length == 64)  return(false);
+
+        const char *character = strchr(GlyphAtlasCharacters, textToDisplay[length]);
+        if (character == NULL)  return(false);
+
+        glyphs[length] = (int)(character - GlyphAtlasCharacters);
+    }
+    if (length == 0)  return(false);
+
+    if (GlyphAtlasTried[fontIndex] == false)  BuildGlyphAtlas(fontIndex);
+    if (GlyphAtlas[fontIndex] == NULL)  return(false);
+
+    for (int index = 0; index < length; index++)  textWidth += GlyphWidth[fontIndex][glyphs[index]];
+
+    /* Placed exactly as DrawTextOntoScreenBuffer() places the same string from the text cache */
+    if (font != Font[5])  posY-=3;
+    else  posY+=2;
+
+    if (XJustification == JustifyLeft)  posX = posX + (textWidth / 2);
+    else if (XJustification == JustifyCenter)  posX = (640 / 2);
+    else if (XJustification == JustifyRight)  posX = (640 - posX) - (textWidth / 2);
 
     SDL_GetWindowSize(Window, &windowWidth, &windowHeight);
 
@@ -1365,51 +2494,158 @@ bool sentenceIsInCache = false;
         winHeightFixed = 1;
     }
 
-    if (sentenceIsInCache == false)
+    /* Anything already batched goes first, then its vertices are free for the glyphs */
+    DrawSpriteBatch();
+
+    float textLeft = (float)(int)((posX * winWidthFixed) - ( (textWidth * winWidthFixed) / 2 ));
+    float textTop = (float)(int)((posY * winHeightFixed) - (winHeightFixed / 2) + 3);
+    float atlasWidth = (float)GlyphAtlasWidth[fontIndex];
+    float atlasHeight = (float)(GlyphAtlasRowHeight[fontIndex] * 2);
+    int quads = 0;
+
+    /* Every outline before any glyph, so no outline covers its neighbour's glyph */
+    for (int pass = 0; pass < 2; pass++)
     {
-        destinationRect.x = (int)((posX * winWidthFixed) - ( (text->w * winWidthFixed) / 2 ));
-        destinationRect.y = (int)((posY * winHeightFixed) - (winHeightFixed / 2) + 3);
-        destinationRect.w = (int)(text->w * (winWidthFixed));
-        destinationRect.h = (int)(text->h * (winHeightFixed));
+        SDL_Color color = { outlineRed, outlineGreen, outlineBlue, 255 };
+        int border = TextOutlineThickness;
+        int rowY = 1;
+        if (pass == 1)
+        {
+            color.r = textRed;
+            color.g = textGreen;
+            color.b = textBlue;
+            border = 0;
+            rowY = GlyphAtlasRowHeight[fontIndex] + 1 + TextOutlineThickness;
+        }
+
+        float penX = textLeft;
+        for (int index = 0; index < length; index++)
+        {
+            int glyphWidth = GlyphWidth[fontIndex][glyphs[index]];
+            int cellX = GlyphX[fontIndex][glyphs[index]] + 1 + (TextOutlineThickness - border);
+
+            float left = penX - (border * winWidthFixed);
+            float top = textTop - (border * winHeightFixed);
+            float right = left + ( (glyphWidth + (border*2)) * winWidthFixed );
+            float bottom = top + ( (GlyphHeight[fontIndex] + (border*2)) * winHeightFixed );
+
+            float u0 = ( (float)cellX / atlasWidth );
+            float v0 = ( (float)rowY / atlasHeight );
+            float u1 = ( (float)(cellX + glyphWidth + (border*2)) / atlasWidth );
+            float v1 = ( (float)(rowY + GlyphHeight[fontIndex] + (border*2)) / atlasHeight );
+
+            SDL_Vertex *vertex = &BatchVertices[quads * 4];
+
+            vertex[0].position.x = left;   vertex[0].position.y = top;     vertex[0].tex_coord.x = u0;  vertex[0].tex_coord.y = v0;
+            vertex[1].position.x = right;  vertex[1].position.y = top;     vertex[1].tex_coord.x = u1;  vertex[1].tex_coord.y = v0;
+            vertex[2].position.x = left;   vertex[2].position.y = bottom;  vertex[2].tex_coord.x = u0;  vertex[2].tex_coord.y = v1;
+            vertex[3].position.x = right;  vertex[3].position.y = bottom;  vertex[3].tex_coord.x = u1;  vertex[3].tex_coord.y = v1;
+            for (int corner = 0; corner < 4; corner++)  vertex[corner].color = color;
+
+            quads++;
+            penX += ( glyphWidth * winWidthFixed );
+        }
     }
+
+    if (SDL_RenderGeometry(Renderer, GlyphAtlas[fontIndex], BatchVertices, quads * 4, BatchIndices, quads * 6) != 0)
+        printf("Glyph text not drawn: %s\n", SDL_GetError());
+
+    return(true);
+#else
+    return(false);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+void Visuals::DrawTextOntoScreenBuffer(const char *textToDisplay, TTF_Font *font, float posX, float posY
+                                       , Uint8 XJustification, Uint8 textRed, Uint8 textGreen, Uint8 textBlue
+                                       , Uint8 outlineRed, Uint8 outlineGreen, Uint8 outlineBlue)
+{
+SDL_Color textColor = { textRed, textGreen, textBlue, 255 };
+SDL_Color outlineColor = { outlineRed, outlineGreen, outlineBlue, 255 };
+SDL_Rect destinationRect;
+int windowWidth;
+int windowHeight;
+Uint32 textCacheKey;
+int textCacheCheckIndex;
+
+    /* Scores, lines, levels and timers change nearly every frame, so strings of digits skip the cache */
+    if ( DrawGlyphTextOntoScreenBuffer(textToDisplay, font, posX, posY, XJustification, textRed, textGreen, textBlue
+                                       , outlineRed, outlineGreen, outlineBlue) == true )  return;
+
+    if (font != Font[5])  posY-=3;
+    else  posY+=2;
+
+    textCacheKey = TextCacheKey(textToDisplay, font, textColor, outlineColor);
+    textCacheCheckIndex = FindCachedText(textCacheKey, textToDisplay, font, textColor, outlineColor);
+
+    if (textCacheCheckIndex != -1)  TextCacheHits++;
     else
     {
-        destinationRect.x = (int)((posX * winWidthFixed) - ( (TextCachedWidth[textCacheCheckIndex] * winWidthFixed) / 2 ));
-        destinationRect.y = (int)((posY * winHeightFixed) - (winHeightFixed / 2) + 3);
-        destinationRect.w = (int)(TextCachedWidth[textCacheCheckIndex] * (winWidthFixed));
-        destinationRect.h = (int)(TextCachedHeight[textCacheCheckIndex] * (winHeightFixed));
+        TextCacheMisses++;
+
+        textCacheCheckIndex = EvictCachedText();
+
+        TextTexture[textCacheCheckIndex] = CreateOutlinedTextTexture(textToDisplay, font, textColor, outlineColor
+                                                                     , &TextCachedWidth[textCacheCheckIndex], &TextCachedHeight[textCacheCheckIndex]);
+        if (TextTexture[textCacheCheckIndex] == NULL)  return;
+
+        SDL_strlcpy(TextCachedText[textCacheCheckIndex], textToDisplay, sizeof TextCachedText[textCacheCheckIndex]);
+        TextCachedFont[textCacheCheckIndex] = font;
+        TextCacheRed[textCacheCheckIndex] = textRed;
+        TextCacheGreen[textCacheCheckIndex] = textGreen;
+        TextCacheBlue[textCacheCheckIndex] = textBlue;
+        TextCacheOutlineRed[textCacheCheckIndex] = outlineRed;
+        TextCacheOutlineGreen[textCacheCheckIndex] = outlineGreen;
+        TextCacheOutlineBlue[textCacheCheckIndex] = outlineBlue;
+
+        TextCachedKey[textCacheCheckIndex] = textCacheKey;
+        TextCacheNext[textCacheCheckIndex] = TextCacheBucket[textCacheKey & (TextCacheBuckets-1)];
+        TextCacheBucket[textCacheKey & (TextCacheBuckets-1)] = textCacheCheckIndex;
     }
 
-    destinationOutlineRect.x = destinationRect.x;
-    destinationOutlineRect.y = destinationRect.y;
-    destinationOutlineRect.w = destinationRect.w;
-    destinationOutlineRect.h = destinationRect.h;
+    TextCacheUses++;
+    TextCacheLastUsed[textCacheCheckIndex] = TextCacheUses;
 
-    for (Sint16 y = -3; y < 4; y+=1)
+    if (XJustification == JustifyLeft)
     {
-        for (Sint16 x = -3; x < 4; x+=1)
-        {
-            destinationOutlineRect.x = destinationRect.x + x;
-            destinationOutlineRect.y = destinationRect.y + y;
-
-            if (sentenceIsInCache == false)
-                SDL_RenderCopyEx(Renderer, textOutlineTexture, NULL, &destinationOutlineRect, 0, NULL, SDL_FLIP_NONE);
-            else
-            {
-                SDL_RenderCopyEx(Renderer, TextOutlineTexture[textCacheCheckIndex], NULL, &destinationOutlineRect, 0, NULL, SDL_FLIP_NONE);
-            }
-        }
+        posX = posX + (TextCachedWidth[textCacheCheckIndex] / 2);
+    }
+    else if (XJustification == JustifyCenter)
+    {
+        posX = (640 / 2);
+    }
+    else if (XJustification == JustifyRight)
+    {
+        posX = (640 - posX) - (TextCachedWidth[textCacheCheckIndex] / 2);
+    }
+    else if (XJustification == JustifyCenterOnPoint)
+    {
+        posX = posX;
     }
 
-    if (sentenceIsInCache == false)
-        SDL_RenderCopyEx(Renderer, textTexture, NULL, &destinationRect, 0, NULL, SDL_FLIP_NONE);
+    SDL_GetWindowSize(Window, &windowWidth, &windowHeight);
+
+    float winWidthFixed;
+    float winHeightFixed;
+    if (ForceAspectRatio == false)
+    {
+        winWidthFixed = (float)windowWidth / 640;
+        winHeightFixed = (float)windowHeight / 480;
+    }
     else
-        SDL_RenderCopyEx(Renderer, TextTexture[textCacheCheckIndex], NULL, &destinationRect, 0, NULL, SDL_FLIP_NONE);
+    {
+        winWidthFixed = 1;
+        winHeightFixed = 1;
+    }
 
-    SDL_DestroyTexture(textOutlineTexture);
-    SDL_DestroyTexture(textTexture);
-    SDL_FreeSurface(text);
-    SDL_FreeSurface(textOutline);
+    /* The texture has the outline around the text baked in, one draw covers both */
+    destinationRect.x = (int)((posX * winWidthFixed) - ( (TextCachedWidth[textCacheCheckIndex] * winWidthFixed) / 2 ) - (TextOutlineThickness * winWidthFixed));
+    destinationRect.y = (int)((posY * winHeightFixed) - (winHeightFixed / 2) + 3 - (TextOutlineThickness * winHeightFixed));
+    destinationRect.w = (int)((TextCachedWidth[textCacheCheckIndex] + (TextOutlineThickness*2)) * (winWidthFixed));
+    destinationRect.h = (int)((TextCachedHeight[textCacheCheckIndex] + (TextOutlineThickness*2)) * (winHeightFixed));
+
+    SDL_RenderCopyEx(Renderer, TextTexture[textCacheCheckIndex], NULL, &destinationRect, 0, NULL, SDL_FLIP_NONE);
 }
 
 //-------------------------------------------------------------------------------------------------
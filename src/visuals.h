@@ -76,12 +76,80 @@ public:
         int TextureWidthOriginal;
         int TextureHeightOriginal;
         int AnimationTimer;
+        int References;
+        Uint32 ReleasedTicks;
     } Sprites[NumberOfSprites];
 
+    /* Title logo, story, about and background images only load while a screen holds a reference to them */
+    #define DefaultTextureBudgetKB  8192
+    Uint32 TextureBudgetKB;
+    Uint32 OnDemandTextureKB;
+    Uint32 OnDemandTexturePeakKB;  /* Reported at exit, to check the budget against real play */
+
+    bool SpriteLoadsOnDemand(int index);
+    bool AcquireSprite(int index);
+    void PrefetchSprite(int index);
+    void ReleaseSprite(int index);
+    void UnloadSprite(int index);
+    void EvictSprites(void);
+
+    /* Every image file is decoded once at startup, sprites that share a file are cut from or copied off the cached surface */
+    /* A surface is freed as soon as the last sprite queued for its file has its texture */
+    #define NumberOfImagesCached    64
+    int ImagesCached;
+    char ImageCachedPath[NumberOfImagesCached][256];
+    SDL_Surface *ImageCachedSurface[NumberOfImagesCached];
+    int ImageCachedUses[NumberOfImagesCached];
+
+    SDL_Surface *LoadImage(const char *filePath);
+    SDL_Surface *LoadImageCopy(const char *filePath);
+    void ReleaseImage(const char *filePath);
+    void ClearImageCache(void);
+
+    /* Queued images are decoded on worker threads while the logo screens show, the render thread only makes textures */
+    #define MaxImageDecodeThreads   8
+    #define ImageQueued             0
+    #define ImageDecoding           1
+    #define ImageDecoded            2
+    #define ImageReleased           3
+    #define ImageDecodeAheadKB      4096    /* Workers wait while this much decoded image is still waiting to become textures */
+    #define ImageDecodeReserveKB    1200    /* Held for each image while it decodes, a full screen background */
+    SDL_Thread *ImageDecodeThread[MaxImageDecodeThreads];
+    int ImageDecodeThreads;
+    int ImageDecodeJobs;
+    SDL_atomic_t ImageDecodeNext;
+    SDL_atomic_t ImageDecodeState[NumberOfImagesCached];
+    SDL_atomic_t ImageDecodedKB;
+    SDL_atomic_t ImageDecodeStopping;
+
+    void QueueImage(const char *filePath);
+    bool ImageDecodedYet(const char *filePath);
+    static int ImageDecodeWorker(void *data);
+    void StartImageDecoding(void);
+    void StopImageDecoding(void);
+
+    #define SpriteStreamingBudgetMS 4
+    bool SpritesLoading;
+    int SpritesNextToLoad;
+    Uint64 LaunchTicks;
+    Uint64 LoadingTicks;
+    bool FirstFramePresented;
+
+    void GetSpriteFilePath(int index, char *filePath, size_t filePathSize);
+    bool LoadSprite(int index);
+
+    SDL_Texture *CreatePackedTexture(const char *name);
+    SDL_Texture *CreateSpriteTexture(int index, SDL_Surface *surface);
+    bool SpriteInPack(int index);
+    bool LoadSpriteFromPack(int index);
+
     bool LoadSpritesAndInitialize(void);
+    bool StreamSpritesIntoMemory(Uint32 budgetMS);
+    bool FinishLoadingSprites(void);
 
     bool LoadBoxSpriteSheetIntoMemory(void);
 
+    void GetInterfaceFilePath(int index, char *filePath, size_t filePathSize);
     bool LoadInterfaceIntoMemory(void);
 
     bool LoadStaffTextIntoMemory(const char *staffText, Uint8 textBlue);
@@ -89,6 +157,52 @@ public:
 
     void DrawSpriteOntoScreenBuffer(Uint16 index);
 
+    /* The 60 playfield boxes (sprites 200-259) also live in one atlas, so whole playfields go out in one draw call */
+    #define BoxAtlasFirstSprite     200
+    #define BoxAtlasLastSprite      259
+    #define BoxAtlasColumns         10
+    #define BoxAtlasCellWidth       15  /* 13x18 box plus a 1 pixel border copied from its edges, so filtering never bleeds */
+    #define BoxAtlasCellHeight      20
+    #define MaxBatchedSprites       1536
+    SDL_Texture *BoxAtlas;
+    int BatchedSprites;
+    SDL_Vertex BatchVertices[MaxBatchedSprites * 4];
+    int BatchIndices[MaxBatchedSprites * 6];
+
+    void BatchSpriteOntoScreenBuffer(Uint16 index);
+    void DrawSpriteBatch(void);
+
+    /* What a screen draws first and rarely changes, kept in a render target and redrawn only when its key or size changes */
+    SDL_Texture *StaticLayer;
+    Uint32 StaticLayerKey;
+    int StaticLayerWidth;
+    int StaticLayerHeight;
+    bool StaticLayerDrawing;
+    bool StaticLayerFailed;
+
+    bool BeginStaticLayer(Uint32 key);
+    void EndStaticLayer(void);
+    void DrawStaticLayer(void);
+    void InvalidateStaticLayer(void);
+
+    /* Each board's boxes kept in a render target, only cells that changed since the last frame are redrawn into it */
+    #define MaxBoards               4
+    #define BoardColumns            12
+    #define BoardRows               26
+    #define BoardCellWidth          13
+    #define BoardCellHeight         18
+    SDL_Texture *BoardTexture[MaxBoards];
+    Uint16 BoardCell[MaxBoards][BoardColumns][BoardRows];  /* Box sprite and transparency drawn there, 0 when empty */
+    Uint8 BoardDirtyX[MaxBoards][BoardColumns*BoardRows];
+    Uint8 BoardDirtyY[MaxBoards][BoardColumns*BoardRows];
+    int BoardDirtyCells[MaxBoards];
+    bool BoardTexturesFailed;
+
+    bool BeginBoard(int board);
+    void SetBoardCell(int board, int x, int y, int index, Uint8 transparency);
+    void DrawBoard(int board, float firstBoxScreenX, float firstBoxScreenY);
+    void InvalidateBoards(void);
+
     #define JustifyLeft             0
     #define JustifyCenter           1
     #define JustifyRight            2
@@ -98,23 +212,56 @@ public:
     TTF_Font *Font[NumberOfFonts];
     char VariableText[64];
 
-    int TextCacheCurrentIndex;
+    /* Keyed by text, font, fill and outline colour, chained from TextCacheBucket[], least recently drawn text is replaced */
     #define NumberOfTextsCached     250
-    SDL_Texture *TextTexture[NumberOfTextsCached];
-    SDL_Texture *TextOutlineTexture[NumberOfTextsCached];
+    #define TextCacheBuckets        512  /* Power of two */
+    SDL_Texture *TextTexture[NumberOfTextsCached];  /* Outline and text in one texture */
     char TextCachedText[NumberOfTextsCached][64];
-    float TextCachedScreenX[NumberOfTextsCached];
-    float TextCachedScreenY[NumberOfTextsCached];
+    TTF_Font *TextCachedFont[NumberOfTextsCached];
+    Uint32 TextCachedKey[NumberOfTextsCached];
+    int TextCacheNext[NumberOfTextsCached];
+    int TextCacheBucket[TextCacheBuckets];
+    Uint64 TextCacheLastUsed[NumberOfTextsCached];
+    Uint64 TextCacheUses;
     int TextCachedWidth[NumberOfTextsCached];
     int TextCachedHeight[NumberOfTextsCached];
     Uint8 TextCacheRed[NumberOfTextsCached];
     Uint8 TextCacheGreen[NumberOfTextsCached];
     Uint8 TextCacheBlue[NumberOfTextsCached];
+    Uint8 TextCacheOutlineRed[NumberOfTextsCached];
+    Uint8 TextCacheOutlineGreen[NumberOfTextsCached];
+    Uint8 TextCacheOutlineBlue[NumberOfTextsCached];
+    Uint32 TextCacheHits;
+    Uint32 TextCacheMisses;
+
+    #define TextOutlineThickness    3
+
+    /* Per font atlas of white digit glyphs and their outlines, tinted by vertex colour, so changing numbers never render text */
+    #define GlyphAtlasCharacters    "0123456789+-:.,"
+    #define GlyphAtlasGlyphs        15
+    SDL_Texture *GlyphAtlas[NumberOfFonts];
+    bool GlyphAtlasTried[NumberOfFonts];
+    int GlyphAtlasWidth[NumberOfFonts];
+    int GlyphAtlasRowHeight[NumberOfFonts];
+    int GlyphX[NumberOfFonts][GlyphAtlasGlyphs];
+    int GlyphWidth[NumberOfFonts][GlyphAtlasGlyphs];
+    int GlyphHeight[NumberOfFonts];
 
     bool LoadFontsIntoMemory(void);
     void UnloadFontsFromMemory(void);
 
     void ClearTextCache(void);
+    Uint32 TextCacheKey(const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor);
+    int FindCachedText(Uint32 key, const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor);
+    int EvictCachedText(void);
+    SDL_Texture *CreateOutlinedTextTexture(const char *textToDisplay, TTF_Font *font, SDL_Color textColor, SDL_Color outlineColor
+                                          , int *textWidth, int *textHeight);
+    bool BuildGlyphAtlas(int font);
+    void ClearGlyphAtlases(void);
+    bool DrawGlyphTextOntoScreenBuffer(const char *textToDisplay, TTF_Font *font, float posX, float posY
+                                      , Uint8 XJustification, Uint8 textRed, Uint8 textGreen, Uint8 textBlue
+                                      , Uint8 outlineRed, Uint8 outlineGreen, Uint8 outlineBlue);
+
     void DrawTextOntoScreenBuffer(const char *textToDisplay, TTF_Font *font, float posX, float posY
                                  , Uint8 XJustification, Uint8 textRed, Uint8 textGreen, Uint8 textBlue
                                  , Uint8 outlineRed, Uint8 outlineGreen, Uint8 outlineBlue);